@@ -80,6 +80,20 @@ document::document() NOEXCEPT:
 REGISTER_ATTRIBUTE(iresearch::frequency);
 DEFINE_ATTRIBUTE_TYPE(frequency);
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     max_frequency
+// -----------------------------------------------------------------------------
+
+REGISTER_ATTRIBUTE(iresearch::max_frequency);
+DEFINE_ATTRIBUTE_TYPE(max_frequency);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        doc_bitset
+// -----------------------------------------------------------------------------
+
+REGISTER_ATTRIBUTE(iresearch::doc_bitset);
+DEFINE_ATTRIBUTE_TYPE(doc_bitset);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                granularity_prefix
 // -----------------------------------------------------------------------------
@@ -87,6 +101,13 @@ DEFINE_ATTRIBUTE_TYPE(frequency);
 REGISTER_ATTRIBUTE(iresearch::granularity_prefix);
 DEFINE_ATTRIBUTE_TYPE(iresearch::granularity_prefix);
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       term_filter
+// -----------------------------------------------------------------------------
+
+REGISTER_ATTRIBUTE(iresearch::term_filter);
+DEFINE_ATTRIBUTE_TYPE(iresearch::term_filter);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                              norm
 // -----------------------------------------------------------------------------
@@ -30,6 +30,7 @@
 #include "index/iterators.hpp"
 
 #include "utils/attributes.hpp"
+#include "utils/bitset.hpp"
 #include "utils/string.hpp"
 #include "utils/type_limits.hpp"
 #include "utils/iterator.hpp"
@@ -116,6 +117,59 @@ struct IRESEARCH_API frequency : basic_attribute<uint64_t> {
   frequency() = default;
 }; // frequency
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class max_frequency
+/// @brief upper bounds of the term frequency within a posting list, allows
+///        scoring iterators to skip whole blocks of documents which can't get
+///        a competitive score
+//////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API max_frequency : basic_attribute<uint64_t> {
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief positions block boundary at the block containing 'target' without
+  ///        moving the iterator itself, sets 'max' to the upper bound of the
+  ///        term frequency within the block
+  /// @returns last document of the block
+  //////////////////////////////////////////////////////////////////////////////
+  typedef std::function<doc_id_t(doc_id_t target, uint64_t& max)> seek_f;
+
+  DECLARE_ATTRIBUTE_TYPE();
+
+  max_frequency() = default;
+
+  doc_id_t seek(doc_id_t target, uint64_t& max) const {
+    assert(seek_);
+    return seek_(target, max);
+  }
+
+  void clear() {
+    value = 0;
+  }
+
+  seek_f seek_; // upper bound for the block, 'value' bounds the whole list
+}; // max_frequency
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class doc_bitset
+/// @brief postings exposed as a bitset indexed by document id, lets consumers
+///        combine them word-wise instead of iterating document by document
+///        the words [begin, end) denote bits starting from
+///        'bitset::bit_offset(offset)', documents outside are not in the set
+//////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API doc_bitset : attribute {
+  DECLARE_ATTRIBUTE_TYPE();
+
+  doc_bitset() = default;
+
+  void clear() NOEXCEPT {
+    offset = 0;
+    begin = end = nullptr;
+  }
+
+  size_t offset{}; // index of the word pointed by 'begin'
+  const bitset::word_t* begin{};
+  const bitset::word_t* end{};
+}; // doc_bitset
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class granularity_prefix
 /// @brief indexed tokens are prefixed with one byte indicating granularity
@@ -128,6 +182,17 @@ struct IRESEARCH_API granularity_prefix : attribute {
   granularity_prefix() = default;
 }; // granularity_prefix
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class term_filter
+/// @brief this is marker attribute only used in field::features in order to
+///        request a per-field filter over indexed terms, allowing lookups of
+///        absent terms to be rejected without accessing the term dictionary
+//////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API term_filter : attribute {
+  DECLARE_ATTRIBUTE_TYPE();
+  term_filter() = default;
+}; // term_filter
+
 //////////////////////////////////////////////////////////////////////////////
 /// @class norm
 /// @brief this is marker attribute only used in field::features in order to
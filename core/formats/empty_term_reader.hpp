@@ -69,6 +69,10 @@ class empty_term_reader: public irs::term_reader {
     return irs::bytes_ref::nil;
   }
 
+  virtual bool may_contain(const irs::bytes_ref&) const NOEXCEPT override {
+    return false; // no terms in reader
+  }
+
  private:
   uint64_t docs_count_;
 };
@@ -44,7 +44,8 @@ void validate_footer(iresearch::index_input& in) {
   }
 
   const int32_t alg_id = in.read_int();
-  if (alg_id != 0) {
+  if (alg_id != format_utils::FOOTER_CRC32
+      && alg_id != format_utils::FOOTER_CRC32C) {
     // invalid algorithm
     throw iresearch::index_error();
   }
@@ -58,9 +59,25 @@ void write_header(index_output& out, const string_ref& format, int32_t ver) {
   out.write_int(ver);
 }
 
+footer_checksum::footer_checksum(index_input& in)
+  : type_(FOOTER_CRC32C) {
+  const auto length = in.length();
+
+  if (length < FOOTER_LEN) {
+    return; // no footer, checking it will fail anyway
+  }
+
+  const auto ptr = in.file_pointer();
+
+  in.seek(length - FOOTER_LEN + sizeof(int32_t)); // skip magic
+  type_ = in.read_int();
+  in.seek(ptr);
+}
+
 void write_footer(index_output& out) {
+  // outputs of all directories compute irs::crc32c
   out.write_int(FOOTER_MAGIC);
-  out.write_int(0);
+  out.write_int(FOOTER_CRC32C);
   out.write_long(out.checksum());
 }
 
@@ -89,6 +106,22 @@ int32_t check_header(
   return ver;
 }
 
+int64_t check_checksum(const index_input& in) {
+  auto clone = in.dup();
+
+  if (!clone) {
+    throw io_error();
+  }
+
+  const footer_checksum crc(*clone);
+
+  clone->seek(0);
+
+  checksum_index_input<footer_checksum> check_in(std::move(clone), crc);
+  check_in.seek(check_in.length() - FOOTER_LEN);
+  return check_footer(check_in);
+}
+
 int64_t read_checksum( index_input& in ) {
   in.seek( in.length() - FOOTER_LEN );
   validate_footer( in );
@@ -30,6 +30,24 @@
 
 #include "index/field_meta.hpp"
 
+#include "utils/crc.hpp"
+
+#if defined(_MSC_VER)
+  #pragma warning(disable : 4244)
+  #pragma warning(disable : 4245)
+#elif defined (__GNUC__)
+  // NOOP
+#endif
+
+#include <boost/crc.hpp>
+
+#if defined(_MSC_VER)
+  #pragma warning(default: 4244)
+  #pragma warning(default: 4245)
+#elif defined (__GNUC__)
+  // NOOP
+#endif
+
 NS_ROOT
 
 void IRESEARCH_API validate_footer(iresearch::index_input& in);
@@ -66,6 +84,55 @@ const int32_t FOOTER_MAGIC = -FORMAT_MAGIC;
 
 const uint32_t FOOTER_LEN = 2 * sizeof( int32_t ) + sizeof( int64_t );
 
+// checksum algorithms, the id is stored in the footer of every file
+const int32_t FOOTER_CRC32 = 0; // boost::crc_32_type, files written by older versions
+const int32_t FOOTER_CRC32C = 1; // irs::crc32c
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class footer_checksum
+/// @brief checksum of the algorithm referred to by the footer of a file
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API footer_checksum {
+ public:
+  typedef uint32_t value_type;
+
+  explicit footer_checksum(int32_t type = FOOTER_CRC32C) NOEXCEPT
+    : type_(type) {
+  }
+
+  // reads the algorithm id from the footer of the specified file,
+  // the file position is left unchanged
+  explicit footer_checksum(index_input& in);
+
+  void process_byte(byte_type b) {
+    process_bytes(&b, 1);
+  }
+
+  void process_bytes(const void* data, size_t size) {
+    if (FOOTER_CRC32 == type_) {
+      crc32_.process_bytes(data, size);
+    } else {
+      crc32c_.process_bytes(data, size);
+    }
+  }
+
+  value_type checksum() const {
+    return FOOTER_CRC32 == type_ ? crc32_.checksum() : crc32c_.checksum();
+  }
+
+  void reset() {
+    crc32_.reset();
+    crc32c_.reset();
+  }
+
+  int32_t type() const NOEXCEPT { return type_; }
+
+ private:
+  ::boost::crc_32_type crc32_;
+  crc32c crc32c_;
+  int32_t type_;
+}; // footer_checksum
+
 void IRESEARCH_API write_header(index_output& out, const string_ref& format, int32_t ver);
 
 void IRESEARCH_API write_footer(index_output& out);
@@ -91,16 +158,8 @@ int64_t check_footer( checksum_index_input< Checksum >& in ) {
   return req_checksum;
 }
 
-template< typename Checksum >
-int64_t check_checksum(const index_input& in) {
-  auto clone = in.dup();
-
-  clone->seek(0);
-
-  checksum_index_input<Checksum> check_in(std::move(clone));
-  check_in.seek(check_in.length() - FOOTER_LEN);
-  return check_footer(check_in);
-}
+// verifies checksum of the whole file against the one stored in its footer
+int64_t IRESEARCH_API check_checksum(const index_input& in);
 
 NS_END
 NS_END
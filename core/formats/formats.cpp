@@ -135,6 +135,7 @@ format::~format() {}
 /*static*/ void formats::init() {
   #ifndef IRESEARCH_DLL
     REGISTER_FORMAT(iresearch::version10::format);
+    REGISTER_FORMAT(iresearch::version10::format_pfor);
   #endif
 }
 
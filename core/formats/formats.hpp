@@ -28,6 +28,7 @@
 #include "store/data_output.hpp"
 #include "store/directory.hpp"
 
+#include "index/document_mask.hpp"
 #include "index/index_meta.hpp"
 #include "index/iterators.hpp"
 
@@ -48,7 +49,6 @@ struct reader_state;
 struct index_output;
 struct data_input;
 struct index_input;
-typedef std::unordered_set<doc_id_t> document_mask;
 
 /* -------------------------------------------------------------------
  * postings_writer
@@ -188,6 +188,31 @@ struct IRESEARCH_API basic_term_reader: public util::const_attribute_view_provid
   virtual const bytes_ref& (max)() const = 0;
 }; // basic_term_reader
 
+//////////////////////////////////////////////////////////////////////////////
+/// @struct points_visitor
+/// @brief receives documents from the points index of a field, i.e. from the
+///        block tree over the exact values of a 'granularity_prefix' field,
+///        values are compared as encoded terms
+//////////////////////////////////////////////////////////////////////////////
+struct IRESEARCH_API points_visitor {
+  enum class relation {
+    OUTSIDE, // no value of a cell matches
+    INSIDE, // every value of a cell matches
+    CROSSES // some values of a cell may match
+  };
+
+  virtual ~points_visitor() = default;
+
+  // returns relation of a cell holding values within [min, max]
+  virtual relation compare(const bytes_ref& min, const bytes_ref& max) = 0;
+
+  // document of a cell INSIDE the query
+  virtual void visit(doc_id_t doc) = 0;
+
+  // document of a cell CROSSING the query along with its value
+  virtual void visit(doc_id_t doc, const bytes_ref& value) = 0;
+}; // points_visitor
+
 struct IRESEARCH_API term_reader: public util::const_attribute_view_provider {
   DECLARE_PTR( term_reader);
   DECLARE_FACTORY(term_reader);
@@ -210,6 +235,14 @@ struct IRESEARCH_API term_reader: public util::const_attribute_view_provider {
 
   // most significant term
   virtual const bytes_ref& (max)() const = 0;
+
+  // returns false only if the specified term is definitely absent,
+  // allows point lookups to skip a field without touching the term index
+  virtual bool may_contain(const bytes_ref& /*term*/) const { return true; }
+
+  // passes documents of the field points index to 'visitor' in the order of
+  // their values, returns false if there is no points index for the field
+  virtual bool intersect(points_visitor& /*visitor*/) const { return false; }
 };
 
 /* -------------------------------------------------------------------
@@ -43,6 +43,7 @@
 #include "utils/bit_packing.hpp"
 #include "utils/type_limits.hpp"
 #include "utils/object_pool.hpp"
+#include "utils/thread_utils.hpp"
 #include "formats.hpp"
 
 #include <array>
@@ -79,6 +80,66 @@ NS_BEGIN(version10)
 template<typename T, typename M>
 std::string file_name(const M& meta);
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                                      block_codec
+// ----------------------------------------------------------------------------
+
+///////////////////////////////////////////////////////////////////////////////
+/// @struct block_codec
+/// @brief encoding of the full blocks of postings, defined by the version of
+///        the postings format
+///////////////////////////////////////////////////////////////////////////////
+struct block_codec {
+  static const block_codec& get(int32_t version) NOEXCEPT;
+
+  void read_block(data_input& in, uint32_t* encoded, uint32_t* decoded) const {
+    read32(in, postings_writer::BLOCK_SIZE, encoded, decoded);
+  }
+
+  void read_block(data_input& in, uint64_t* encoded, uint64_t* decoded) const {
+    read64(in, postings_writer::BLOCK_SIZE, encoded, decoded);
+  }
+
+  void write_block(data_output& out, const uint32_t* decoded, uint32_t* encoded) const {
+    write32(out, decoded, postings_writer::BLOCK_SIZE, encoded);
+  }
+
+  void write_block(data_output& out, const uint64_t* decoded, uint64_t* encoded) const {
+    write64(out, decoded, postings_writer::BLOCK_SIZE, encoded);
+  }
+
+  void skip_block32(index_input& in) const {
+    skip32(in, postings_writer::BLOCK_SIZE);
+  }
+
+  void skip_block64(index_input& in) const {
+    skip64(in, postings_writer::BLOCK_SIZE);
+  }
+
+  void (*read32)(data_input&, uint32_t, uint32_t*, uint32_t*);
+  void (*read64)(data_input&, uint32_t, uint64_t*, uint64_t*);
+  uint32_t (*write32)(data_output&, const uint32_t*, uint32_t, uint32_t*);
+  uint32_t (*write64)(data_output&, const uint64_t*, uint32_t, uint64_t*);
+  void (*skip32)(index_input&, uint32_t);
+  void (*skip64)(index_input&, uint64_t);
+}; // block_codec
+
+/*static*/ const block_codec& block_codec::get(int32_t version) NOEXCEPT {
+  static const block_codec BITPACK {
+    &encode::bitpack::read_block, &encode::bitpack::read_block,
+    &encode::bitpack::write_block, &encode::bitpack::write_block,
+    &encode::bitpack::skip_block32, &encode::bitpack::skip_block64
+  };
+
+  static const block_codec PFOR {
+    &encode::pfor::read_block, &encode::pfor::read_block,
+    &encode::pfor::write_block, &encode::pfor::write_block,
+    &encode::pfor::skip_block32, &encode::pfor::skip_block64
+  };
+
+  return version >= postings_writer::FORMAT_PFOR ? PFOR : BITPACK;
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                                 helper functions 
 // ----------------------------------------------------------------------------
@@ -108,7 +169,7 @@ inline void prepare_output(
   format_utils::write_header(*out, format, version);
 }
 
-inline void prepare_input(
+inline int32_t prepare_input(
     std::string& str,
     index_input::ptr& in,
     IOAdvice advice,
@@ -129,24 +190,33 @@ inline void prepare_input(
     throw detailed_io_error(ss.str());
   }
 
-  format_utils::check_header(*in, format, min_ver, max_ver);
+  return format_utils::check_header(*in, format, min_ver, max_ver);
 }
 
-FORCE_INLINE void skip_positions(index_input& in) {
-  encode::bitpack::skip_block32(in, postings_writer::BLOCK_SIZE);
+FORCE_INLINE void skip_positions(const block_codec& codec, index_input& in) {
+  codec.skip_block32(in);
 }
 
-FORCE_INLINE void skip_payload(index_input& in) {
+FORCE_INLINE void skip_payload(const block_codec& codec, index_input& in) {
   const size_t size = in.read_vint();
   if (size) {
-    encode::bitpack::skip_block32(in, postings_writer::BLOCK_SIZE);
+    codec.skip_block32(in);
     in.seek(in.file_pointer() + size);
   }
 }
 
-FORCE_INLINE void skip_offsets(index_input& in) {
-  encode::bitpack::skip_block32(in, postings_writer::BLOCK_SIZE);
-  encode::bitpack::skip_block32(in, postings_writer::BLOCK_SIZE);
+FORCE_INLINE void skip_offsets(const block_codec& codec, index_input& in) {
+  codec.skip_block32(in);
+  codec.skip_block32(in);
+}
+
+// whether postings of a term are stored within the term dictionary, that is
+// a rare term unless some of its positions are already flushed as a block,
+// a singleton without positions has nothing to store but its document
+FORCE_INLINE bool is_inlined(uint64_t docs_count, bool position, uint64_t freq) {
+  return docs_count <= postings_writer::INLINE_MAX_DOCS
+    && (docs_count > 1 || (docs_count && position))
+    && (!position || freq < postings_writer::BLOCK_SIZE);
 }
 
 NS_END // NS_LOCAL
@@ -156,6 +226,7 @@ struct skip_state {
   uint64_t pos_ptr{}; // pointer to the positions of the first document in a document block
   uint64_t pay_ptr{}; // pointer to the payloads of the first document in a document block
   size_t pend_pos{}; // positions to skip before new document block
+  uint64_t max_freq{}; // maximum term frequency in a block
   doc_id_t doc{ type_limits<type_t::doc_id_t>::invalid() }; // last document in a previous block 
   uint32_t pay_pos{}; // payload size to skip before in new document block 
 }; // skip_state
@@ -167,6 +238,7 @@ struct skip_context : skip_state {
 struct doc_state {
   const index_input* pos_in;
   const index_input* pay_in;
+  const block_codec* codec;
   version10::term_meta* term_state;
   uint64_t* freq;
   uint64_t* enc_buf;
@@ -196,9 +268,12 @@ class doc_iterator : public iresearch::doc_iterator {
       const irs::attribute_view& attrs,
       const index_input* doc_in,
       const index_input* pos_in,
-      const index_input* pay_in) {
+      const index_input* pay_in,
+      int32_t version) {
     features_ = field; // set field features
     enabled_ = enabled; // set enabled features
+    block_max_ = version >= postings_writer::FORMAT_BLOCK_MAX;
+    codec_ = &block_codec::get(version);
 
     // add mandatory attributes
     attrs_.emplace(doc_);
@@ -208,6 +283,33 @@ class doc_iterator : public iresearch::doc_iterator {
     assert(attrs.contains<version10::term_meta>());    
     term_state_ = *attrs.get<version10::term_meta>();
 
+    if (!term_state_.inlined.empty()) {
+      // postings are stored within the term dictionary,
+      // read them from there instead of the postings files
+      inline_in_.reset(term_state_.inlined);
+
+      // documents go first, skip them to find where positions start
+      if (term_state_.docs_count > 1) {
+        for (auto i = term_state_.docs_count; i; --i) {
+          if (features_.freq()) {
+            uint32_t delta;
+
+            if (!shift_unpack_32(inline_in_.read_vint(), delta)) {
+              inline_in_.read_vlong(); // frequency
+            }
+          } else {
+            inline_in_.read_vint();
+          }
+        }
+      }
+
+      term_state_.doc_start = 0;
+      term_state_.pos_start = inline_in_.file_pointer();
+      term_state_.pay_start = 0;
+      doc_in = pos_in = pay_in = &inline_in_;
+      doc_in_.reset(); // do not reuse the postings stream
+    }
+
     // init document stream
     if (term_state_.docs_count > 1) {
       if (!doc_in_) {
@@ -291,13 +393,23 @@ class doc_iterator : public iresearch::doc_iterator {
       assert(attrs.contains<frequency>());
       attrs_.emplace(freq_);
       term_freq_ = attrs.get<frequency>()->value;
+
+      // total term frequency is a valid (though rough) bound
+      // for the segments written without maximum frequency
+      max_freq_.value = term_state_.max_freq ? term_state_.max_freq : term_freq_;
+      max_freq_.seek_ = [this](doc_id_t target, uint64_t& max) {
+        return seek_block(target, max);
+      };
+      attrs_.emplace(max_freq_);
     }
   }
 
   virtual void seek_notify(const skip_context& /*ctx*/) {
   }
 
+  void skip_to(doc_id_t target);
   void seek_to_block(doc_id_t target);
+  doc_id_t seek_block(doc_id_t target, uint64_t& max);
 
   // returns current position in the document block 'docs_'
   size_t relative_pos() NOEXCEPT {
@@ -319,6 +431,9 @@ class doc_iterator : public iresearch::doc_iterator {
         state.pay_ptr += in.read_vlong();
       }
     }
+    if (block_max_ && features_.freq()) {
+      state.max_freq = in.read_vlong();
+    }
     return state.doc;
   }
 
@@ -343,23 +458,15 @@ class doc_iterator : public iresearch::doc_iterator {
 
     if (left >= postings_writer::BLOCK_SIZE) {
       // read doc deltas
-      encode::bitpack::read_block(*doc_in_, postings_writer::BLOCK_SIZE, enc_buf_, docs_);
+      codec_->read_block(*doc_in_, enc_buf_, docs_);
 
       if (features_.freq()) {
         // read frequency it is required by
         // the iterator or just skip it otherwise
         if (enabled_.freq()) {
-          encode::bitpack::read_block(
-            *doc_in_,
-            postings_writer::BLOCK_SIZE,
-            enc_buf_,
-            doc_freqs_
-          );
+          codec_->read_block(*doc_in_, enc_buf_, doc_freqs_);
         } else {
-          encode::bitpack::skip_block32(
-            *doc_in_,
-            postings_writer::BLOCK_SIZE
-          );
+          codec_->skip_block64(*doc_in_);
         }
       }
       end_ = docs_ + postings_writer::BLOCK_SIZE;
@@ -389,7 +496,8 @@ class doc_iterator : public iresearch::doc_iterator {
 
   std::vector<skip_state> skip_levels_;
   skip_reader skip_;
-  skip_context* skip_ctx_; // pointer to used skip context, will be used by skip reader
+  skip_context skip_ctx_; // where the block containing the last skip target starts
+  size_t skipped_{}; // number of documents preceding 'skip_ctx_'
   irs::attribute_view attrs_;
   uint64_t enc_buf_[postings_writer::BLOCK_SIZE]; // buffer for encoding
   doc_id_t docs_[postings_writer::BLOCK_SIZE]; // doc values
@@ -401,72 +509,215 @@ class doc_iterator : public iresearch::doc_iterator {
   uint64_t term_freq_{}; // total term frequency
   document doc_;
   frequency freq_;
+  max_frequency max_freq_;
   index_input::ptr doc_in_;
   version10::term_meta term_state_;
   features features_; // field features
   features enabled_; // enabled iterator features
+  const block_codec* codec_{}; // encoding of the full blocks
+  bytes_ref_input inline_in_; // postings stored within the term dictionary
+  bool block_max_{}; // skip data contains maximum term frequency
 }; // doc_iterator 
 
+void doc_iterator::skip_to(doc_id_t target) {
+  // init skip reader in lazy fashion
+  if (!skip_) {
+    index_input::ptr skip_in = doc_in_->dup();
+    skip_in->seek(term_state_.doc_start + term_state_.e_skip_start);
+
+    skip_.prepare(
+      std::move(skip_in),
+      [this](size_t level, index_input& in) {
+        skip_state& last = skip_ctx_;
+        auto& last_level = skip_ctx_.level;
+        auto& next = skip_levels_[level];
+
+        if (last_level > level) {
+          // move to the more granular level
+          next = last;
+        } else {
+          // store previous step on the same level
+          last = next;
+        }
+
+        last_level = level;
+
+        if (in.eof()) {
+          // stream exhausted
+          return (next.doc = type_limits<type_t::doc_id_t>::eof());
+        }
+
+        return read_skip(next, in);
+    });
+
+    // initialize skip levels
+    const auto num_levels = skip_.num_levels();
+    if (num_levels) {
+      skip_levels_.resize(num_levels);
+
+      // since we store pointer deltas, add postings offset
+      auto& top = skip_levels_.back();
+      top.doc_ptr = term_state_.doc_start;
+      top.pos_ptr = term_state_.pos_start;
+      top.pay_ptr = term_state_.pay_start;
+    }
+  }
+
+  skip_ctx_.level = 0;
+  skipped_ = skip_.seek(target);
+}
+
 void doc_iterator::seek_to_block(doc_id_t target) {
   // check whether it make sense to use skip-list
   if (skip_levels_.front().doc < target && term_state_.docs_count > postings_writer::BLOCK_SIZE) {
-    skip_context last; // where block starts
-    skip_ctx_ = &last;
-
-    // init skip writer in lazy fashion
-    if (!skip_) {
-      index_input::ptr skip_in = doc_in_->dup();
-      skip_in->seek(term_state_.doc_start + term_state_.e_skip_start);
-
-      skip_.prepare(
-        std::move(skip_in),
-        [this](size_t level, index_input& in) {
-          skip_state& last = *skip_ctx_;
-          auto& last_level = skip_ctx_->level;
-          auto& next = skip_levels_[level];
-
-          if (last_level > level) {
-            // move to the more granular level
-            next = last;
-          } else {
-            // store previous step on the same level
-            last = next;
-          }
+    skip_to(target); // may reallocate 'skip_levels_'
 
-          last_level = level;
+    const auto& next = skip_levels_.front();
 
-          if (in.eof()) {
-            // stream exhausted
-            return (next.doc = type_limits<type_t::doc_id_t>::eof());
-          }
+    if (skipped_ && !type_limits<type_t::doc_id_t>::eof(next.doc)
+        && next.doc_ptr > skip_ctx_.doc_ptr) {
+      // the target block is read right away, let the following one be
+      // fetched in background assuming it's about the same size
+      doc_in_->prefetch(next.doc_ptr, next.doc_ptr - skip_ctx_.doc_ptr);
+    }
+  }
 
-          return read_skip(next, in);
-      });
+  // skip-list might be already positioned by 'seek_block'
+  if (skipped_ > (cur_pos_ + relative_pos()) && skip_ctx_.doc < target) {
+    doc_in_->seek(skip_ctx_.doc_ptr);
+    doc_.value = skip_ctx_.doc;
+    cur_pos_ = skipped_;
+    begin_ = end_ = docs_; // will trigger refill in "next"
+    seek_notify(skip_ctx_); // notifies derivatives
+  }
+}
+
+doc_id_t doc_iterator::seek_block(doc_id_t target, uint64_t& max) {
+  if (block_max_ && term_state_.docs_count > postings_writer::BLOCK_SIZE) {
+    if (target <= skip_ctx_.doc) {
+      // skip-list can't move backwards
+      max = max_freq_.value;
+      return target;
+    }
+
+    if (skip_levels_.front().doc < target) {
+      skip_to(target); // may reallocate 'skip_levels_'
 
-      // initialize skip levels
-      const auto num_levels = skip_.num_levels();
-      if (num_levels) {
-        skip_levels_.resize(num_levels);
+      const auto& block = skip_levels_.front();
 
-        // since we store pointer deltas, add postings offset
-        auto& top = skip_levels_.back();
-        top.doc_ptr = term_state_.doc_start;
-        top.pos_ptr = term_state_.pos_start;
-        top.pay_ptr = term_state_.pay_start;
+      if (!type_limits<type_t::doc_id_t>::eof(block.doc)) {
+        // the block is likely to be read soon, let it be fetched in background
+        const auto begin = skipped_ ? skip_ctx_.doc_ptr : term_state_.doc_start;
+
+        if (block.doc_ptr > begin) {
+          doc_in_->prefetch(begin, block.doc_ptr - begin);
+        }
       }
     }
 
-    const size_t skipped = skip_.seek(target);
-    if (skipped > (cur_pos_ + relative_pos())) {
-      doc_in_->seek(last.doc_ptr);
-      doc_.value = last.doc;
-      cur_pos_ = skipped;
-      begin_ = end_ = docs_; // will trigger refill in "next"
-      seek_notify(last); // notifies derivatives
+    const auto& block = skip_levels_.front();
+
+    if (!type_limits<type_t::doc_id_t>::eof(block.doc)) {
+      max = block.max_freq;
+      return block.doc;
     }
   }
+
+  // the last block isn't covered by skip-list
+  max = max_freq_.value;
+  return type_limits<type_t::doc_id_t>::eof();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// @class dense_doc_iterator
+/// @brief iterator over postings stored as a bitset, exposes the words via
+///        'doc_bitset' so that they could be combined without iteration
+///////////////////////////////////////////////////////////////////////////////
+class dense_doc_iterator final : public iresearch::doc_iterator {
+ public:
+  dense_doc_iterator(
+      const version10::term_meta& state,
+      const index_input& doc_in) {
+    auto in = doc_in.reopen();
+
+    if (!in) {
+      IR_FRMT_FATAL("Failed to reopen document input in: %s", __FUNCTION__);
+
+      throw detailed_io_error("Failed to reopen document input");
+    }
+
+    in->seek(state.doc_start);
+    bits_.offset = in->read_vlong();
+
+    const size_t size = in->read_vlong();
+    words_ = memory::make_unique<bitset::word_t[]>(size);
+
+    for (size_t i = 0; i < size; ++i) {
+      words_[i] = in->read_long();
+    }
+
+    bits_.begin = words_.get();
+    bits_.end = words_.get() + size;
+
+    attrs_.emplace(doc_);
+    attrs_.emplace(bits_);
+  }
+
+  virtual doc_id_t value() const override {
+    return doc_.value;
+  }
+
+  virtual const irs::attribute_view& attributes() const NOEXCEPT override {
+    return attrs_;
+  }
+
+  virtual bool next() override {
+    if (type_limits<type_t::doc_id_t>::eof(doc_.value)) {
+      return false;
+    }
+
+    return !type_limits<type_t::doc_id_t>::eof(seek(doc_.value + 1));
+  }
+
+  virtual doc_id_t seek(doc_id_t target) override {
+    if (target <= doc_.value) {
+      return doc_.value;
+    }
+
+    const auto* pword = bits_.begin;
+    bitset::word_t word = 0;
+
+    if (bitset::word(target) < bits_.offset) {
+      word = *pword; // target precedes the first document
+    } else {
+      pword += bitset::word(target) - bits_.offset;
+
+      if (pword >= bits_.end) {
+        return (doc_.value = type_limits<type_t::doc_id_t>::eof());
+      }
+
+      word = (*pword) & (~bitset::word_t(0) << bitset::bit(target));
+    }
+
+    while (!word && ++pword < bits_.end) {
+      word = *pword;
+    }
+
+    doc_.value = word
+      ? bitset::bit_offset(bits_.offset + std::distance(bits_.begin, pword))
+          + math::math_traits<bitset::word_t>::ctz(word)
+      : type_limits<type_t::doc_id_t>::eof();
+
+    return doc_.value;
+  }
+
+ private:
+  irs::attribute_view attrs_;
+  std::unique_ptr<bitset::word_t[]> words_;
+  doc_bitset bits_;
+  document doc_;
+}; // dense_doc_iterator
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @class mask_doc_iterator
 ///////////////////////////////////////////////////////////////////////////////
@@ -485,28 +736,24 @@ class mask_doc_iterator final: public DocIterator {
   }
 
   virtual bool next() override {
-    while (doc_iterator_t::next()) {
-      if (mask_.find(this->value()) == mask_.end()) {
-        return true;
-      }
-    }
-
-    return false;
+    return doc_iterator_t::next()
+      && !type_limits<type_t::doc_id_t>::eof(skip(this->value()));
   }
 
   virtual doc_id_t seek(doc_id_t target) override {
-    const auto doc = doc_iterator_t::seek(target);
+    return skip(doc_iterator_t::seek(target));
+  }
 
-    if (mask_.find(doc) == mask_.end()) {
-      return doc;
+ private:
+  // skip a whole run of excluded documents at once
+  doc_id_t skip(doc_id_t doc) {
+    while (mask_.contains(doc)) {
+      doc = doc_iterator_t::seek(mask_.skip(doc));
     }
 
-    this->next();
-
-    return this->value();
+    return doc;
   }
 
- private:
   const document_mask& mask_; /* excluded document ids */
 }; // mask_doc_iterator
 
@@ -572,6 +819,7 @@ class pos_iterator : public position::impl {
     freq_ = state.freq;
     features_ = state.features; 
     enc_buf_ = reinterpret_cast<uint32_t*>(state.enc_buf);
+    codec_ = state.codec;
     tail_start_ = state.tail_start;
     tail_length_ = state.tail_length;  
   }
@@ -608,7 +856,7 @@ class pos_iterator : public position::impl {
         }
       }
     } else {
-      encode::bitpack::read_block(*pos_in_, postings_writer::BLOCK_SIZE, enc_buf_, pos_deltas_);
+      codec_->read_block(*pos_in_, enc_buf_, pos_deltas_);
     }
   }
 
@@ -618,7 +866,7 @@ class pos_iterator : public position::impl {
       count -= left;
       while (count >= postings_writer::BLOCK_SIZE) {
         // skip positions
-        skip_positions(*pos_in_);
+        skip_positions(*codec_, *pos_in_);
         count -= postings_writer::BLOCK_SIZE;
       }
       refill();
@@ -636,6 +884,7 @@ class pos_iterator : public position::impl {
   uint32_t pos_deltas_[postings_writer::BLOCK_SIZE]; /* buffer to store position deltas */
   const uint64_t* freq_; /* lenght of the posting list for a document */
   uint32_t* enc_buf_; /* auxillary buffer to decode data */
+  const block_codec* codec_{}; /* encoding of the full blocks */
   uint64_t pend_pos_{}; /* how many positions "behind" we are */
   uint64_t tail_start_; /* file pointer where the last (vInt encoded) pos delta block is */
   size_t tail_length_; /* number of positions in the last (vInt encoded) pos delta block */
@@ -705,9 +954,9 @@ class offs_pay_iterator final : public pos_iterator {
       count -= left;
       // skip block by block
       while (count >= postings_writer::BLOCK_SIZE) {
-        skip_positions(*pos_in_);
-        skip_payload(*pay_in_);
-        skip_offsets(*pay_in_);
+        skip_positions(*codec_, *pos_in_);
+        skip_payload(*codec_, *pay_in_);
+        skip_offsets(*codec_, *pay_in_);
         count -= postings_writer::BLOCK_SIZE;
       }
       refill();
@@ -762,12 +1011,12 @@ class offs_pay_iterator final : public pos_iterator {
         }
       }
     } else {
-      encode::bitpack::read_block(*pos_in_, postings_writer::BLOCK_SIZE, enc_buf_, pos_deltas_);
+      codec_->read_block(*pos_in_, enc_buf_, pos_deltas_);
 
       // read payloads
       const uint32_t size = pay_in_->read_vint();
       if (size) {
-        encode::bitpack::read_block(*pay_in_, postings_writer::BLOCK_SIZE, enc_buf_, pay_lengths_);
+        codec_->read_block(*pay_in_, enc_buf_, pay_lengths_);
         oversize(pay_data_, size);
 
         #ifdef IRESEARCH_DEBUG
@@ -779,8 +1028,8 @@ class offs_pay_iterator final : public pos_iterator {
       }
 
       // read offsets
-      encode::bitpack::read_block(*pay_in_, postings_writer::BLOCK_SIZE, enc_buf_, offs_start_deltas_);
-      encode::bitpack::read_block(*pay_in_, postings_writer::BLOCK_SIZE, enc_buf_, offs_lengts_);
+      codec_->read_block(*pay_in_, enc_buf_, offs_start_deltas_);
+      codec_->read_block(*pay_in_, enc_buf_, offs_lengts_);
     }
     pay_data_pos_ = 0;
   }
@@ -861,16 +1110,16 @@ class offs_iterator final : public pos_iterator {
         }
       }
     } else {
-      encode::bitpack::read_block(*pos_in_, postings_writer::BLOCK_SIZE, enc_buf_, pos_deltas_);
+      codec_->read_block(*pos_in_, enc_buf_, pos_deltas_);
 
       // skip payload
       if (features_.payload()) {
-        skip_payload(*pay_in_);
+        skip_payload(*codec_, *pay_in_);
       }
 
       // read offsets
-      encode::bitpack::read_block(*pay_in_, postings_writer::BLOCK_SIZE, enc_buf_, offs_start_deltas_);
-      encode::bitpack::read_block(*pay_in_, postings_writer::BLOCK_SIZE, enc_buf_, offs_lengts_);
+      codec_->read_block(*pay_in_, enc_buf_, offs_start_deltas_);
+      codec_->read_block(*pay_in_, enc_buf_, offs_lengts_);
     }
   }
 
@@ -880,11 +1129,11 @@ class offs_iterator final : public pos_iterator {
       count -= left;
       // skip block by block
       while (count >= postings_writer::BLOCK_SIZE) {
-        skip_positions(*pos_in_);
+        skip_positions(*codec_, *pos_in_);
         if (features_.payload()) {
-          skip_payload(*pay_in_);
+          skip_payload(*codec_, *pay_in_);
         }
-        skip_offsets(*pay_in_);
+        skip_offsets(*codec_, *pay_in_);
         count -= postings_writer::BLOCK_SIZE;
       }
       refill();
@@ -956,10 +1205,10 @@ class pay_iterator final : public pos_iterator {
       count -= left;
       // skip block by block
       while (count >= postings_writer::BLOCK_SIZE) {
-        skip_positions(*pos_in_);
-        skip_payload(*pay_in_);
+        skip_positions(*codec_, *pos_in_);
+        skip_payload(*codec_, *pay_in_);
         if (features_.offset()) {
-          skip_offsets(*pay_in_);
+          skip_offsets(*codec_, *pay_in_);
         }
         count -= postings_writer::BLOCK_SIZE;
       }
@@ -1016,12 +1265,12 @@ class pay_iterator final : public pos_iterator {
         }
       }
     } else {
-      encode::bitpack::read_block(*pos_in_, postings_writer::BLOCK_SIZE, enc_buf_, pos_deltas_);
+      codec_->read_block(*pos_in_, enc_buf_, pos_deltas_);
 
       /* read payloads */
       const uint32_t size = pay_in_->read_vint();
       if (size) {
-        encode::bitpack::read_block(*pay_in_, postings_writer::BLOCK_SIZE, enc_buf_, pay_lengths_);
+        codec_->read_block(*pay_in_, enc_buf_, pay_lengths_);
         oversize(pay_data_, size);
 
         #ifdef IRESEARCH_DEBUG
@@ -1034,7 +1283,7 @@ class pay_iterator final : public pos_iterator {
 
       // skip offsets
       if (features_.offset()) {
-        skip_offsets(*pay_in_);
+        skip_offsets(*codec_, *pay_in_);
       }
     }
     pay_data_pos_ = 0;
@@ -1134,6 +1383,7 @@ void pos_doc_iterator::prepare_attributes(
   state.pos_in = pos_in;
   state.pay_in = pay_in;
   state.term_state = &term_state_;
+  state.codec = codec_;
   state.freq = &freq_.value;
   state.features = features_;
   state.enc_buf = enc_buf_;
@@ -1319,7 +1569,8 @@ void index_meta_reader::read(
     throw detailed_io_error(ss.str());
   }
 
-  checksum_index_input<boost::crc_32_type> check_in(std::move(in));
+  const format_utils::footer_checksum crc(*in);
+  checksum_index_input<format_utils::footer_checksum> check_in(std::move(in), crc);
 
   // check header
   format_utils::check_header(
@@ -1371,6 +1622,10 @@ void segment_meta_writer::write(directory& dir, const segment_meta& meta) {
   auto out = dir.create(meta_file);
   byte_type flags = meta.column_store ? segment_meta_writer::flags_t::HAS_COLUMN_STORE : 0;
 
+  if (!meta.sort.empty()) {
+    flags |= segment_meta_writer::flags_t::HAS_SORT;
+  }
+
   if (!out) {
     std::stringstream ss;
 
@@ -1384,6 +1639,11 @@ void segment_meta_writer::write(directory& dir, const segment_meta& meta) {
   out->write_vlong(meta.version);
   out->write_vlong( meta.docs_count);
   out->write_byte(flags);
+
+  if (flags & segment_meta_writer::flags_t::HAS_SORT) {
+    write_string(*out, meta.sort);
+  }
+
   write_strings( *out, meta.files );
   format_utils::write_footer(*out);
 }
@@ -1413,9 +1673,10 @@ void segment_meta_reader::read(
     throw detailed_io_error(ss.str());
   }
 
-  checksum_index_input<boost::crc_32_type> check_in(std::move(in));
+  const format_utils::footer_checksum crc(*in);
+  checksum_index_input<format_utils::footer_checksum> check_in(std::move(in), crc);
 
-  format_utils::check_header(
+  const auto format_version = format_utils::check_header(
     check_in,
     segment_meta_writer::FORMAT_NAME,
     segment_meta_writer::FORMAT_MIN,
@@ -1432,14 +1693,25 @@ void segment_meta_reader::read(
     throw index_error();
   }
 
-  if (flags & ~(segment_meta_writer::flags_t::HAS_COLUMN_STORE)) {
+  const byte_type supported_flags = format_version >= segment_meta_writer::FORMAT_SORT
+    ? segment_meta_writer::flags_t::HAS_COLUMN_STORE | segment_meta_writer::flags_t::HAS_SORT
+    : segment_meta_writer::flags_t::HAS_COLUMN_STORE;
+
+  if (flags & ~supported_flags) {
     // corrupted index
     throw index_error(); // use of unsupported flags
   }
 
+  std::string sort;
+
+  if (flags & segment_meta_writer::flags_t::HAS_SORT) {
+    sort = read_string<std::string>(check_in);
+  }
+
   meta.name = std::move(name);
   meta.version = version;
   meta.column_store = flags & segment_meta_writer::flags_t::HAS_COLUMN_STORE;
+  meta.sort = std::move(sort);
   meta.docs_count = count;
   meta.files = read_strings<segment_meta::file_set>(check_in);
 
@@ -1481,13 +1753,30 @@ void document_mask_writer::prepare(directory& dir, const segment_meta& meta) {
 void document_mask_writer::begin(uint32_t count) {
   format_utils::write_header(*out_, FORMAT_NAME, FORMAT_MAX);
   out_->write_vint(count);
+  docs_mask_.clear();
 }
 
 void document_mask_writer::write(const doc_id_t& mask) {
-  out_->write_vlong(mask);
+  docs_mask_.insert(mask);
 }
 
 void document_mask_writer::end() {
+  // only non-empty words of the bitmap are stored along with their positions
+  const bitset& set = docs_mask_;
+  const auto words = std::count_if(
+    set.begin(), set.end(), [](bitset::word_t word) { return 0 != word; }
+  );
+
+  out_->write_vlong(words);
+
+  for (auto begin = set.begin(), it = begin, end = set.end(); it != end; ++it) {
+    if (*it) {
+      out_->write_vlong(std::distance(begin, it));
+      out_->write_long(*it);
+      begin = it + 1;
+    }
+  }
+
   format_utils::write_footer(*out_);
 }
 
@@ -1507,7 +1796,7 @@ bool document_mask_reader::prepare(
 
   // possible that the file does not exist since document_mask is optional
   if (dir.exists(exists, in_name) && !exists) {
-    checksum_index_input<boost::crc_32_type> empty_in;
+    checksum_index_input<format_utils::footer_checksum> empty_in;
 
     in_.swap(empty_in);
 
@@ -1527,7 +1816,7 @@ bool document_mask_reader::prepare(
   );
 
   if (!in) {
-    checksum_index_input<boost::crc_32_type> empty_in;
+    checksum_index_input<format_utils::footer_checksum> empty_in;
 
     IR_FRMT_ERROR("Failed to open file, path: %s", in_name.c_str());
     in_.swap(empty_in);
@@ -1535,7 +1824,8 @@ bool document_mask_reader::prepare(
     return false;
   }
 
-  checksum_index_input<boost::crc_32_type> check_in(std::move(in));
+  const format_utils::footer_checksum crc(*in);
+  checksum_index_input<format_utils::footer_checksum> check_in(std::move(in), crc);
 
   in_.swap(check_in);
 
@@ -1547,17 +1837,43 @@ bool document_mask_reader::prepare(
 }
 
 uint32_t document_mask_reader::begin() {
-  format_utils::check_header(
+  version_ = format_utils::check_header(
     in_,
     document_mask_writer::FORMAT_NAME,
     document_mask_writer::FORMAT_MIN,
     document_mask_writer::FORMAT_MAX
   );
 
-  return in_.read_vint();
+  const auto count = in_.read_vint();
+
+  if (version_ >= document_mask_writer::FORMAT_BITMAP) {
+    docs_mask_.clear();
+
+    for (auto words = in_.read_vlong(), offset = decltype(words)(0); words; --words) {
+      offset += in_.read_vlong();
+
+      auto word = bitset::word_t(in_.read_long());
+      const auto base = bitset::bit_offset(offset++);
+
+      for (; word; word &= word - 1) {
+        docs_mask_.insert(base + math::math_traits<bitset::word_t>::ctz(word));
+      }
+    }
+
+    next_ = docs_mask_.begin();
+  }
+
+  return count;
 }
 
 void document_mask_reader::read(doc_id_t& doc_id) {
+  if (version_ >= document_mask_writer::FORMAT_BITMAP) {
+    assert(next_ != docs_mask_.end());
+    doc_id = *next_;
+    ++next_;
+    return;
+  }
+
   auto id = in_.read_vlong();
 
   static_assert(sizeof(doc_id_t) == sizeof(decltype(id)), "sizeof(doc_id) != sizeof(decltype(id))");
@@ -1645,7 +1961,7 @@ class meta_reader final : public iresearch::column_meta_reader {
   virtual bool read(column_meta& column) override;
 
  private:
-  checksum_index_input<boost::crc_32_type> in_;
+  checksum_index_input<format_utils::footer_checksum> in_;
   field_id count_{0};
 }; // meta_writer
 
@@ -1670,7 +1986,8 @@ bool meta_reader::prepare(
   count = in->read_int();
   in->seek(0);
 
-  checksum_index_input<boost::crc_32_type> check_in(std::move(in));
+  const format_utils::footer_checksum crc(*in);
+  checksum_index_input<format_utils::footer_checksum> check_in(std::move(in), crc);
 
   format_utils::check_header(
     check_in, 
@@ -1900,7 +2217,8 @@ class index_block {
 class writer final : public iresearch::columnstore_writer {
  public:
   static const int32_t FORMAT_MIN = 0;
-  static const int32_t FORMAT_MAX = FORMAT_MIN;
+  static const int32_t FORMAT_COLUMN_OFFSETS = FORMAT_MIN + 1; // per-column index offsets
+  static const int32_t FORMAT_MAX = FORMAT_COLUMN_OFFSETS;
 
   static const string_ref FORMAT_NAME;
   static const string_ref FORMAT_EXT;
@@ -2128,10 +2446,20 @@ bool writer::flush() {
 
   data_out_->write_vlong(columns_.size()); // number of columns
 
+  std::vector<uint64_t> column_index_ptrs;
+  column_index_ptrs.reserve(columns_.size());
+
   for (auto& column : columns_) {
+    column_index_ptrs.push_back(data_out_->file_pointer());
     column.finish(); // column blocks index
   }
 
+  // fixed size offsets of column blocks indexes,
+  // allow reader to load columns individually
+  for (const auto column_index_ptr : column_index_ptrs) {
+    data_out_->write_long(column_index_ptr);
+  }
+
   data_out_->write_long(block_index_ptr);
   format_utils::write_footer(*data_out_);
   data_out_.reset();
@@ -2875,6 +3203,10 @@ class context_provider : private util::noncopyable {
     return pool_.emplace(*stream_);
   }
 
+  void prefetch(uint64_t offset, size_t length) const NOEXCEPT {
+    stream_->prefetch(offset, length);
+  }
+
  private:
   mutable bounded_object_pool<read_context_t> pool_;
   index_input::ptr stream_;
@@ -3061,6 +3393,12 @@ class column_iterator final : public irs::columnstore_iterator {
 
     seek_origin_ = begin_++;
 
+    if (begin_ != end_ && !begin_->pblock.load()) {
+      // let the next block be fetched while the current one is consumed,
+      // average size of the uncompressed block is a reasonable upper bound
+      column_->ctxs_->prefetch(begin_->offset, column_->avg_block_size());
+    }
+
     return true;
   }
 
@@ -3659,9 +3997,59 @@ class IRESEARCH_PLUGIN reader final : public columnstore_reader, public context_
   }
 
  private:
-  std::vector<column::ptr> columns_;
+  columns::column::ptr read_column(data_input& in, uint64_t* buf) const;
+  const columns::column* load_column(field_id field) const;
+
+  mutable std::vector<std::atomic<const columns::column*>> columns_; // nullptr - not loaded yet
+  mutable std::vector<columns::column::ptr> loaded_columns_; // owns loaded columns
+  mutable std::mutex mutex_; // guards 'index_in_' and 'loaded_columns_'
+  index_input::ptr index_in_; // source of lazily loaded columns
+  uint64_t column_index_ptrs_{}; // offset of column blocks indexes offsets
 }; // reader
 
+column::ptr reader::read_column(data_input& in, uint64_t* buf) const {
+  // read column properties
+  const auto props = read_enum<ColumnProperty>(in);
+  // create column
+  const auto& factory = g_column_factories[props];
+  assert(factory);
+  auto column = factory(*this, props);
+  // read column
+  if (!column || !column->read(in, buf)) {
+    return nullptr;
+  }
+
+  return column;
+}
+
+const columns::column* reader::load_column(field_id field) const {
+  SCOPED_LOCK(mutex_);
+  auto& slot = columns_[field];
+  const auto* loaded = slot.load(std::memory_order_relaxed);
+
+  if (loaded) {
+    return loaded; // loaded by a concurrent call
+  }
+
+  assert(index_in_);
+  index_in_->seek(column_index_ptrs_ + field*sizeof(uint64_t));
+  index_in_->seek(index_in_->read_long());
+
+  uint64_t buf[INDEX_BLOCK_SIZE]; // temporary buffer for bit packing
+  auto column = read_column(*index_in_, buf);
+
+  if (!column) {
+    IR_FRMT_ERROR("Unable to load blocks index for column id=" IR_SIZE_T_SPECIFIER, size_t(field));
+    return nullptr;
+  }
+
+  loaded = column.get();
+  loaded_columns_.emplace_back(std::move(column));
+  slot.store(loaded, std::memory_order_release);
+
+  return loaded;
+}
+
 bool reader::prepare(
     const directory& dir,
     const segment_meta& meta,
@@ -3693,7 +4081,7 @@ bool reader::prepare(
   }
 
   // check header
-  format_utils::check_header(
+  const auto version = format_utils::check_header(
     *stream,
     writer::FORMAT_NAME,
     writer::FORMAT_MIN,
@@ -3711,28 +4099,48 @@ bool reader::prepare(
   stream->seek(stream->length() - format_utils::FOOTER_LEN - sizeof(uint64_t));
   stream->seek(stream->read_long()); // seek to blocks index
 
-  uint64_t buf[INDEX_BLOCK_SIZE]; // temporary buffer for bit packing
-  std::vector<column::ptr> columns;
-  columns.reserve(stream->read_vlong());
-  for (size_t i = 0, size = columns.capacity(); i < size; ++i) {
-    // read column properties
-    const auto props = read_enum<ColumnProperty>(*stream);
-    // create column
-    const auto& factory = g_column_factories[props];
-    assert(factory);
-    auto column = factory(*this, props);
-    // read column
-    if (!column || !column->read(*stream, buf)) {
-      IR_FRMT_ERROR("Unable to load blocks index for column id=" IR_SIZE_T_SPECIFIER, i);
-      return false;
+  const size_t count = stream->read_vlong();
+  std::vector<std::atomic<const columns::column*>> refs(count);
+  std::vector<columns::column::ptr> loaded_columns;
+  index_input::ptr index_in;
+  uint64_t column_index_ptrs = 0;
+
+  if (version >= writer::FORMAT_COLUMN_OFFSETS) {
+    // columns are loaded on first access
+    if (count) {
+      index_in = stream->reopen();
+
+      if (!index_in) {
+        IR_FRMT_ERROR("Failed to reopen file, path: %s", filename.c_str());
+        return false;
+      }
     }
 
-    columns.emplace_back(std::move(column));
+    column_index_ptrs = stream->length() - format_utils::FOOTER_LEN
+                      - sizeof(uint64_t) - count*sizeof(uint64_t);
+  } else {
+    uint64_t buf[INDEX_BLOCK_SIZE]; // temporary buffer for bit packing
+    loaded_columns.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+      auto column = read_column(*stream, buf);
+
+      if (!column) {
+        IR_FRMT_ERROR("Unable to load blocks index for column id=" IR_SIZE_T_SPECIFIER, i);
+        return false;
+      }
+
+      refs[i].store(column.get());
+      loaded_columns.emplace_back(std::move(column));
+    }
   }
 
   // noexcept
   context_provider::prepare(std::move(stream));
-  columns_ = std::move(columns);
+  columns_ = std::move(refs);
+  loaded_columns_ = std::move(loaded_columns);
+  index_in_ = std::move(index_in);
+  column_index_ptrs_ = column_index_ptrs;
 
   if (seen) {
     *seen = true;
@@ -3742,9 +4150,13 @@ bool reader::prepare(
 }
 
 const reader::column_reader* reader::column(field_id field) const {
-  return field >= columns_.size()
-    ? nullptr // can't find column with the specified identifier
-    : columns_[field].get();
+  if (field >= columns_.size()) {
+    return nullptr; // can't find column with the specified identifier
+  }
+
+  const auto* column = columns_[field].load(std::memory_order_acquire);
+
+  return column ? column : load_column(field);
 }
 
 NS_END // columns
@@ -3765,15 +4177,15 @@ const string_ref postings_writer::PAY_FORMAT_NAME = "iresearch_10_postings_paylo
 const string_ref postings_writer::PAY_EXT = "pay";
 
 void postings_writer::doc_stream::flush(uint64_t* buf, bool freq) {
-  encode::bitpack::write_block(*out, deltas, BLOCK_SIZE, buf);
+  codec->write_block(*out, deltas, buf);
 
   if (freq) {
-    encode::bitpack::write_block(*out, freqs.get(), BLOCK_SIZE, buf);
+    codec->write_block(*out, freqs.get(), buf);
   }
 }
 
 void postings_writer::pos_stream::flush(uint32_t* comp_buf) {
-  encode::bitpack::write_block(*out, this->buf, BLOCK_SIZE, comp_buf);
+  codec->write_block(*out, this->buf, comp_buf);
   size = 0;
 }
 
@@ -3801,19 +4213,24 @@ void postings_writer::pay_stream::flush_payload(uint32_t* buf) {
   if (pay_buf_.empty()) {
     return;
   }
-  encode::bitpack::write_block(*out, pay_sizes, BLOCK_SIZE, buf);
+  codec->write_block(*out, pay_sizes, buf);
   out->write_bytes(pay_buf_.c_str(), pay_buf_.size());
   pay_buf_.clear();
 }
 
 void postings_writer::pay_stream::flush_offsets(uint32_t* buf) {
-  encode::bitpack::write_block(*out, offs_start_buf, BLOCK_SIZE, buf);
-  encode::bitpack::write_block(*out, offs_len_buf, BLOCK_SIZE, buf);
+  codec->write_block(*out, offs_start_buf, buf);
+  codec->write_block(*out, offs_len_buf, buf);
 }
 
-postings_writer::postings_writer(bool volatile_attributes)
+postings_writer::postings_writer(
+    bool volatile_attributes,
+    int32_t version /*= FORMAT_BLOCK_MAX*/)
   : skip_(BLOCK_SIZE, SKIP_N),
+    codec_(&block_codec::get(version)),
+    version_(version),
     volatile_attributes_(volatile_attributes) {
+  assert(version >= FORMAT_BLOCK_MAX && version <= FORMAT_MAX);
   attrs_.emplace(docs_);
 }
 
@@ -3826,7 +4243,8 @@ void postings_writer::prepare(index_output& out, const iresearch::flush_state& s
   std::string name;
 
   // prepare document stream
-  detail::prepare_output(name, doc.out, state, DOC_EXT, DOC_FORMAT_NAME, FORMAT_MAX);
+  detail::prepare_output(name, doc.out, state, DOC_EXT, DOC_FORMAT_NAME, version_);
+  doc.codec = codec_;
 
   auto& features = *state.features;
   if (features.check<frequency>() && !doc.freqs) {
@@ -3842,7 +4260,8 @@ void postings_writer::prepare(index_output& out, const iresearch::flush_state& s
     }
 
     pos_->reset();
-    detail::prepare_output(name, pos_->out, state, POS_EXT, POS_FORMAT_NAME, FORMAT_MAX);
+    pos_->codec = codec_;
+    detail::prepare_output(name, pos_->out, state, POS_EXT, POS_FORMAT_NAME, version_);
 
     if (features.check< payload >() || features.check< offset >()) {
       // prepare payload stream
@@ -3851,7 +4270,8 @@ void postings_writer::prepare(index_output& out, const iresearch::flush_state& s
       }
 
       pay_->reset();
-      detail::prepare_output(name, pay_->out, state, PAY_EXT, PAY_FORMAT_NAME, FORMAT_MAX);
+      pay_->codec = codec_;
+      detail::prepare_output(name, pay_->out, state, PAY_EXT, PAY_FORMAT_NAME, version_);
     }
   }
 
@@ -3917,6 +4337,48 @@ irs::postings_writer::state postings_writer::write(doc_iterator& docs) {
 
   begin_term();
 
+  if (!freq) {
+    // representation of frequency-less postings depends on their
+    // density, so buffer the documents before writing anything
+    term_docs_.clear();
+
+    while (docs.next()) {
+      const auto did = docs.value();
+
+      assert(type_limits<type_t::doc_id_t>::valid(did));
+
+      if (!term_docs_.empty() && did < term_docs_.back()) {
+        // docs out of order
+        throw index_error();
+      }
+
+      term_docs_.push_back(did);
+      docs_.value.set(did - type_limits<type_t::doc_id_t>::min());
+    }
+
+    meta->docs_count = term_docs_.size();
+
+    if (meta->docs_count >= BLOCK_SIZE) {
+      const auto words = bitset::word(term_docs_.back())
+                       - bitset::word(term_docs_.front()) + 1;
+
+      if (meta->docs_count*DENSE_RATIO >= bitset::bit_offset(words)) {
+        write_dense(*meta);
+
+        return make_state(*meta.release());
+      }
+    }
+
+    for (const auto did : term_docs_) {
+      begin_doc(did, nullptr);
+      end_doc();
+    }
+
+    end_term(*meta, nullptr);
+
+    return make_state(*meta.release());
+  }
+
   while (docs.next()) {
     const auto did = docs.value();
 
@@ -3939,6 +4401,7 @@ irs::postings_writer::state postings_writer::write(doc_iterator& docs) {
     ++meta->docs_count;
     if (tfreq) {
       (*tfreq) += freq->value;
+      meta->max_freq = std::max(meta->max_freq, freq->value);
     }
 
     end_doc();
@@ -3983,6 +4446,7 @@ void postings_writer::begin_term() {
 
   doc.last = type_limits<type_t::doc_id_t>::min(); // for proper delta of 1st id
   doc.block_last = type_limits<type_t::doc_id_t>::invalid();
+  std::fill_n(doc.skip_freq, MAX_SKIP_LEVELS, 0);
   skip_.reset();
 }
 
@@ -4041,6 +4505,15 @@ void postings_writer::end_doc() {
   if ( doc.full() ) {
     doc.block_last = doc.last;
     doc.end = doc.out->file_pointer();
+    if (features_.freq()) {
+      assert(doc.freqs);
+      // maximum frequency is accumulated for every level
+      // and reset once the skip entry is written
+      const auto block_max = *std::max_element(doc.freqs.get(), doc.freqs.get() + BLOCK_SIZE);
+      for (auto& max : doc.skip_freq) {
+        max = std::max(max, block_max);
+      }
+    }
     if ( pos_ ) {
       assert( pos_ );
       pos_->end = pos_->out->file_pointer();
@@ -4062,12 +4535,22 @@ void postings_writer::end_term(version10::term_meta& meta, const uint64_t* tfreq
     return; // no documents to write
   }
 
+  // postings of rare terms are stored within the term dictionary
+  // unless some of their positions are already flushed as a block
+  const bool inlined = detail::is_inlined(
+    meta.docs_count, features_.position(), tfreq ? *tfreq : 0
+  );
+
+  inline_out_.reset();
+
   if (1 == meta.docs_count) {
     meta.e_single_doc = doc.deltas[0];
   } else {
     /* write remaining documents using
      * variable length encoding */
-    data_output& out = *doc.out;
+    data_output& out = inlined
+      ? static_cast<data_output&>(inline_out_)
+      : *doc.out;
     for (uint32_t i = 0; i < doc.size; ++i) {
       const uint32_t doc_delta = doc.deltas[i];
 
@@ -4101,7 +4584,9 @@ void postings_writer::end_term(version10::term_meta& meta, const uint64_t* tfreq
     }
 
     if (pos_->size > 0) {
-      data_output& out = *pos_->out;
+      data_output& out = inlined
+        ? static_cast<data_output&>(inline_out_)
+        : *pos_->out;
       uint32_t last_pay_size = integer_traits<uint32_t>::const_max;
       uint32_t last_offs_len = integer_traits<uint32_t>::const_max;
       uint32_t pay_buf_start = 0;
@@ -4153,6 +4638,13 @@ void postings_writer::end_term(version10::term_meta& meta, const uint64_t* tfreq
     skip_.flush(*doc.out);
   }
 
+  meta.inlined.clear();
+
+  if (inlined) {
+    // documents go first, followed by positions
+    meta.inlined.assign(inline_out_.c_str(), inline_out_.size());
+  }
+
   docs_count = 0;
   doc.size = 0;
   doc.last = 0;
@@ -4171,6 +4663,37 @@ void postings_writer::end_term(version10::term_meta& meta, const uint64_t* tfreq
   }
 }
 
+void postings_writer::write_dense(version10::term_meta& meta) {
+  assert(!term_docs_.empty());
+
+  // postings are written as the words of a bitset indexed by
+  // document id, covering the words of the first and the last documents
+  const auto first = bitset::word(term_docs_.front());
+  const auto last = bitset::word(term_docs_.back());
+
+  data_output& out = *doc.out;
+  out.write_vlong(first);
+  out.write_vlong(last - first + 1);
+
+  auto current = first;
+  bitset::word_t word = 0;
+
+  for (const auto did : term_docs_) {
+    for (const auto idx = bitset::word(did); current < idx; ++current) {
+      out.write_long(word);
+      word = 0;
+    }
+
+    set_bit(word, bitset::bit(did));
+  }
+
+  out.write_long(word);
+
+  meta.dense = true;
+  meta.freq = integer_traits<uint64_t>::const_max;
+  meta.doc_start = doc.start;
+}
+
 void postings_writer::write_skip(size_t level, index_output& out) {
   const uint32_t doc_delta = doc.block_last; //- doc.skip_doc[level];
   const uint64_t doc_ptr = doc.out->file_pointer();
@@ -4204,6 +4727,11 @@ void postings_writer::write_skip(size_t level, index_output& out) {
       pay_->skip_ptr[level] = pay_ptr;
     }
   }
+
+  if (features_.freq()) {
+    out.write_vlong(doc.skip_freq[level]);
+    doc.skip_freq[level] = 0;
+  }
 }
 
 void postings_writer::encode(
@@ -4215,28 +4743,50 @@ void postings_writer::encode(
   const auto& meta = static_cast<const version10::term_meta&>(state);
 #endif // IRESEARCH_DEBUG
 
-  out.write_vlong(meta.docs_count);
+  out.write_vlong(shift_pack_64(meta.docs_count, meta.dense));
   if (meta.freq != integer_traits<uint64_t>::const_max) {
     assert(meta.freq >= meta.docs_count);
     out.write_vlong(meta.freq - meta.docs_count);
   }
 
-  out.write_vlong(meta.doc_start - last_state.doc_start);
-  if (features_.position()) {
-    out.write_vlong(meta.pos_start - last_state.pos_start);
-    if (type_limits<type_t::address_t>::valid(meta.pos_end)) {
-      out.write_vlong(meta.pos_end);
-    }
-    if (features_.payload() || features_.offset()) {
-      out.write_vlong(meta.pay_start - last_state.pay_start);
+  // postings of inlined terms don't refer to the postings files
+  const bool inlined = !meta.inlined.empty();
+  assert(inlined == detail::is_inlined(
+    meta.docs_count, features_.position(), meta.freq
+  ));
+
+  if (!inlined) {
+    out.write_vlong(meta.doc_start - last_state.doc_start);
+    if (features_.position()) {
+      out.write_vlong(meta.pos_start - last_state.pos_start);
+      if (type_limits<type_t::address_t>::valid(meta.pos_end)) {
+        out.write_vlong(meta.pos_end);
+      }
+      if (features_.payload() || features_.offset()) {
+        out.write_vlong(meta.pay_start - last_state.pay_start);
+      }
     }
+
+    // only file pointers are encoded relative to the previous term
+    last_state.doc_start = meta.doc_start;
+    last_state.pos_start = meta.pos_start;
+    last_state.pay_start = meta.pay_start;
   }
 
-  if (1U == meta.docs_count || meta.docs_count > postings_writer::BLOCK_SIZE) {
+  if (!meta.dense
+      && (1U == meta.docs_count || meta.docs_count > postings_writer::BLOCK_SIZE)) {
     out.write_vlong(meta.e_skip_start);
   }
 
-  last_state = meta;
+  // for a single document term frequency is the maximum one
+  if (meta.freq != integer_traits<uint64_t>::const_max && meta.docs_count > 1) {
+    out.write_vlong(meta.max_freq);
+  }
+
+  if (inlined) {
+    out.write_vlong(meta.inlined.size());
+    out.write_bytes(meta.inlined.c_str(), meta.inlined.size());
+  }
 }
 
 void postings_writer::end() {
@@ -4265,7 +4815,7 @@ bool postings_reader::prepare(
   std::string buf;
 
   // prepare document input
-  detail::prepare_input(
+  version_ = detail::prepare_input(
     buf, doc_in_, irs::IOAdvice::RANDOM, state,
     postings_writer::DOC_EXT,
     postings_writer::DOC_FORMAT_NAME,
@@ -4317,7 +4867,7 @@ bool postings_reader::prepare(
   }
 
   // check postings format
-  format_utils::check_header(in,
+  terms_version_ = format_utils::check_header(in,
     postings_writer::TERMS_FORMAT_NAME,
     postings_writer::TERMS_FORMAT_MIN,
     postings_writer::TERMS_FORMAT_MAX
@@ -4346,27 +4896,59 @@ void postings_reader::decode(
 
   auto& term_freq = attrs.get<frequency>();
 
-  term_meta.docs_count = in.read_vlong();
+  if (terms_version_ >= postings_writer::TERMS_FORMAT_DENSE) {
+    term_meta.dense = shift_unpack_64(in.read_vlong(), term_meta.docs_count);
+  } else {
+    term_meta.docs_count = in.read_vlong();
+    term_meta.dense = false;
+  }
+
   if (term_freq) {
     term_freq->value = term_meta.docs_count + in.read_vlong();
   }
 
-  term_meta.doc_start += in.read_vlong();
-  if (term_freq && term_freq->value && meta.check<position>()) {
-    term_meta.pos_start += in.read_vlong();
+  // postings of inlined terms don't refer to the postings files
+  const bool inlined = terms_version_ >= postings_writer::TERMS_FORMAT_INLINE
+    && detail::is_inlined(
+         term_meta.docs_count,
+         meta.check<position>(),
+         term_freq ? term_freq->value : 0
+       );
+
+  term_meta.pos_end = type_limits<type_t::address_t>::invalid();
 
-    term_meta.pos_end = term_freq->value > postings_writer::BLOCK_SIZE
-        ? in.read_vlong()
-        : type_limits<type_t::address_t>::invalid();
+  if (!inlined) {
+    term_meta.doc_start += in.read_vlong();
+    if (term_freq && term_freq->value && meta.check<position>()) {
+      term_meta.pos_start += in.read_vlong();
 
-    if (meta.check<payload>() || meta.check<offset>()) {
-      term_meta.pay_start += in.read_vlong();
+      term_meta.pos_end = term_freq->value > postings_writer::BLOCK_SIZE
+          ? in.read_vlong()
+          : type_limits<type_t::address_t>::invalid();
+
+      if (meta.check<payload>() || meta.check<offset>()) {
+        term_meta.pay_start += in.read_vlong();
+      }
     }
   }
 
-  if (1U == term_meta.docs_count || term_meta.docs_count > postings_writer::BLOCK_SIZE) {
+  if (!term_meta.dense
+      && (1U == term_meta.docs_count || term_meta.docs_count > postings_writer::BLOCK_SIZE)) {
     term_meta.e_skip_start = in.read_vlong();
   }
+
+  term_meta.max_freq = 0;
+  if (term_freq
+      && terms_version_ >= postings_writer::TERMS_FORMAT_MAX_FREQ
+      && term_meta.docs_count > 1) {
+    term_meta.max_freq = in.read_vlong();
+  }
+
+  term_meta.inlined.clear();
+  if (inlined) {
+    term_meta.inlined.resize(in.read_vlong());
+    in.read_bytes(&(term_meta.inlined[0]), term_meta.inlined.size());
+  }
 }
 
 doc_iterator::ptr postings_reader::iterator(
@@ -4378,6 +4960,14 @@ doc_iterator::ptr postings_reader::iterator(
 
   // compile field features
   const auto features = version10::features(field);
+
+  assert(attrs.contains<version10::term_meta>());
+  const auto& term_state = *attrs.get<version10::term_meta>();
+
+  if (term_state.dense) {
+    return doc_iterator::make<detail::dense_doc_iterator>(term_state, *doc_in_);
+  }
+
   // get enabled features:
   // find intersection between requested and available features
   const auto enabled = features & req;
@@ -4388,7 +4978,8 @@ doc_iterator::ptr postings_reader::iterator(
 
   it->prepare(
     features, enabled, attrs,
-    doc_in_.get(), pos_in_.get(), pay_in_.get() 
+    doc_in_.get(), pos_in_.get(), pay_in_.get(),
+    version_
   );
 
   return MOVE_WORKAROUND_MSVC2013(it);
@@ -4423,7 +5014,15 @@ features& features::operator&=(const flags& in) NOEXCEPT {
 // ----------------------------------------------------------------------------
 
 
-format::format(): iresearch::format(format::type()) {}
+format::format()
+  : format(format::type(), postings_writer::FORMAT_BLOCK_MAX) {
+}
+
+format::format(
+    const iresearch::format::type_id& type,
+    int32_t postings_version)
+  : iresearch::format(type), postings_version_(postings_version) {
+}
 
 index_meta_writer::ptr format::get_index_meta_writer() const  {
   return iresearch::index_meta_writer::make<index_meta_writer>();
@@ -4460,7 +5059,9 @@ document_mask_reader::ptr format::get_document_mask_reader() const {
 
 field_writer::ptr format::get_field_writer(bool volatile_state) const {
   return iresearch::field_writer::make<burst_trie::field_writer>(
-    iresearch::postings_writer::make<version10::postings_writer>(volatile_state),
+    iresearch::postings_writer::make<version10::postings_writer>(
+      volatile_state, postings_version_
+    ),
     volatile_state
   );
 }
@@ -4491,6 +5092,18 @@ DEFINE_FORMAT_TYPE_NAMED(iresearch::version10::format, "1_0");
 REGISTER_FORMAT( iresearch::version10::format );
 DEFINE_FACTORY_SINGLETON(format);
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                                      format_pfor
+// ----------------------------------------------------------------------------
+
+format_pfor::format_pfor()
+  : format(format_pfor::type(), postings_writer::FORMAT_PFOR) {
+}
+
+DEFINE_FORMAT_TYPE_NAMED(iresearch::version10::format_pfor, "1_0_pfor");
+REGISTER_FORMAT( iresearch::version10::format_pfor );
+DEFINE_FACTORY_SINGLETON(format_pfor);
+
 NS_END /* version10 */
 NS_END /* root */
 
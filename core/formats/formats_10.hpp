@@ -25,6 +25,7 @@
 #define IRESEARCH_FORMATS_10_H
 
 #include "formats.hpp"
+#include "format_utils.hpp"
 #include "skip_list.hpp"
 
 #include "formats_10_attributes.hpp"
@@ -47,22 +48,6 @@
 
 #include <list>
 
-#if defined(_MSC_VER)
-  #pragma warning(disable : 4244)
-  #pragma warning(disable : 4245)
-#elif defined (__GNUC__)
-  // NOOP
-#endif
-
-#include <boost/crc.hpp>
-
-#if defined(_MSC_VER)
-  #pragma warning(default: 4244)
-  #pragma warning(default: 4245)
-#elif defined (__GNUC__)
-  // NOOP
-#endif
-
 #if defined(_MSC_VER)
   #pragma warning(disable : 4351)
 #endif
@@ -141,10 +126,12 @@ struct segment_meta_writer final : public iresearch::segment_meta_writer{
   static const string_ref FORMAT_NAME;
 
   static const int32_t FORMAT_MIN = 0;
-  static const int32_t FORMAT_MAX = FORMAT_MIN;
+  static const int32_t FORMAT_SORT = 1; // segments may be sorted by a column
+  static const int32_t FORMAT_MAX = FORMAT_SORT;
 
   enum flags_t {
     HAS_COLUMN_STORE = 1,
+    HAS_SORT = 2,
   };
 
   virtual std::string filename(const segment_meta& meta) const override;
@@ -174,7 +161,8 @@ class document_mask_writer final: public iresearch::document_mask_writer {
   static const string_ref FORMAT_NAME;
 
   static const int32_t FORMAT_MIN = 0;
-  static const int32_t FORMAT_MAX = FORMAT_MIN;
+  static const int32_t FORMAT_BITMAP = 1; // mask is stored as a bitmap
+  static const int32_t FORMAT_MAX = FORMAT_BITMAP;
 
   virtual ~document_mask_writer();
   virtual std::string filename(const segment_meta& meta) const override;
@@ -186,6 +174,7 @@ class document_mask_writer final: public iresearch::document_mask_writer {
 private:
   friend document_mask_reader;
   index_output::ptr out_;
+  document_mask docs_mask_; // documents collected so far
 };
 
 /* -------------------------------------------------------------------
@@ -207,7 +196,10 @@ public:
   virtual void end() override;
 
 private:
-  checksum_index_input<::boost::crc_32_type> in_;
+  checksum_index_input<format_utils::footer_checksum> in_;
+  document_mask docs_mask_; // decoded bitmap
+  document_mask::const_iterator next_{ nullptr, nullptr }; // next document to read
+  int32_t version_{};
 };
 
 /* -------------------------------------------------------------------
@@ -220,11 +212,16 @@ private:
 *                          ^                       ^       (level 0 skip point)
 *
 * ------------------------------------------------------------------*/
+struct block_codec;
+
 class IRESEARCH_PLUGIN postings_writer final: public iresearch::postings_writer {
  public:
   static const string_ref TERMS_FORMAT_NAME;
   static const int32_t TERMS_FORMAT_MIN = 0;
-  static const int32_t TERMS_FORMAT_MAX = TERMS_FORMAT_MIN;
+  static const int32_t TERMS_FORMAT_MAX_FREQ = 1; // term meta contains maximum term frequency
+  static const int32_t TERMS_FORMAT_DENSE = 2; // term meta flags postings stored as a bitset
+  static const int32_t TERMS_FORMAT_INLINE = 3; // term meta contains postings of rare terms
+  static const int32_t TERMS_FORMAT_MAX = TERMS_FORMAT_INLINE;
 
   static const string_ref DOC_FORMAT_NAME;
   static const string_ref DOC_EXT;
@@ -234,13 +231,26 @@ class IRESEARCH_PLUGIN postings_writer final: public iresearch::postings_writer
   static const string_ref PAY_EXT;
 
   static const int32_t FORMAT_MIN = 0;
-  static const int32_t FORMAT_MAX = FORMAT_MIN;
+  static const int32_t FORMAT_BLOCK_MAX = 1; // skip data contains maximum term frequency
+  static const int32_t FORMAT_PFOR = 2; // full blocks use patched frame of reference
+  static const int32_t FORMAT_MAX = FORMAT_PFOR;
 
   static const uint32_t MAX_SKIP_LEVELS = 10;
   static const uint32_t BLOCK_SIZE = 128;
   static const uint32_t SKIP_N = 8;
 
-  postings_writer(bool volatile_attributes);
+  // frequency-less postings of at least 'BLOCK_SIZE' documents are stored as
+  // a bitset if at least every 'DENSE_RATIO'th document of their range is set
+  static const uint32_t DENSE_RATIO = 4;
+
+  // postings of terms with at most 'INLINE_MAX_DOCS' documents and less than
+  // 'BLOCK_SIZE' positions are stored within the term dictionary
+  static const uint32_t INLINE_MAX_DOCS = 2;
+
+  postings_writer(
+    bool volatile_attributes,
+    int32_t version = FORMAT_BLOCK_MAX // postings format version to write
+  );
 
   /*------------------------------------------
   * const_attributes_provider 
@@ -272,6 +282,7 @@ class IRESEARCH_PLUGIN postings_writer final: public iresearch::postings_writer
 
     uint64_t skip_ptr[MAX_SKIP_LEVELS]{};   /* skip data */
     index_output::ptr out;                  /* output stream*/
+    const block_codec* codec{};             /* encoding of the full blocks */
     uint64_t start{};                       /* start position of block */
     uint64_t end{};                         /* end position of block */
   }; // stream
@@ -292,6 +303,7 @@ class IRESEARCH_PLUGIN postings_writer final: public iresearch::postings_writer
 
     doc_id_t deltas[BLOCK_SIZE]{}; // document deltas
     doc_id_t skip_doc[MAX_SKIP_LEVELS]{};
+    uint64_t skip_freq[MAX_SKIP_LEVELS]{}; // maximum frequency since the last skip
     std::unique_ptr<uint64_t[]> freqs; /* document frequencies */
     doc_id_t last{ type_limits<type_t::doc_id_t>::invalid() }; // last buffered document id
     doc_id_t block_last{}; // last document id in a block
@@ -350,6 +362,7 @@ class IRESEARCH_PLUGIN postings_writer final: public iresearch::postings_writer
   void add_position( uint32_t pos, const offset* offs, const payload* pay );
   void end_doc();
   void end_term(version10::term_meta& state, const uint64_t* tfreq);
+  void write_dense(version10::term_meta& state);
 
   IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
   memory::memory_pool<> meta_pool_;
@@ -363,7 +376,11 @@ class IRESEARCH_PLUGIN postings_writer final: public iresearch::postings_writer
   pay_stream::ptr pay_;      /* payloads and offsets stream */
   uint64_t docs_count{};      /* count of processed documents */
   version10::documents docs_; /* bit set of all processed documents */
+  std::vector<doc_id_t> term_docs_; // buffered documents of a frequency-less term
+  bytes_output inline_out_; // postings of a rare term to be stored within its meta
   features features_; /* features supported by current field */
+  const block_codec* codec_; // encoding of the full blocks
+  const int32_t version_; // postings format version to write
   bool volatile_attributes_; // attribute value memory locations may change after next()
   IRESEARCH_API_PRIVATE_VARIABLES_END
 };
@@ -398,6 +415,8 @@ class IRESEARCH_PLUGIN postings_reader final: public iresearch::postings_reader
   index_input::ptr doc_in_;
   index_input::ptr pos_in_;
   index_input::ptr pay_in_;
+  int32_t version_{}; // postings format version
+  int32_t terms_version_{}; // term meta format version
   IRESEARCH_API_PRIVATE_VARIABLES_END
 };
 
@@ -405,7 +424,7 @@ class IRESEARCH_PLUGIN postings_reader final: public iresearch::postings_reader
  * format
  * ------------------------------------------------------------------*/
 
-class IRESEARCH_PLUGIN format final : public iresearch::format {
+class IRESEARCH_PLUGIN format : public iresearch::format {
  public:
   DECLARE_FORMAT_TYPE();
   DECLARE_FACTORY_DEFAULT();
@@ -428,6 +447,25 @@ class IRESEARCH_PLUGIN format final : public iresearch::format {
 
   virtual columnstore_writer::ptr get_columnstore_writer() const override;
   virtual columnstore_reader::ptr get_columnstore_reader() const override;
+
+ protected:
+  format(const iresearch::format::type_id& type, int32_t postings_version);
+
+ private:
+  int32_t postings_version_; // version of the postings to write
+};
+
+/* -------------------------------------------------------------------
+ * format_pfor
+ * same as 'format' but full blocks of postings are encoded using
+ * patched frame of reference
+ * ------------------------------------------------------------------*/
+
+class IRESEARCH_PLUGIN format_pfor final : public format {
+ public:
+  DECLARE_FORMAT_TYPE();
+  DECLARE_FACTORY_DEFAULT();
+  format_pfor();
 };
 
 NS_END
@@ -50,13 +50,19 @@ struct term_meta final : irs::term_meta {
   void clear() {
     irs::term_meta::clear();
     doc_start = pos_start = pay_start = 0;
+    max_freq = 0;
     pos_end = type_limits<type_t::address_t>::invalid();
+    dense = false;
+    inlined.clear();
   }
 
   uint64_t doc_start = 0; // where this term's postings start in the .doc file
   uint64_t pos_start = 0; // where this term's postings start in the .pos file
   uint64_t pos_end = type_limits<type_t::address_t>::invalid(); // file pointer where the last (vInt encoded) pos delta is
   uint64_t pay_start = 0; // where this term's payloads/offsets start in the .pay file
+  uint64_t max_freq = 0; // maximum term frequency within a single document, 0 if unknown
+  bool dense = false; // postings are stored as a bitset
+  bstring inlined; // postings stored within the term dictionary, empty if none
   union {
     doc_id_t e_single_doc; // singleton document id delta
     uint64_t e_skip_start; // pointer where skip data starts (after doc_start)
@@ -34,6 +34,7 @@
 #include "index/index_meta.hpp"
 
 #include "store/checksum_io.hpp"
+#include "utils/thread_utils.hpp"
 #include "utils/timer_utils.hpp"
 #include "utils/fst.hpp"
 #include "utils/fst_utils.hpp"
@@ -44,6 +45,7 @@
 #include "utils/string.hpp"
 #include "utils/log.hpp"
 #include "utils/fst_matcher.hpp"
+#include "utils/numeric_utils.hpp"
 
 #if defined(_MSC_VER)
   // NOOP
@@ -71,22 +73,6 @@
 
 #include <fst/matcher.h>
 
-#if defined(_MSC_VER)
-  #pragma warning(disable : 4244)
-  #pragma warning(disable : 4245)
-#elif defined (__GNUC__)
-  // NOOP
-#endif
-
-#include <boost/crc.hpp>
-
-#if defined(_MSC_VER)
-  #pragma warning(default: 4244)
-  #pragma warning(default: 4245)
-#elif defined (__GNUC__)
-  // NOOP
-#endif
-
 #include <cassert>
 
 NS_ROOT
@@ -95,6 +81,155 @@ NS_BEGIN(burst_trie)
 
 NS_BEGIN(detail)
 
+///////////////////////////////////////////////////////////////////////////////
+/// @brief hash of a term used by per-field bloom filters, the value is
+///        persisted so it must not depend on platform (FNV-1a + fmix64)
+///////////////////////////////////////////////////////////////////////////////
+inline uint64_t bloom_hash(const bytes_ref& term) NOEXCEPT {
+  uint64_t h = UINT64_C(14695981039346656037);
+  for (auto* c = term.c_str(), *end = c + term.size(); c != end; ++c) {
+    h ^= *c;
+    h *= UINT64_C(1099511628211);
+  }
+
+  h ^= h >> 33;
+  h *= UINT64_C(0xff51afd7ed558ccd);
+  h ^= h >> 33;
+  h *= UINT64_C(0xc4ceb9fe1a85ec53);
+  h ^= h >> 33;
+  return h;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief invokes 'visitor' for each of 'hashes' bit positions of a term
+///        within a bloom filter of 'bits' bits (double hashing)
+///////////////////////////////////////////////////////////////////////////////
+template<typename Visitor>
+inline bool bloom_visit(
+    uint64_t hash, uint64_t bits, uint32_t hashes, Visitor visitor) {
+  const uint64_t delta = ((hash >> 32) | (hash << 32)) | 1;
+
+  for (; hashes; --hashes, hash += delta) {
+    if (!visitor(hash % bits)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @class recording_doc_iterator
+/// @brief passes postings through, collecting the visited document ids
+///////////////////////////////////////////////////////////////////////////////
+class recording_doc_iterator final : public doc_iterator {
+ public:
+  recording_doc_iterator(doc_iterator::ptr&& impl, std::vector<doc_id_t>& docs)
+    : impl_(std::move(impl)), docs_(&docs) {
+    assert(impl_);
+  }
+
+  virtual const attribute_view& attributes() const NOEXCEPT override {
+    return impl_->attributes();
+  }
+
+  virtual bool next() override {
+    if (!impl_->next()) {
+      return false;
+    }
+
+    docs_->push_back(impl_->value());
+    return true;
+  }
+
+  virtual doc_id_t seek(doc_id_t target) override {
+    irs::seek(*this, target);
+    return value();
+  }
+
+  virtual doc_id_t value() const override {
+    return impl_->value();
+  }
+
+ private:
+  doc_iterator::ptr impl_;
+  std::vector<doc_id_t>* docs_;
+}; // recording_doc_iterator
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief invokes 'visitor' for each (document, value) pair of a points block
+///////////////////////////////////////////////////////////////////////////////
+template<typename Visitor>
+void read_points_block(
+    index_input& in, const points_block& block, bstring& value,
+    Visitor visitor) {
+  in.seek(block.offset);
+
+  // block is a sequence of runs of documents sharing the same value,
+  // the value of a run is prefix-coded against the previous one
+  for (auto runs = in.read_vint(); runs; --runs) {
+    const size_t prefix = in.read_vint();
+    const size_t suffix = in.read_vint();
+
+    if (prefix > value.size()) {
+      throw index_error();
+    }
+
+    value.resize(prefix + suffix);
+
+    if (suffix != in.read_bytes(&value[0] + prefix, suffix)) {
+      throw index_error();
+    }
+
+    doc_id_t doc = 0;
+
+    for (auto count = in.read_vint(); count; --count) {
+      doc += in.read_vlong();
+      visitor(doc, value);
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief walks the implicit tree over the points blocks [begin, end),
+///        cells entirely inside or outside the query are decided without
+///        comparing individual values
+///////////////////////////////////////////////////////////////////////////////
+inline void intersect_points(
+    index_input& in, points_visitor& visitor,
+    const points_block* begin, const points_block* end,
+    bstring& value) {
+  assert(begin < end);
+
+  switch (visitor.compare(begin->min, (end - 1)->max)) {
+    case points_visitor::relation::OUTSIDE:
+      return;
+    case points_visitor::relation::INSIDE:
+      for (; begin != end; ++begin) {
+        read_points_block(
+          in, *begin, value,
+          [&visitor](doc_id_t doc, const bytes_ref&) { visitor.visit(doc); }
+        );
+      }
+      return;
+    case points_visitor::relation::CROSSES:
+      break;
+  }
+
+  if (1 == std::distance(begin, end)) {
+    read_points_block(
+      in, *begin, value,
+      [&visitor](doc_id_t doc, const bytes_ref& point) {
+        visitor.visit(doc, point);
+    });
+    return;
+  }
+
+  const auto* middle = begin + std::distance(begin, end) / 2;
+  intersect_points(in, visitor, begin, middle, value);
+  intersect_points(in, visitor, middle, end, value);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @struct block_meta
 /// @brief Provides set of helper functions to work with block metadata
@@ -194,7 +329,7 @@ inline void prepare_output(
   format_utils::write_header(*out, format, version);
 }
 
-inline void prepare_input(
+inline int32_t prepare_input(
     std::string& str,
     index_input::ptr& in,
     irs::IOAdvice advice,
@@ -216,7 +351,7 @@ inline void prepare_input(
     throw detailed_io_error(ss.str());
   }
 
-  format_utils::check_header(*in, format, min_ver, max_ver);
+  return format_utils::check_header(*in, format, min_ver, max_ver);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -875,7 +1010,7 @@ void block_iterator::reset() {
 
 term_iterator::term_iterator(const term_reader* owner)
   : owner_(owner),
-    matcher_(*owner->fst_, fst::MATCH_INPUT),
+    matcher_(owner->fst(), fst::MATCH_INPUT),
     attrs_(2), // version10::term_meta + frequency
     cur_block_(nullptr) {
   assert(owner_);
@@ -899,7 +1034,7 @@ bool term_iterator::next() {
   if (!cur_block_) {
     if (term_.empty()) {
       /* iterator at the beginning */
-      const auto& fst = *owner_->fst_;
+      const auto& fst = owner_->fst();
       cur_block_ = push_block(fst.Final(fst.Start()), 0);
       cur_block_->load();
     } else {
@@ -1011,11 +1146,9 @@ ptrdiff_t term_iterator::seek_cached(
 }
 
 SeekResult term_iterator::seek_equal(const bytes_ref& term) {
-  assert(owner_->fst_);
-
   typedef fst_t::Weight weight_t;
 
-  const auto& fst = *owner_->fst_;
+  const auto& fst = owner_->fst();
 
   size_t prefix = 0; // number of current symbol to process
   arc::stateid_t state = fst.Start(); // start state
@@ -1151,7 +1284,14 @@ term_reader::term_reader(term_reader&& rhs) NOEXCEPT
     doc_freq_(rhs.doc_freq_),
     term_freq_(rhs.term_freq_),
     field_(std::move(rhs.field_)),
-    fst_(rhs.fst_),
+    bloom_(std::move(rhs.bloom_)),
+    bloom_offset_(rhs.bloom_offset_),
+    bloom_size_(rhs.bloom_size_),
+    bloom_hashes_(rhs.bloom_hashes_),
+    bloom_loaded_(rhs.bloom_loaded_.exchange(false)),
+    points_(std::move(rhs.points_)),
+    fst_offset_(rhs.fst_offset_),
+    fst_(rhs.fst_.exchange(nullptr)),
     owner_(rhs.owner_) {
   min_term_ref_ = min_term_;
   max_term_ref_ = max_term_;
@@ -1161,22 +1301,119 @@ term_reader::term_reader(term_reader&& rhs) NOEXCEPT
   rhs.doc_count_ = 0;
   rhs.doc_freq_ = 0;
   rhs.term_freq_ = 0;
-  rhs.fst_ = nullptr;
+  rhs.bloom_offset_ = 0;
+  rhs.bloom_size_ = 0;
+  rhs.bloom_hashes_ = 0;
+  rhs.fst_offset_ = 0;
   rhs.owner_ = nullptr;
 }
 
 term_reader::~term_reader() {
-  delete fst_;
+  delete fst_.load();
+}
+
+const term_reader::fst_t& term_reader::fst() const {
+  auto* fst = fst_.load(std::memory_order_acquire);
+
+  if (fst) {
+    return *fst;
+  }
+
+  assert(owner_ && owner_->index_in_);
+  SCOPED_LOCK(owner_->index_in_mutex_);
+  fst = fst_.load(std::memory_order_relaxed);
+
+  if (!fst) {
+    auto& in = *owner_->index_in_;
+    in.seek(fst_offset_);
+
+    input_buf isb(&in);
+    std::istream input(&isb); // wrap stream to be OpenFST compliant
+    fst = fst_t::Read(input, fst::FstReadOptions());
+
+    if (!fst) {
+      throw index_error();
+    }
+
+    fst_.store(fst, std::memory_order_release);
+  }
+
+  return *fst;
+}
+
+const bstring& term_reader::bloom() const {
+  if (bloom_loaded_.load(std::memory_order_acquire)) {
+    return bloom_;
+  }
+
+  assert(owner_ && owner_->index_in_);
+  SCOPED_LOCK(owner_->index_in_mutex_);
+
+  if (!bloom_loaded_.load(std::memory_order_relaxed)) {
+    auto& in = *owner_->index_in_;
+    in.seek(bloom_offset_);
+    bloom_.resize(bloom_size_);
+
+    if (bloom_size_ != in.read_bytes(&bloom_[0], bloom_size_)) {
+      IR_FRMT_ERROR(
+        "failed to read bloom filter of field: '%s'", field_.name.c_str()
+      );
+
+      throw index_error();
+    }
+
+    bloom_loaded_.store(true, std::memory_order_release);
+  }
+
+  return bloom_;
 }
 
 seek_term_iterator::ptr term_reader::iterator() const {
   return seek_term_iterator::make<detail::term_iterator>( this );
 }
-  
+
+bool term_reader::may_contain(const bytes_ref& term) const {
+  if (!bloom_size_) {
+    return true; // no filter for the field
+  }
+
+  const auto& bloom = this->bloom();
+
+  return bloom_visit(
+    bloom_hash(term), 8*bloom_size_, bloom_hashes_,
+    [&bloom](uint64_t bit) {
+      return 0 != (bloom[bit >> 3] & (1 << (bit & 7)));
+  });
+}
+
+bool term_reader::intersect(points_visitor& visitor) const {
+  if (points_.empty()) {
+    return false; // no points index for the field
+  }
+
+  assert(owner_ && owner_->terms_in_);
+  auto in = owner_->terms_in_->reopen();
+
+  if (!in) {
+    IR_FRMT_FATAL("Failed to reopen terms input in: %s", __FUNCTION__);
+
+    throw detailed_io_error("Failed to reopen terms input");
+  }
+
+  bstring value; // value of the current point
+
+  intersect_points(
+    *in, visitor, points_.data(), points_.data() + points_.size(), value
+  );
+
+  return true;
+}
+
 bool term_reader::prepare(
-    std::istream& in, 
+    std::istream& in,
     const feature_map_t& feature_map,
-    field_reader& owner) {
+    field_reader& owner,
+    int32_t version) {
   // read field metadata
   index_input& meta_in = *static_cast<input_buf*>(in.rdbuf());
   field_.name = read_string<std::string>(meta_in);
@@ -1199,9 +1436,56 @@ bool term_reader::prepare(
     attrs_.emplace(freq_);
   }
 
-  // read fst
-  fst_ = fst_t::Read(in, fst::FstReadOptions());
-  assert(fst_);
+  if (version >= field_writer::FORMAT_BLOOM) {
+    // read optional bloom filter
+    bloom_size_ = meta_in.read_vlong();
+
+    if (bloom_size_) {
+      bloom_hashes_ = meta_in.read_vint();
+      bloom_offset_ = meta_in.file_pointer();
+
+      if (version >= field_writer::FORMAT_FST_SIZE) {
+        // defer reading of the filter until the field is probed
+        meta_in.seek(bloom_offset_ + bloom_size_);
+      } else {
+        bloom_.resize(bloom_size_);
+
+        if (bloom_size_ != meta_in.read_bytes(&bloom_[0], bloom_size_)) {
+          IR_FRMT_ERROR(
+            "failed to read bloom filter of field: '%s'", field_.name.c_str()
+          );
+          return false;
+        }
+
+        bloom_loaded_ = true;
+      }
+    }
+  }
+
+  if (version >= field_writer::FORMAT_POINTS) {
+    // read optional points index, block data is read on demand
+    points_.resize(meta_in.read_vlong());
+
+    uint64_t offset = 0;
+
+    for (auto& block : points_) {
+      block.min = read_string<bstring>(meta_in);
+      block.max = read_string<bstring>(meta_in);
+      offset += meta_in.read_vlong();
+      block.offset = offset;
+      block.count = meta_in.read_vlong();
+    }
+  }
+
+  if (version >= field_writer::FORMAT_FST_SIZE) {
+    // defer reading of the fst until the field is accessed
+    const uint64_t fst_size = meta_in.read_vlong();
+    fst_offset_ = meta_in.file_pointer();
+    meta_in.seek(fst_offset_ + fst_size);
+  } else {
+    fst_ = fst_t::Read(in, fst::FstReadOptions());
+    assert(fst_);
+  }
 
   owner_ = &owner;
   return true;
@@ -1448,13 +1732,15 @@ field_writer::field_writer(
     iresearch::postings_writer::ptr&& pw,
     bool volatile_state,
     uint32_t min_block_size,
-    uint32_t max_block_size)
+    uint32_t max_block_size,
+    uint32_t bloom_bits_per_term)
   : pw(std::move(pw)),
     fst_buf_(memory::make_unique<detail::fst_buffer>()),
     prefixes(DEFAULT_SIZE, 0),
     term_count(0),
     min_block_size(min_block_size),
     max_block_size(max_block_size),
+    bloom_bits_per_term_(bloom_bits_per_term),
     volatile_state_(volatile_state) {
   assert(this->pw);
   assert(min_block_size > 1);
@@ -1503,6 +1789,16 @@ void field_writer::write(
 
   for (; terms.next();) {
     auto postings = terms.postings(features);
+    const bool point = index_points_ && numeric_utils::is_exact(terms.value());
+
+    if (point) {
+      // collect documents of the exact value for the points index
+      point_docs_.clear();
+      postings = doc_iterator::make<detail::recording_doc_iterator>(
+        std::move(postings), point_docs_
+      );
+    }
+
     auto meta = pw->write(*postings);
 
     if (freq_exists) {
@@ -1518,6 +1814,14 @@ void field_writer::write(
       // push term to the top of the stack
       stack.emplace_back(term, std::move(meta), volatile_state_);
 
+      if (index_bloom_) {
+        bloom_terms_.push_back(detail::bloom_hash(term));
+      }
+
+      if (point) {
+        push_points(term, point_docs_);
+      }
+
       if (!min_term.first) {
         min_term.first = true;
         if (volatile_state_) {
@@ -1556,6 +1860,17 @@ void field_writer::begin_field(const iresearch::flags& field) {
   min_term.second.clear();
   term_count = 0;
 
+  // bloom filters are only written for the fields requesting them
+  index_bloom_ = bloom_bits_per_term_ && field.check<term_filter>();
+  bloom_terms_.clear();
+
+  // exact values of numeric fields are indexed as points
+  index_points_ = field.check<granularity_prefix>();
+  points_.clear();
+  point_block_.reset();
+  point_block_size_ = 0;
+  point_runs_ = 0;
+
   pw->begin_field(field);
 }
 
@@ -1578,6 +1893,116 @@ void field_writer::write_field_features(data_output& out, const flags& features)
   }
 }
 
+void field_writer::write_bloom_filter(data_output& out) {
+  if (!index_bloom_) {
+    out.write_vlong(0); // no filter
+    return;
+  }
+
+  assert(bloom_terms_.size() == term_count);
+
+  // number of hash functions minimizing false positive rate: ln(2)*m/n
+  const uint32_t hashes = std::max(
+    uint32_t(1), uint32_t(0.6931 * bloom_bits_per_term_ + 0.5)
+  );
+  const size_t size = (bloom_terms_.size() * bloom_bits_per_term_ + 7) / 8;
+  const uint64_t bits = 8 * uint64_t(size);
+
+  bloom_.assign(size, 0);
+
+  for (const auto hash : bloom_terms_) {
+    detail::bloom_visit(hash, bits, hashes, [this](uint64_t bit) {
+      bloom_[bit >> 3] |= byte_type(1 << (bit & 7));
+      return true;
+    });
+  }
+
+  out.write_vlong(size);
+  out.write_vint(hashes);
+  out.write_bytes(bloom_.c_str(), bloom_.size());
+}
+
+void field_writer::push_points(
+    const bytes_ref& value, const std::vector<doc_id_t>& docs) {
+  auto& out = point_block_.stream;
+
+  for (auto begin = docs.begin(), end = docs.end(); begin != end;) {
+    if (POINTS_PER_BLOCK == point_block_size_) {
+      flush_points_block();
+    }
+
+    size_t prefix = 0;
+
+    if (point_block_size_) {
+      // prefix shared with the previous value of the block
+      const auto& last = points_.back().max;
+      const auto size = std::min(last.size(), value.size());
+
+      for (; prefix < size && last[prefix] == value[prefix]; ++prefix) { }
+    } else {
+      points_.emplace_back();
+      points_.back().min = value;
+    }
+
+    // runs of a value spanning multiple blocks are split
+    const auto count = std::min(
+      size_t(std::distance(begin, end)),
+      size_t(POINTS_PER_BLOCK - point_block_size_)
+    );
+
+    out.write_vint(uint32_t(prefix));
+    out.write_vint(uint32_t(value.size() - prefix));
+    out.write_bytes(value.c_str() + prefix, value.size() - prefix);
+    out.write_vint(uint32_t(count));
+
+    doc_id_t prev = 0;
+
+    for (const auto stop = begin + count; begin != stop; ++begin) {
+      assert(*begin >= prev);
+      out.write_vlong(*begin - prev);
+      prev = *begin;
+    }
+
+    points_.back().max = value;
+    point_block_size_ += uint32_t(count);
+    ++point_runs_;
+  }
+}
+
+void field_writer::flush_points_block() {
+  assert(!points_.empty() && point_block_size_);
+
+  auto& block = points_.back();
+  block.offset = terms_out->file_pointer();
+  block.count = point_block_size_;
+
+  terms_out->write_vint(point_runs_);
+  point_block_.stream.flush();
+  point_block_.file >> *terms_out;
+  point_block_.reset();
+
+  point_block_size_ = 0;
+  point_runs_ = 0;
+}
+
+void field_writer::write_points(data_output& out) {
+  if (point_block_size_) {
+    flush_points_block();
+  }
+
+  out.write_vlong(points_.size()); // 0 - no points index
+
+  uint64_t offset = 0;
+
+  for (auto& block : points_) {
+    write_string<bytes_ref>(out, block.min);
+    write_string<bytes_ref>(out, block.max);
+    out.write_vlong(block.offset - offset);
+    out.write_vlong(block.count);
+    offset = block.offset;
+  }
+}
+
 void field_writer::end_field(
     const std::string& name,
     field_id norm,
@@ -1618,11 +2043,19 @@ void field_writer::end_field(
   if (features.check<frequency>()) {
     index_out->write_vlong(total_term_freq);
   }
+  write_bloom_filter(*index_out);
+  write_points(*index_out);
 
-  // write fst
-  output_buf isb(index_out.get()); // wrap stream to be OpenFST compliant
-  std::ostream os(&isb);
-  fst.Write(os, fst::FstWriteOptions());
+  // write fst prefixed with its size, allows to skip it while reading
+  {
+    output_buf isb(&fst_out_.stream); // wrap stream to be OpenFST compliant
+    std::ostream os(&isb);
+    fst.Write(os, fst::FstWriteOptions());
+  }
+  fst_out_.stream.flush();
+  index_out->write_vlong(fst_out_.stream.file_pointer());
+  fst_out_.file >> *index_out;
+  fst_out_.reset();
 
   stack.clear();
   ++fields_count;
@@ -1672,7 +2105,7 @@ bool field_reader::prepare(
 
   // check index header 
   index_input::ptr index_in;
-  detail::prepare_input(
+  const auto version = detail::prepare_input(
     str, index_in,
     irs::IOAdvice::SEQUENTIAL | irs::IOAdvice::READONCE, state,
     field_writer::TERMS_INDEX_EXT,
@@ -1686,7 +2119,7 @@ bool field_reader::prepare(
   }
 
   // check index checksum
-  format_utils::check_checksum<boost::crc_32_type>(*index_in);
+  format_utils::check_checksum(*index_in);
 
   // read total number of indexed fields
   size_t fields_count{ 0 };
@@ -1711,7 +2144,7 @@ bool field_reader::prepare(
     fields_.emplace_back();
     auto& field = fields_.back();
 
-    if (!field.prepare(input, feature_map, *this)) {
+    if (!field.prepare(input, feature_map, *this, version)) {
       fields_.pop_back(); // remove inconsistent field
       return false;
     }
@@ -1730,6 +2163,19 @@ bool field_reader::prepare(
     --fields_count;
   }
 
+  if (version >= field_writer::FORMAT_FST_SIZE && !fields_.empty()) {
+    // fsts are read on first access to the corresponding field
+    index_in_ = dir.open(str, irs::IOAdvice::RANDOM);
+
+    if (!index_in_) {
+      std::stringstream ss;
+
+      ss << "Failed to open file, path: " << str;
+
+      throw detailed_io_error(ss.str());
+    }
+  }
+
   // ensure that fields are sorted properly
   assert(std::is_sorted(
     fields_.begin(), fields_.end(),
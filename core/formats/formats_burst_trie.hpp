@@ -53,7 +53,9 @@
 
 #include "utils/noncopyable.hpp"
 
+#include <atomic>
 #include <list>
+#include <mutex>
 #include <type_traits>
 
 NS_ROOT
@@ -228,6 +230,20 @@ class entry : private util::noncopyable {
   EntryType type_; // entry type
 }; // entry
 
+///////////////////////////////////////////////////////////////////////////////
+/// @struct points_block
+/// @brief leaf of the field points index, i.e. up to
+///        'field_writer::POINTS_PER_BLOCK' exact values along with their
+///        documents ordered by value, blocks of a field are ordered by value
+///        too and form an implicit balanced tree (a 1-dimensional KD tree)
+///////////////////////////////////////////////////////////////////////////////
+struct points_block {
+  bstring min; // least value of the block
+  bstring max; // greatest value of the block
+  uint64_t offset{}; // offset of the block data in the terms file
+  uint64_t count{}; // number of points in the block
+}; // points_block
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @class term_reader
 ///////////////////////////////////////////////////////////////////////////////
@@ -241,10 +257,13 @@ class term_reader : public iresearch::term_reader,
   bool prepare(
     std::istream& in,
     const feature_map_t& features,
-    field_reader& owner
+    field_reader& owner,
+    int32_t version
   );
 
   virtual seek_term_iterator::ptr iterator() const override;
+  virtual bool may_contain(const bytes_ref& term) const override;
+  virtual bool intersect(points_visitor& visitor) const override;
   virtual const field_meta& meta() const override { return field_; }
   virtual size_t size() const override { return terms_count_; }
   virtual uint64_t docs_count() const override { return doc_count_; }
@@ -258,6 +277,12 @@ class term_reader : public iresearch::term_reader,
   typedef fst::VectorFst<byte_arc> fst_t;
   friend class term_iterator;
 
+  // returns term index of the field, loads it on first access
+  const fst_t& fst() const;
+
+  // returns bloom filter of the field, loads it on first access
+  const bstring& bloom() const;
+
   irs::attribute_view attrs_;
   bstring min_term_;
   bstring max_term_;
@@ -269,7 +294,14 @@ class term_reader : public iresearch::term_reader,
   uint64_t term_freq_;
   frequency freq_; // total term freq
   field_meta field_;
-  fst_t* fst_; // TODO: use compact fst here!!!
+  mutable bstring bloom_; // optional bloom filter over field terms
+  uint64_t bloom_offset_{}; // offset of not yet loaded 'bloom_' in the index file
+  uint64_t bloom_size_{}; // size of 'bloom_' in bytes, 0 - no filter
+  uint32_t bloom_hashes_{}; // number of hash functions used by 'bloom_'
+  mutable std::atomic<bool> bloom_loaded_{};
+  std::vector<points_block> points_; // optional points index
+  uint64_t fst_offset_{}; // offset of not yet loaded fst in the index file
+  mutable std::atomic<fst_t*> fst_{}; // TODO: use compact fst here!!!
   field_reader* owner_;
 }; // term_reader
 
@@ -281,9 +313,14 @@ NS_END // detail
 class field_writer final : public iresearch::field_writer {
  public:
   static const int32_t FORMAT_MIN = 0;
-  static const int32_t FORMAT_MAX = FORMAT_MIN;
+  static const int32_t FORMAT_BLOOM = FORMAT_MIN + 1; // per-field bloom filters
+  static const int32_t FORMAT_FST_SIZE = FORMAT_BLOOM + 1; // size prefixed fst
+  static const int32_t FORMAT_POINTS = FORMAT_FST_SIZE + 1; // points index
+  static const int32_t FORMAT_MAX = FORMAT_POINTS;
   static const uint32_t DEFAULT_MIN_BLOCK_SIZE = 25;
   static const uint32_t DEFAULT_MAX_BLOCK_SIZE = 48;
+  static const uint32_t DEFAULT_BLOOM_BITS_PER_TERM = 10; // ~1% false positives
+  static const uint32_t POINTS_PER_BLOCK = 512; // max points in a points leaf
 
   static const string_ref FORMAT_TERMS;
   static const string_ref TERMS_EXT;
@@ -293,7 +330,8 @@ class field_writer final : public iresearch::field_writer {
   field_writer(iresearch::postings_writer::ptr&& pw,
                bool volatile_state,
                uint32_t min_block_size = DEFAULT_MIN_BLOCK_SIZE,
-               uint32_t max_block_size = DEFAULT_MAX_BLOCK_SIZE);
+               uint32_t max_block_size = DEFAULT_MAX_BLOCK_SIZE,
+               uint32_t bloom_bits_per_term = DEFAULT_BLOOM_BITS_PER_TERM); // 0 - no bloom filters, otherwise only for fields with 'term_filter' feature
 
   virtual void prepare( const iresearch::flush_state& state ) override;
   virtual void end() override;
@@ -311,6 +349,10 @@ class field_writer final : public iresearch::field_writer {
 
   void write_segment_features(data_output& out, const flags& features);
   void write_field_features(data_output& out, const flags& features) const;
+  void write_bloom_filter(data_output& out);
+  void write_points(data_output& out);
+  void push_points(const bytes_ref& value, const std::vector<doc_id_t>& docs);
+  void flush_points_block();
 
   void begin_field(const iresearch::flags& field);
   void end_field(
@@ -341,6 +383,7 @@ class field_writer final : public iresearch::field_writer {
   std::unordered_map<const attribute::type_id*, size_t> feature_map_;
   irs::memory_output suffix; /* term suffix column */
   irs::memory_output stats; /* term stats column */
+  irs::memory_output fst_out_; // buffer for serialized fst of a field
   irs::index_output::ptr terms_out; /* output stream for terms */
   irs::index_output::ptr index_out; /* output stream for indexes*/
   irs::postings_writer::ptr pw; /* postings writer */
@@ -354,6 +397,16 @@ class field_writer final : public iresearch::field_writer {
   size_t fields_count{};
   uint32_t min_block_size;
   uint32_t max_block_size;
+  uint32_t bloom_bits_per_term_; // 0 - bloom filters are not written
+  bool index_bloom_{}; // current field has a bloom filter
+  std::vector<uint64_t> bloom_terms_; // hashes of the current field terms
+  bstring bloom_; // bloom filter buffer
+  bool index_points_{}; // current field has a points index
+  std::vector<detail::points_block> points_; // points blocks of the current field
+  std::vector<doc_id_t> point_docs_; // documents of the current exact value
+  irs::memory_output point_block_; // buffer for the current points block
+  uint32_t point_block_size_{}; // number of points in 'point_block_'
+  uint32_t point_runs_{}; // number of distinct values in 'point_block_'
   const bool volatile_state_;
 }; // field_writer
 
@@ -376,12 +429,15 @@ class field_reader final : public iresearch::field_reader {
 
  private:
   friend class detail::term_iterator;
+  friend class detail::term_reader;
 
   std::vector<detail::term_reader> fields_;
   std::unordered_map<hashed_string_ref, term_reader*> name_to_field_;
   std::vector<const detail::term_reader*> fields_mask_;
   iresearch::postings_reader::ptr pr_;
   iresearch::index_input::ptr terms_in_;
+  iresearch::index_input::ptr index_in_; // source of lazily loaded fsts
+  std::mutex index_in_mutex_; // guards 'index_in_'
 }; // field_reader
 
 NS_END // burst_trie
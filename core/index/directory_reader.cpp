@@ -186,6 +186,15 @@ class directory_reader_impl :
     const composite_reader::ptr& cached = nullptr
   );
 
+  // open a new reader over the segments of the specified meta
+  // if meta_file_ref == nullptr then 'meta' isn't committed
+  static composite_reader::ptr open(
+    const directory& dir,
+    index_meta&& meta,
+    index_file_refs::ref_t&& meta_file_ref,
+    const directory_reader::segment_open_f& open_segment
+  );
+
  private:
   typedef std::unordered_set<index_file_refs::ref_t> segment_file_refs_t;
   typedef std::vector<segment_file_refs_t> reader_file_refs_t;
@@ -229,6 +238,15 @@ directory_reader& directory_reader::operator=(
   return directory_reader_impl::open(dir, codec.get());
 }
 
+/*static*/ directory_reader directory_reader::open(
+    const directory& dir,
+    index_meta&& meta,
+    const segment_open_f& open_segment) {
+  return directory_reader_impl::open(
+    dir, std::move(meta), index_file_refs::ref_t(), open_segment
+  );
+}
+
 directory_reader directory_reader::reopen(
     format::ptr codec /*= nullptr*/) const {
   // make a copy
@@ -294,6 +312,29 @@ directory_reader_impl::directory_reader_impl(
     }
   }
 
+  auto open_segment = [&dir, &reuse_candidates, cached_impl, INVALID_CANDIDATE](
+      const segment_meta& segment)->segment_reader {
+    auto itr = reuse_candidates.find(segment.name);
+
+    if (itr != reuse_candidates.end()
+        && itr->second != INVALID_CANDIDATE
+        && segment == cached_impl->meta().segment(itr->second).meta) {
+      auto reader = (*cached_impl)[itr->second].reopen(segment);
+      reuse_candidates.erase(itr);
+      return reader;
+    }
+
+    return segment_reader::open(dir, segment);
+  };
+
+  return open(dir, std::move(meta), std::move(meta_file_ref), open_segment);
+}
+
+/*static*/ composite_reader::ptr directory_reader_impl::open(
+    const directory& dir,
+    index_meta&& meta,
+    index_file_refs::ref_t&& meta_file_ref,
+    const directory_reader::segment_open_f& open_segment) {
   ctxs_t ctxs(meta.size());
   uint64_t docs_max = 0; // overall number of documents (with deleted)
   uint64_t docs_count = 0; // number of live documents
@@ -308,16 +349,8 @@ directory_reader_impl::directory_reader_impl(
     auto& ctx = ctxs[i];
     auto& segment = meta.segment(i).meta;
     auto& segment_file_refs = file_refs[i];
-    auto itr = reuse_candidates.find(segment.name);
 
-    if (itr != reuse_candidates.end()
-        && itr->second != INVALID_CANDIDATE
-        && segment == cached_impl->meta().segment(itr->second).meta) {
-      ctx.reader = (*cached_impl)[itr->second].reopen(segment);
-      reuse_candidates.erase(itr);
-    } else {
-      ctx.reader = segment_reader::open(dir, segment);
-    }
+    ctx.reader = open_segment(segment);
 
     if (!ctx.reader) {
       throw index_error();
@@ -332,7 +365,11 @@ directory_reader_impl::directory_reader_impl(
   }
 
   directory_utils::reference(const_cast<directory&>(dir), meta, visitor, true);
-  tmp_file_refs.emplace(meta_file_ref);
+
+  if (meta_file_ref) {
+    tmp_file_refs.emplace(std::move(meta_file_ref));
+  }
+
   file_refs.back().swap(tmp_file_refs); // use last position for storing index_meta refs
 
   PTR_NAMED(
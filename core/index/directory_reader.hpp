@@ -26,6 +26,7 @@
 
 #include "shared.hpp"
 #include "index_reader.hpp"
+#include "segment_reader.hpp"
 #include "utils/object_pool.hpp"
 
 NS_ROOT
@@ -40,6 +41,7 @@ class IRESEARCH_API directory_reader final
   typedef atomic_base<std::shared_ptr<composite_reader>> atomic_utils;
   typedef directory_reader element_type; // type same as self
   typedef directory_reader ptr; // pointer to self
+  typedef std::function<segment_reader(const segment_meta&)> segment_open_f;
 
   directory_reader() = default; // allow creation of an uninitialized ptr
   directory_reader(const directory_reader& other) NOEXCEPT;
@@ -93,6 +95,18 @@ class IRESEARCH_API directory_reader final
     format::ptr codec = nullptr
   );
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief create an index reader over the segments of the specified 'meta'
+  ///        which is not required to be committed (e.g. near-real-time reader)
+  /// @param open_segment provides readers for the segments of 'meta'
+  /// @note reopen() of the returned reader opens the latest committed state
+  ////////////////////////////////////////////////////////////////////////////////
+  static directory_reader open(
+    const directory& dir,
+    index_meta&& meta,
+    const segment_open_f& open_segment
+  );
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief open a new instance based on the latest file for the specified codec
   ///        this call will atempt to reuse segments from the existing reader
@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_DOCUMENT_MASK_H
+#define IRESEARCH_DOCUMENT_MASK_H
+
+#include "shared.hpp"
+#include "utils/bitset.hpp"
+#include "utils/type_limits.hpp"
+
+#include <iterator>
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class document_mask
+/// @brief a set of excluded (e.g. removed) document ids stored as a bitmap,
+///        allows to skip a run of excluded documents using word operations
+////////////////////////////////////////////////////////////////////////////////
+class document_mask : util::noncopyable {
+ public:
+  typedef bitset::word_t word_t;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @class const_iterator
+  /// @brief iterates over the excluded documents in ascending order
+  //////////////////////////////////////////////////////////////////////////////
+  class const_iterator
+    : public std::iterator<std::forward_iterator_tag, const doc_id_t> {
+   public:
+    const_iterator(const word_t* begin, const word_t* end) NOEXCEPT
+      : begin_(begin), it_(begin), end_(end) {
+      for (; it_ != end_ && !*it_; ++it_) { }
+      word_ = it_ == end_ ? 0 : *it_;
+      refresh();
+    }
+
+    const doc_id_t& operator*() const NOEXCEPT { return doc_; }
+
+    const_iterator& operator++() NOEXCEPT {
+      word_ &= word_ - 1; // unset the least significant bit
+
+      while (!word_ && ++it_ != end_) {
+        word_ = *it_;
+      }
+
+      refresh();
+      return *this;
+    }
+
+    const_iterator operator++(int) NOEXCEPT {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const const_iterator& rhs) const NOEXCEPT {
+      assert(end_ == rhs.end_);
+      return it_ == rhs.it_ && word_ == rhs.word_;
+    }
+
+    bool operator!=(const const_iterator& rhs) const NOEXCEPT {
+      return !(*this == rhs);
+    }
+
+   private:
+    void refresh() NOEXCEPT {
+      if (word_) {
+        doc_ = bitset::bit_offset(std::distance(begin_, it_))
+             + math::math_traits<word_t>::ctz(word_);
+      }
+    }
+
+    const word_t* begin_;
+    const word_t* it_;
+    const word_t* end_;
+    word_t word_;
+    doc_id_t doc_{ type_limits<type_t::doc_id_t>::eof() };
+  }; // const_iterator
+
+  document_mask() = default;
+
+  document_mask(document_mask&& rhs) NOEXCEPT
+    : set_(std::move(rhs.set_)), count_(rhs.count_) {
+    rhs.count_ = 0;
+  }
+
+  document_mask& operator=(document_mask&& rhs) NOEXCEPT {
+    if (this != &rhs) {
+      set_ = std::move(rhs.set_);
+      count_ = rhs.count_;
+      rhs.count_ = 0;
+    }
+
+    return *this;
+  }
+
+  operator const bitset&() const NOEXCEPT { return set_; }
+
+  const_iterator begin() const NOEXCEPT {
+    return const_iterator(set_.begin(), set_.end());
+  }
+
+  const_iterator end() const NOEXCEPT {
+    return const_iterator(set_.end(), set_.end());
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes all documents from the mask, keeps allocated memory
+  //////////////////////////////////////////////////////////////////////////////
+  void clear() NOEXCEPT {
+    if (count_) {
+      set_.clear();
+      count_ = 0;
+    }
+  }
+
+  bool contains(doc_id_t doc) const NOEXCEPT {
+    return doc < set_.size() && set_.test(doc);
+  }
+
+  bool empty() const NOEXCEPT { return !count_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief adds a specified document to the mask
+  /// @returns true if the document wasn't masked before
+  //////////////////////////////////////////////////////////////////////////////
+  bool insert(doc_id_t doc) {
+    reserve(doc);
+
+    if (set_.test(doc)) {
+      return false;
+    }
+
+    set_.set(doc);
+    ++count_;
+    return true;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief ensures that masking any document up to and including 'doc'
+  ///        won't allocate memory
+  //////////////////////////////////////////////////////////////////////////////
+  void reserve(doc_id_t doc) {
+    assert(!type_limits<type_t::doc_id_t>::eof(doc));
+
+    if (doc < set_.size()) {
+      return; // nothing to do
+    }
+
+    // grow geometrically since documents are usually masked in ascending order
+    bitset set(std::max(
+      size_t(doc) + 1,
+      std::max(2*set_.size(), size_t(bits_required<word_t>()))
+    ));
+
+    if (set_.words()) {
+      set.memset(set_.begin(), set_.words()*sizeof(word_t)); // copy original
+    }
+
+    set_ = std::move(set);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns number of masked documents
+  //////////////////////////////////////////////////////////////////////////////
+  size_t size() const NOEXCEPT { return count_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns the first document not less than 'doc' which isn't masked
+  //////////////////////////////////////////////////////////////////////////////
+  doc_id_t skip(doc_id_t doc) const NOEXCEPT {
+    if (doc >= set_.size()) {
+      return doc;
+    }
+
+    const auto* begin = set_.begin();
+    const auto* end = set_.end();
+    auto* it = begin + bitset::word(doc);
+
+    // ignore bits preceding 'doc' within its word
+    auto word = ~*it & (~word_t(0) << bitset::bit(doc));
+
+    while (!word) {
+      if (++it == end) {
+        return bitset::bit_offset(std::distance(begin, it));
+      }
+
+      word = ~*it;
+    }
+
+    return bitset::bit_offset(std::distance(begin, it))
+         + math::math_traits<word_t>::ctz(word);
+  }
+
+ private:
+  bitset set_;
+  size_t count_{}; // number of masked documents
+}; // document_mask
+
+NS_END // ROOT
+
+#endif // IRESEARCH_DOCUMENT_MASK_H
@@ -690,6 +690,18 @@ field_data& fields_data::get(const hashed_string_ref& name) {
   ).first->second;
 }
 
+size_t fields_data::memory() const NOEXCEPT {
+  // pools are reused between segments, so account only the occupied part
+  size_t size = byte_writer_.pool_offset()*sizeof(byte_block_pool::value_type)
+    + int_writer_.pool_offset()*sizeof(int_block_pool::value_type);
+
+  for (auto& entry : fields_) {
+    size += sizeof(fields_map::value_type) + entry.second.terms_.memory();
+  }
+
+  return size;
+}
+
 void fields_data::flush(field_writer& fw, flush_state& state) {
   REGISTER_TIMER_DETAILED();
   /* set the segment meta */
@@ -135,6 +135,12 @@ class IRESEARCH_API fields_data: util::noncopyable {
     return *this;
   }
   const flags& features() { return features_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns approximate number of bytes occupied by the buffered data
+  //////////////////////////////////////////////////////////////////////////////
+  size_t memory() const NOEXCEPT;
+
   void flush(field_writer& fw, flush_state& state);
   void reset();
 
@@ -57,7 +57,8 @@ segment_meta::segment_meta(segment_meta&& rhs) NOEXCEPT
     docs_count(rhs.docs_count),
     codec(rhs.codec),
     column_store(rhs.column_store),
-    version(rhs.version) {
+    version(rhs.version),
+    sort(std::move(rhs.sort)) {
   rhs.docs_count = 0;
 }
 
@@ -71,6 +72,7 @@ segment_meta& segment_meta::operator=(segment_meta&& rhs) NOEXCEPT {
     rhs.codec = nullptr;
     column_store = rhs.column_store;
     version = rhs.version;
+    sort = std::move(rhs.sort);
   }
 
   return *this;
@@ -91,6 +93,7 @@ bool segment_meta::operator!=(const segment_meta& other) const NOEXCEPT {
     || codec != other.codec
     || column_store != other.column_store
     || files != other.files
+    || sort != other.sort
   ;
 }
 
@@ -78,6 +78,7 @@ struct IRESEARCH_API segment_meta {
   format_ptr codec;
   bool column_store{};
   uint64_t version{};
+  std::string sort; // name of the column documents are ordered by, empty == unordered
 };
 
 /* -------------------------------------------------------------------
@@ -111,6 +111,11 @@ struct IRESEARCH_API sub_reader : index_reader {
   virtual const columnstore_reader::column_reader* column_reader(field_id field) const = 0;
 
   const columnstore_reader::column_reader* column_reader(const string_ref& field) const;
+
+  // returns name of the column documents are ordered by, empty if unordered
+  virtual string_ref sort() const NOEXCEPT {
+    return string_ref::nil;
+  }
 }; // sub_reader
 
 NS_END
@@ -25,12 +25,15 @@
 #include "file_names.hpp"
 #include "merge_writer.hpp"
 #include "formats/format_utils.hpp"
+#include "search/term_filter.hpp"
 #include "utils/directory_utils.hpp"
 #include "utils/index_utils.hpp"
 #include "utils/timer_utils.hpp"
 #include "utils/type_limits.hpp"
 #include "index_writer.hpp"
 
+#include <algorithm>
+#include <future>
 #include <list>
 
 NS_LOCAL
@@ -80,6 +83,62 @@ std::string write_segment_meta(
   return writer->filename(meta);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluates 'fn(i)' for every 'i' in [0, count) on the 'pool', the
+///        first evaluation is done by the calling thread, waits for all of
+///        them to complete and rethrows the first exception thrown if any
+/// @returns false if any of the evaluations returned false
+////////////////////////////////////////////////////////////////////////////////
+template<typename Func>
+bool parallel_for(
+    iresearch::async_utils::thread_pool& pool,
+    size_t count,
+    const Func& fn) {
+  std::vector<std::future<bool>> results;
+
+  results.reserve(count);
+
+  for (size_t i = 1; i < count; ++i) {
+    auto task = std::make_shared<std::packaged_task<bool()>>(
+      [&fn, i]()->bool { return fn(i); }
+    );
+
+    results.emplace_back(task->get_future());
+
+    if (!pool.run([task]()->void { (*task)(); })) {
+      (*task)(); // pool is not active, evaluate inline
+    }
+  }
+
+  std::exception_ptr error;
+  bool success = true;
+
+  if (count) {
+    try {
+      success = fn(0);
+    } catch (...) {
+      error = std::current_exception();
+    }
+  }
+
+  // 'fn' must outlive all of the evaluations, so wait for every one of them
+  for (auto& result: results) {
+    try {
+      success &= result.get();
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  return success;
+}
+
 NS_END // NS_LOCAL
 
 NS_ROOT
@@ -99,9 +158,12 @@ void index_writer::flush_context::reset() {
   consolidation_policies_.clear();
   generation_.store(0);
   dir_->clear_refs();
+  flush_error_ = nullptr;
+  flushed_segments_.clear();
   modification_queries_.clear();
   pending_segments_.clear();
   segment_mask_.clear();
+  consolidation_tasks_.clear(); // after 'segment_mask_' which refs at their strings
   writers_pool_.visit([this](segment_writer& writer)->bool {
     writer.reset();
     return true;
@@ -113,12 +175,19 @@ index_writer::index_writer(
     directory& dir,
     format::ptr codec,
     index_meta&& meta,
-    committed_state_t&& committed_state
+    committed_state_t&& committed_state,
+    std::string&& sort
 ) NOEXCEPT:
     codec_(codec),
     committed_state_(std::move(committed_state)),
+    consolidation_count_(0),
+    consolidation_pool_(1, 1), // a single background merge at a time by default
     dir_(dir),
+    flush_pool_(THREAD_COUNT - 1, THREAD_COUNT - 1), // +1 committing thread
+    segment_memory_max_(0), // unlimited
+    sort_(std::move(sort)),
     flush_context_pool_(2), // 2 because just swap them due to common commit lock
+    merge_threads_(0), // merge sequentially by default
     meta_(std::move(meta)),
     writer_(codec->get_index_meta_writer()),
     write_lock_(std::move(lock)) {
@@ -166,10 +235,15 @@ void index_writer::clear() {
   pending_state_.ctx = std::move(ctx); // retain flush context reference
   pending_state_.meta = std::move(pending_meta); // retain meta pending flush
   finish();
+  unsynced_files_.clear(); // segments flushed by reader() are discarded
   meta_.segments_.clear(); // noexcept op (clear after finish(), to match reset of pending_state_ inside finish(), allows recovery on clear() failure)
 }
 
-index_writer::ptr index_writer::make(directory& dir, format::ptr codec, OPEN_MODE mode) {
+index_writer::ptr index_writer::make(
+    directory& dir,
+    format::ptr codec,
+    OPEN_MODE mode,
+    const string_ref& sort /*= string_ref::nil*/) {
   // lock the directory
   auto lock = dir.make_lock(WRITE_LOCK_NAME);
 
@@ -228,7 +302,8 @@ index_writer::ptr index_writer::make(directory& dir, format::ptr codec, OPEN_MOD
     std::move(lock), 
     dir, codec,
     std::move(meta),
-    std::move(comitted_state)
+    std::move(comitted_state),
+    std::string(sort.c_str(), sort.size())
   );
 
   directory_utils::remove_all_unreferenced(dir); // remove non-index files from directory
@@ -241,9 +316,15 @@ index_writer::~index_writer() {
 }
 
 void index_writer::close() {
+  flush_pool_.stop(); // wait for segments being flushed in background
+  consolidation_pool_.stop(true); // wait for running background merges, skip pending ones
+  merge_pool_.stop(); // merges of a stopped pool run inline
+
   {
     SCOPED_LOCK(commit_lock_); // cached_segment_readers_ read/modified during flush()
     cached_segment_readers_.clear();
+    consolidation_count_ = 0; // skipped background merges will never finish
+    consolidation_cond_.notify_all();
   }
   write_lock_.reset();
 }
@@ -284,6 +365,115 @@ segment_reader index_writer::get_segment_reader(
   return it->second;
 }
 
+/*static*/ void index_writer::resolve_keyed_modifications(
+    const modification_requests_t& modification_queries,
+    const sub_reader& segment,
+    keyed_matches_t& matches) {
+  REGISTER_TIMER_DETAILED();
+  std::vector<std::pair<const by_term*, size_t>> keys;
+
+  matches.clear();
+
+  for (size_t i = 0, count = modification_queries.size(); i < count; ++i) {
+    auto& mod = modification_queries[i];
+
+    if (mod.keyed && mod.filter) {
+      keys.emplace_back(static_cast<const by_term*>(mod.filter.get()), i);
+    }
+  }
+
+  if (keys.empty()) {
+    return; // nothing to resolve
+  }
+
+  // order keys by field and term, so every term dictionary is traversed
+  // once in ascending order, equal keys are resolved in order of requests
+  std::sort(
+    keys.begin(), keys.end(),
+    [](const std::pair<const by_term*, size_t>& lhs,
+       const std::pair<const by_term*, size_t>& rhs) {
+      if (lhs.first->field() != rhs.first->field()) {
+        return lhs.first->field() < rhs.first->field();
+      }
+
+      if (lhs.first->term() != rhs.first->term()) {
+        return lhs.first->term() < rhs.first->term();
+      }
+
+      return lhs.second < rhs.second;
+  });
+
+  const std::string* field = nullptr;
+  const term_reader* terms = nullptr;
+  seek_term_iterator::ptr it;
+
+  for (auto& key: keys) {
+    if (!field || *field != key.first->field()) {
+      field = &key.first->field();
+      terms = segment.field(*field);
+      it = nullptr; // instantiated on demand
+    }
+
+    const bytes_ref term = key.first->term();
+
+    // skip keys outside of the terms range or rejected by the field filter
+    if (!terms
+        || term < (terms->min)() || (terms->max)() < term
+        || !terms->may_contain(term)) {
+      continue;
+    }
+
+    if (!it) {
+      it = terms->iterator();
+    }
+
+    if (!it->seek(term)) {
+      continue; // no such key in the segment
+    }
+
+    for (auto docs = segment.mask(it->postings(flags::empty_instance())); docs->next();) {
+      matches.emplace_back(key.second, docs->value());
+    }
+  }
+
+  // requests must be applied in order they were issued
+  std::sort(matches.begin(), matches.end());
+}
+
+template<typename Visitor>
+/*static*/ void index_writer::visit_modified_records(
+    modification_requests_t& modification_queries,
+    const sub_reader& segment,
+    const Visitor& visitor) {
+  keyed_matches_t keyed_matches;
+
+  resolve_keyed_modifications(modification_queries, segment, keyed_matches);
+
+  auto keyed_match = keyed_matches.begin();
+
+  for (size_t i = 0, count = modification_queries.size(); i < count; ++i) {
+    auto& mod = modification_queries[i];
+
+    if (!mod.filter) {
+      continue; // skip invalid modification queries
+    }
+
+    if (mod.keyed) {
+      for (; keyed_match != keyed_matches.end() && keyed_match->first == i; ++keyed_match) {
+        visitor(mod, keyed_match->second);
+      }
+
+      continue;
+    }
+
+    auto prepared = mod.filter->prepare(segment);
+
+    for (auto docItr = prepared->execute(segment); docItr->next();) {
+      visitor(mod, docItr->value());
+    }
+  }
+}
+
 bool index_writer::add_document_mask_modified_records(
     modification_requests_t& modification_queries,
     document_mask& docs_mask,
@@ -300,35 +490,32 @@ bool index_writer::add_document_mask_modified_records(
     throw index_error(); // failed to open segment
   }
 
-  for (auto& mod : modification_queries) {
-    auto prepared = mod.filter->prepare(rdr);
-
-    for (auto docItr = prepared->execute(rdr); docItr->next();) {
-      auto doc = docItr->value();
-
-      // if indexed doc_id was not add()ed after the request for modification
-      // and doc_id not already masked then mark query as seen and segment as modified
-      if (mod.generation >= min_doc_id_generation &&
-          docs_mask.insert(doc).second) {
-        mod.seen = true;
-        modified = true;
-      }
+  auto visitor = [&docs_mask, &modified, min_doc_id_generation](
+      modification_context& mod, doc_id_t doc)->void {
+    // if indexed doc_id was not add()ed after the request for modification
+    // and doc_id not already masked then mark query as seen and segment as modified
+    if (mod.generation >= min_doc_id_generation &&
+        docs_mask.insert(doc)) {
+      mod.seen = true;
+      modified = true;
     }
-  }
+  };
+
+  visit_modified_records(modification_queries, rdr, visitor);
 
   return modified;
 }
 
 bool index_writer::add_document_mask_modified_records(
   modification_requests_t& modification_queries,
-  segment_writer& writer,
+  const segment_writer::update_contexts& doc_id_generation,
+  document_mask& docs_mask,
   const segment_meta& meta
 ) {
   if (modification_queries.empty()) {
     return false; // nothing new to flush
   }
 
-  auto& doc_id_generation = writer.docs_context();
   bool modified = false;
   auto rdr = get_segment_reader(meta);
 
@@ -336,48 +523,44 @@ bool index_writer::add_document_mask_modified_records(
     throw index_error(); // failed to open segment
   }
 
-  for (auto& mod : modification_queries) {
-    if (!mod.filter) {
-      continue; // skip invalid modification queries
-    }
-
-    auto prepared = mod.filter->prepare(rdr);
+  auto visitor = [&modification_queries, &doc_id_generation, &docs_mask, &modified](
+      modification_context& mod, doc_id_t doc_id)->void {
+    const auto doc = doc_id - (type_limits<type_t::doc_id_t>::min)();
 
-    for (auto docItr = prepared->execute(rdr); docItr->next();) {
-      const auto doc = docItr->value() - (type_limits<type_t::doc_id_t>::min)();
-
-      if (doc >= doc_id_generation.size()) {
-        continue;
-      }
+    if (doc >= doc_id_generation.size()) {
+      return;
+    }
 
-      const auto& doc_ctx = doc_id_generation[doc];
+    const auto& doc_ctx = doc_id_generation[doc];
 
-      // if indexed doc_id was add()ed after the request for modification then it should be skipped
-      if (mod.generation < doc_ctx.generation) {
-        continue; // the current modification query does not match any records
-      }
+    // if indexed doc_id was add()ed after the request for modification then it should be skipped
+    if (mod.generation < doc_ctx.generation) {
+      return; // the current modification query does not match any records
+    }
 
-      // if not already masked
-      if (writer.remove(doc)) {
-        // if not an update modification (i.e. a remove modification) or
-        // if non-update-value record or update-value record whose query was seen
-        // for every update request a replacement 'update-value' is optimistically inserted
-        if (!mod.update ||
-            doc_ctx.update_id == NON_UPDATE_RECORD ||
-            modification_queries[doc_ctx.update_id].seen) {
-          mod.seen = true;
-          modified = true;
-        }
+    // if not already masked
+    if (docs_mask.insert(doc_id)) {
+      // if not an update modification (i.e. a remove modification) or
+      // if non-update-value record or update-value record whose query was seen
+      // for every update request a replacement 'update-value' is optimistically inserted
+      if (!mod.update ||
+          doc_ctx.update_id == NON_UPDATE_RECORD ||
+          modification_queries[doc_ctx.update_id].seen) {
+        mod.seen = true;
+        modified = true;
       }
     }
-  }
+  };
+
+  visit_modified_records(modification_queries, rdr, visitor);
 
   return modified;
 }
 
 /* static */ bool index_writer::add_document_mask_unused_updates(
     modification_requests_t& modification_queries,
-    segment_writer& writer,
+    const segment_writer::update_contexts& doc_id_generation,
+    document_mask& docs_mask,
     const segment_meta& meta
 ) {
   UNUSED(meta);
@@ -386,7 +569,6 @@ bool index_writer::add_document_mask_modified_records(
     return false; // nothing new to add
   }
 
-  auto& doc_id_generation = writer.docs_context();
   bool modified = false;
 
   // the implementation generates doc_ids sequentially
@@ -402,7 +584,7 @@ bool index_writer::add_document_mask_modified_records(
     // if it's an update record placeholder who's query did not match any records
     if (doc_ctx.update_id != NON_UPDATE_RECORD
         && !modification_queries[doc_ctx.update_id].seen) {
-      modified |= writer.remove(doc);
+      modified |= docs_mask.insert((type_limits<type_t::doc_id_t>::min)() + doc);
     }
 
     ++doc;
@@ -425,6 +607,10 @@ bool index_writer::add_segment_mask_consolidated_records(
 
   // find merge candidates
   for (auto& seg: segments) {
+    if (consolidating_segments_.end() != consolidating_segments_.find(seg.meta.name)) {
+      continue; // segment is being merged in background
+    }
+
     if (!acceptor(seg.meta)) {
       merge_candindate_default = &seg; // pick the last non-merged segment as default
       continue; // fill min threshold not reached
@@ -465,12 +651,16 @@ bool index_writer::add_segment_mask_consolidated_records(
   segment.meta.codec = codec_;
   segment.meta.name = file_name(meta_.increment()); // increment active meta, not fn arg
 
-  merge_writer merge_writer(dir, segment.meta.name);
+  merge_writer merge_writer(dir, segment.meta.name, merge_pool());
 
   for (auto& merge_candidate: merge_candidates) {
     merge_writer.add(merge_candidate);
   }
 
+  if (!sort_.empty()) {
+    merge_writer.sort(sort_);
+  }
+
   if (!merge_writer.flush(segment.filename, segment.meta)) {
     return false; // import failure (no files created, nothing to clean up)
   }
@@ -562,15 +752,210 @@ void index_writer::consolidate(
   ctx->consolidation_policies_.emplace_back(std::move(policy));
 }
 
+bool index_writer::consolidate_async(const consolidation_policy_t& policy) {
+  REGISTER_TIMER_DETAILED();
+  auto task = std::make_shared<consolidation_task>();
+  std::unordered_map<string_ref, const segment_meta*> segment_candidates;
+  SCOPED_LOCK(commit_lock_); // ensure meta_ segments are not modified by concurrent consolidate()/commit()
+
+  if (!write_lock_) {
+    return false; // writer is closed
+  }
+
+  task->meta = committed_state_.first;
+  task->refs = committed_state_.second; // committed files must outlive the merge
+
+  {
+    auto ctx = get_flush_context(); // can read ctx->segment_mask_ without lock since have commit_lock_
+
+    for (auto& seg: meta_) {
+      if (ctx->segment_mask_.end() == ctx->segment_mask_.find(seg.meta.name)) {
+        segment_candidates.emplace(seg.meta.name, &(seg.meta));
+      }
+    }
+  }
+
+  auto acceptor = policy(dir_, *(task->meta));
+
+  // consider only comitted segments that are still unmodified in current meta
+  for (auto& seg: *(task->meta)) {
+    auto itr = segment_candidates.find(seg.meta.name);
+
+    if (segment_candidates.end() == itr
+        || seg.meta.version != itr->second->version
+        || consolidating_segments_.end() != consolidating_segments_.find(seg.meta.name)
+        || !acceptor(seg.meta)) {
+      continue;
+    }
+
+    auto reader = get_segment_reader(seg.meta);
+
+    if (!reader) {
+      continue; // skip empty readers
+    }
+
+    task->candidates.emplace_back(seg.meta, std::move(reader));
+  }
+
+  if (task->candidates.empty()
+      || (task->candidates.size() < 2
+          && task->candidates[0].reader.docs_count() == task->candidates[0].reader.live_docs_count())) {
+    return false; // no reason to consolidate a segment without any masked documents
+  }
+
+  task->dir = memory::make_unique<ref_tracking_directory>(dir_);
+  task->segment.meta.codec = codec_;
+  task->segment.meta.name = file_name(meta_.increment()); // increment active meta
+
+  for (auto& candidate: task->candidates) {
+    consolidating_segments_.emplace(candidate.meta->name);
+  }
+
+  ++consolidation_count_;
+
+  if (!consolidation_pool_.run([this, task]()->void { consolidate(task); })) {
+    for (auto& candidate: task->candidates) {
+      consolidating_segments_.erase(candidate.meta->name);
+    }
+
+    --consolidation_count_;
+
+    return false; // writer is being closed
+  }
+
+  return true;
+}
+
+void index_writer::consolidation_threads(size_t count) {
+  consolidation_pool_.max_threads(count);
+  consolidation_pool_.max_idle(count);
+}
+
+void index_writer::merge_threads(size_t count) {
+  // the pool is never shrunk to 0 threads, since merges already using it
+  // wait for their tasks to finish
+  if (count) {
+    merge_pool_.max_threads(count);
+  }
+
+  merge_pool_.max_idle(count);
+  merge_threads_.store(count);
+}
+
+void index_writer::wait_for_consolidation() {
+  std::unique_lock<std::mutex> lock(commit_lock_);
+
+  while (consolidation_count_) {
+    consolidation_cond_.wait(lock);
+  }
+}
+
+void index_writer::consolidate(
+    const std::shared_ptr<consolidation_task>& task_ref) {
+  REGISTER_TIMER_DETAILED();
+  auto& task = *task_ref;
+  auto& segment = task.segment;
+  std::unique_ptr<merge_writer> merger; // holds doc_id mapping of the merge
+  bool merged = false;
+
+  // merge segments without holding any locks
+  try {
+    merger = memory::make_unique<merge_writer>(
+      *(task.dir), segment.meta.name, merge_pool()
+    );
+
+    for (auto& candidate: task.candidates) {
+      merger->add(candidate.reader);
+    }
+
+    if (!sort_.empty()) {
+      merger->sort(sort_);
+    }
+
+    merged = merger->flush(segment.filename, segment.meta);
+  } catch (...) {
+    IR_FRMT_ERROR("Caught exception while merging segment '%s'", segment.meta.name.c_str());
+    IR_EXCEPTION();
+  }
+
+  SCOPED_LOCK(commit_lock_); // ensure meta_ segments are not modified by concurrent consolidate()/commit()
+
+  auto finish = make_finally([this, &task]()->void {
+    for (auto& candidate: task.candidates) {
+      consolidating_segments_.erase(candidate.meta->name);
+    }
+
+    --consolidation_count_;
+    consolidation_cond_.notify_all();
+  });
+
+  if (!merged || !segment.meta.docs_count || !write_lock_) {
+    return; // merge failure or writer is closed
+  }
+
+  // re-apply removals that happened while the merge was running
+  document_mask docs_mask;
+  flush_context::segment_mask_t segment_mask;
+
+  for (size_t i = 0, count = task.candidates.size(); i < count; ++i) {
+    auto& candidate = task.candidates[i];
+    auto& name = candidate.meta->name;
+    auto itr = std::find_if(
+      meta_.begin(), meta_.end(),
+      [&name](const index_meta::index_segment_t& seg) { return seg.meta.name == name; }
+    );
+    document_mask current_mask;
+    const bool removed = meta_.end() == itr; // all documents have been removed
+
+    if (!removed) {
+      segment_mask.emplace(name);
+
+      if (itr->meta.version != candidate.meta->version) {
+        index_utils::read_document_mask(current_mask, dir_, itr->meta);
+      }
+    }
+
+    for (auto docs = candidate.reader.docs_iterator(); docs->next();) {
+      if (removed || current_mask.contains(docs->value())) {
+        docs_mask.insert(merger->doc_id(i, docs->value()));
+      }
+    }
+  }
+
+  if (segment_mask.empty()) {
+    return; // all original segments have gone (e.g. clear()), nothing to replace
+  }
+
+  if (!docs_mask.empty()) {
+    write_document_mask(*(task.dir), segment.meta, docs_mask);
+    segment.filename = write_segment_meta(*(task.dir), segment.meta); // write with new mask
+  }
+
+  auto ctx = get_flush_context();
+  SCOPED_LOCK(ctx->mutex_); // lock due to context modification
+
+  // hold references to the committed meta (segment_mask_ refs at its strings)
+  // and to the files of the merged segment until the end of the next commit
+  ctx->consolidation_tasks_.emplace_back(task_ref);
+  ctx->segment_mask_.insert(segment_mask.begin(), segment_mask.end());
+
+  // 0 == merged segments existed before start of tx (all removes apply)
+  ctx->pending_segments_.emplace_back(std::move(segment), 0);
+}
+
 bool index_writer::import(const index_reader& reader) {
   auto ctx = get_flush_context();
   auto merge_segment_name = file_name(meta_.increment());
-  merge_writer merge_writer(*(ctx->dir_), merge_segment_name);
+  merge_writer merge_writer(*(ctx->dir_), merge_segment_name, merge_pool());
 
   for (auto itr = reader.begin(), end = reader.end(); itr != end; ++itr) {
     merge_writer.add(*itr);
   }
 
+  if (!sort_.empty()) {
+    merge_writer.sort(sort_);
+  }
+
   index_meta::index_segment_t segment(segment_meta(merge_segment_name, codec_));
 
   if (!merge_writer.flush(segment.filename, segment.meta)) {
@@ -644,6 +1029,134 @@ index_writer::flush_context::segment_writers_t::ptr index_writer::get_segment_co
   return writer;
 }
 
+void index_writer::flush_if_exceeds(
+    flush_context::ptr& ctx,
+    flush_context::segment_writers_t::ptr& writer) {
+  const auto memory_max = segment_memory_max_.load();
+
+  if (!memory_max || writer->memory() < memory_max) {
+    return; // keep buffering
+  }
+
+  // the task retains a read-lock on 'ctx' (via 'ctx' ptr), so commit waits
+  // for the flush and the segment gets into the transaction of its documents
+  struct flush_task {
+    flush_task(
+        flush_context::ptr&& ctx,
+        flush_context::segment_writers_t::ptr&& writer) NOEXCEPT
+      : ctx(std::move(ctx)), writer(std::move(writer)) {
+    }
+
+    flush_context::ptr ctx;
+    flush_context::segment_writers_t::ptr writer;
+  };
+
+  auto task = std::make_shared<flush_task>(std::move(ctx), std::move(writer));
+
+  auto flush = [this, task]()->void {
+    auto& ctx = *(task->ctx);
+
+    try {
+      flush_segment(ctx, *(task->writer));
+    } catch (...) {
+      SCOPED_LOCK(ctx.mutex_); // lock due to context modification
+
+      if (!ctx.flush_error_) {
+        ctx.flush_error_ = std::current_exception(); // rethrown upon commit
+      }
+    }
+  };
+
+  if (!flush_pool_.run(flush)) {
+    flush(); // pool is not active, flush inline
+  }
+}
+
+void index_writer::flush_segment(flush_context& ctx, segment_writer& writer) {
+  REGISTER_TIMER_DETAILED();
+  flushed_segment flushed(
+    index_meta::index_segment_t(segment_meta(writer.name(), codec_))
+  );
+
+  if (!writer.flush(flushed.segment.filename, flushed.segment.meta)) {
+    throw detailed_io_error("Failed to flush segment: ") << writer.name();
+  }
+
+  writer.release(flushed.docs_context, flushed.docs_mask);
+  writer.reset(); // a new segment will be started by the next insert
+
+  if (!sort_.empty()) {
+    sort_segment(*(ctx.dir_), flushed);
+  }
+
+  SCOPED_LOCK(ctx.mutex_); // lock due to context modification
+  ctx.flushed_segments_.emplace_back(std::move(flushed));
+}
+
+void index_writer::sort_segment(directory& dir, flushed_segment& flushed) {
+  REGISTER_TIMER_DETAILED();
+  auto& segment = flushed.segment;
+  index_meta::index_segment_t sorted(
+    segment_meta(file_name(meta_.increment()), codec_)
+  );
+  merge_writer merge_writer(dir, sorted.meta.name, merge_pool());
+
+  {
+    auto reader = segment_reader::open(dir, segment.meta);
+
+    if (!reader) {
+      throw detailed_io_error("Failed to open segment: ") << segment.meta.name;
+    }
+
+    merge_writer.add(reader);
+    merge_writer.sort(sort_);
+
+    if (!merge_writer.flush(sorted.filename, sorted.meta)) {
+      throw detailed_io_error("Failed to sort segment: ") << segment.meta.name;
+    }
+  }
+
+  // the document mask of a flushed segment is not written yet, so every
+  // document gets into the sorted segment
+  const auto min = type_limits<type_t::doc_id_t>::min();
+  segment_writer::update_contexts docs_context(flushed.docs_context.size());
+  document_mask docs_mask;
+
+  assert(flushed.docs_context.size() == segment.meta.docs_count);
+
+  for (size_t i = 0, count = flushed.docs_context.size(); i < count; ++i) {
+    const auto doc = merge_writer.doc_id(0, min + i);
+
+    assert(type_limits<type_t::doc_id_t>::valid(doc));
+    docs_context[doc - min] = flushed.docs_context[i];
+
+    if (flushed.docs_mask.contains(min + i)) {
+      docs_mask.insert(doc);
+    }
+  }
+
+  // files of the unsorted segment aren't referenced by anything
+  for (auto& file : segment.meta.files) {
+    dir.remove(file);
+  }
+
+  dir.remove(segment.filename);
+
+  segment = std::move(sorted);
+  flushed.docs_context = std::move(docs_context);
+  flushed.docs_mask = std::move(docs_mask);
+}
+
+void index_writer::remove(const string_ref& field, const bytes_ref& key) {
+  auto filter = std::make_shared<by_term>();
+
+  filter->field(field).term(key);
+
+  auto ctx = get_flush_context();
+  SCOPED_LOCK(ctx->mutex_); // lock due to context modification
+  ctx->modification_queries_.emplace_back(filter, ctx->generation_++, false, true);
+}
+
 void index_writer::remove(const filter& filter) {
   auto ctx = get_flush_context();
   SCOPED_LOCK(ctx->mutex_); // lock due to context modification
@@ -676,6 +1189,10 @@ index_writer::pending_context_t index_writer::flush_all() {
   auto& dir = *(ctx->dir_);
   SCOPED_LOCK(ctx->mutex_); // ensure there are no active struct update operations
 
+  if (ctx->flush_error_) {
+    std::rethrow_exception(ctx->flush_error_); // documents of the segment are lost
+  }
+
   // update document_mask for existing (i.e. sealed) segments
   for (auto& existing_segment: meta_) {
     // skip already masked segments
@@ -711,8 +1228,11 @@ index_writer::pending_context_t index_writer::flush_all() {
     auto& segment = segments.back();
     document_mask docs_mask;
 
+    // segments merged in background may already have a document_mask
+    index_utils::read_document_mask(docs_mask, dir, segment.meta);
+
     // flush document_mask after regular flush() so remove_query can traverse
-    add_document_mask_modified_records(
+    const auto modified = add_document_mask_modified_records(
       ctx->modification_queries_, docs_mask, segment.meta, pending_segment.generation
     );
 
@@ -722,8 +1242,8 @@ index_writer::pending_context_t index_writer::flush_all() {
       continue;
     }
 
-    // write non-empty document mask
-    if (!docs_mask.empty()) {
+    // write modified document mask
+    if (modified) {
       write_document_mask(dir, segment.meta, docs_mask);
       segment.filename = write_segment_meta(dir, segment.meta); // write with new mask
     }
@@ -733,66 +1253,119 @@ index_writer::pending_context_t index_writer::flush_all() {
   }
 
   {
-    struct flush_context {
-      size_t segment_offset;
-      segment_writer& writer;
-      flush_context(
-        size_t v_segment_offset, segment_writer& v_writer
-      ): segment_offset(v_segment_offset), writer(v_writer) {}
-      flush_context& operator=(const flush_context&) = delete; // because of reference
-    };
+    std::vector<segment_writer*> writers;
 
-    std::vector<flush_context> segment_ctxs;
-    auto flush = [this, &ctx, &segments, &segment_ctxs](segment_writer& writer) {
-      if (!writer.initialized()) {
-        return true;
+    ctx->writers_pool_.visit([&writers](segment_writer& writer) {
+      if (writer.initialized()) {
+        writers.emplace_back(&writer);
       }
 
-      segment_ctxs.emplace_back(segments.size(), writer);
-      segments.emplace_back(segment_meta(writer.name(), codec_));
+      return true;
+    });
 
-      auto& segment = segments.back();
+    index_meta::index_segments_t flushed;
 
-      if (!writer.flush(segment.filename, segment.meta)) {
-        return false;
-      }
+    flushed.reserve(writers.size());
 
-      // flush document_mask after regular flush() so remove_query can traverse
-      add_document_mask_modified_records(
-        ctx->modification_queries_, writer, segment.meta
-      );
+    for (auto* writer: writers) {
+      flushed.emplace_back(segment_meta(writer->name(), codec_));
+    }
 
-      return true;
+    // segment writers are independent, flush them concurrently
+    auto flush = [&writers, &flushed](size_t i)->bool {
+      auto& segment = flushed[i];
+
+      return writers[i]->flush(segment.filename, segment.meta);
     };
 
-    if (!ctx->writers_pool_.visit(flush)) {
+    if (!parallel_for(flush_pool_, writers.size(), flush)) {
       return pending_context_t();
     }
 
-    // write docs_mask if !empty(), if all docs are masked then remove segment altogether
-    for (auto& segment_ctx: segment_ctxs) {
-      auto& segment = segments[segment_ctx.segment_offset];
-      auto& writer = segment_ctx.writer;
+    // from now on segments flushed during commit are treated the same way as
+    // the ones flushed before commit upon exceeding memory limit
+    for (size_t i = 0, count = writers.size(); i < count; ++i) {
+      ctx->flushed_segments_.emplace_back(std::move(flushed[i]));
 
-      // if have a writer with potential update-replacement records then check if they were seen
-      add_document_mask_unused_updates(
-        ctx->modification_queries_, writer, segment.meta
+      auto& flushed_segment = ctx->flushed_segments_.back();
+
+      writers[i]->release(flushed_segment.docs_context, flushed_segment.docs_mask);
+    }
+
+    // sort segments flushed during commit, the ones flushed before commit
+    // have already been sorted
+    if (!sort_.empty()) {
+      const auto offset = ctx->flushed_segments_.size() - writers.size();
+      auto sort = [this, &dir, &ctx, offset](size_t i)->bool {
+        sort_segment(dir, ctx->flushed_segments_[offset + i]);
+        return true;
+      };
+
+      parallel_for(flush_pool_, writers.size(), sort);
+    }
+
+    auto& flushed_segments = ctx->flushed_segments_;
+    const auto segment_offset = segments.size();
+    std::vector<bool> masked(flushed_segments.size()); // all documents are masked
+
+    for (auto& flushed_segment: flushed_segments) {
+      segments.emplace_back(flushed_segment.segment); // copy, segment_mask_ refs at names in 'flushed_segments'
+    }
+
+    // flush document_mask after regular flush() so remove_query can traverse,
+    // modification queries are shared between segments and evaluated in order
+    for (size_t i = 0, count = flushed_segments.size(); i < count; ++i) {
+      auto& flushed_segment = flushed_segments[i];
+
+      add_document_mask_modified_records(
+        ctx->modification_queries_,
+        flushed_segment.docs_context,
+        flushed_segment.docs_mask,
+        segments[segment_offset + i].meta
       );
+    }
 
-      auto& docs_mask = writer.docs_mask();
+    for (size_t i = 0, count = flushed_segments.size(); i < count; ++i) {
+      auto& flushed_segment = flushed_segments[i];
+      auto& segment = segments[segment_offset + i];
+
+      // if have a segment with potential update-replacement records then check if they were seen
+      add_document_mask_unused_updates(
+        ctx->modification_queries_,
+        flushed_segment.docs_context,
+        flushed_segment.docs_mask,
+        segment.meta
+      );
 
       // mask empty segments
-      if (docs_mask.size() == segment.meta.docs_count) {
-        ctx->segment_mask_.emplace(writer.name()); // ref to writer name will not change
-        continue;
+      if (flushed_segment.docs_mask.size() == segment.meta.docs_count) {
+        ctx->segment_mask_.emplace(flushed_segment.segment.meta.name); // ref to name will not change
+        masked[i] = true;
       }
+    }
+
+    // write docs_mask if !empty(), segments are independent, so concurrently
+    auto write_mask = [&dir, &segments, &flushed_segments, &masked, segment_offset](size_t i)->bool {
+      auto& segment = segments[segment_offset + i];
+      auto& docs_mask = flushed_segments[i].docs_mask;
 
-      // write non-empty document mask
-      if (!docs_mask.empty()) {
+      if (!masked[i] && !docs_mask.empty()) {
         write_document_mask(dir, segment.meta, docs_mask);
         segment.filename = write_segment_meta(dir, segment.meta); // write with new mask
       }
 
+      return true;
+    };
+
+    parallel_for(flush_pool_, flushed_segments.size(), write_mask);
+
+    for (size_t i = 0, count = flushed_segments.size(); i < count; ++i) {
+      if (masked[i]) {
+        continue; // segment removed altogether
+      }
+
+      auto& segment = segments[segment_offset + i];
+
       // add files from segment to list of files to sync
       to_sync.insert(segment.meta.files.begin(), segment.meta.files.end());
     }
@@ -846,6 +1419,11 @@ index_writer::pending_context_t index_writer::flush_all() {
     }
   }
 
+  // files flushed by reader() before are synced along with the modified ones
+  for (auto& file: unsynced_files_) {
+    to_sync.emplace(*file);
+  }
+
   pending_context_t pending_context;
   flush_context::segment_mask_t segment_names;
 
@@ -945,6 +1523,61 @@ segment_writer::update_context index_writer::make_update_context(
   };
 }
 
+directory_reader index_writer::reader() {
+  REGISTER_TIMER_DETAILED();
+  assert(write_lock_);
+  SCOPED_LOCK(commit_lock_); // cached_segment_readers_ read/modified during flush_all()
+
+  auto open_segment = [this](const segment_meta& segment)->segment_reader {
+    return get_segment_reader(segment);
+  };
+
+  if (pending_state_) {
+    // begin() has been already called, all changes are flushed and synced
+    return directory_reader::open(
+      dir_, index_meta(*(pending_state_.meta)), open_segment
+    );
+  }
+
+  auto to_flush = flush_all();
+
+  if (!to_flush) {
+    return directory_reader::open(dir_, index_meta(meta_), open_segment);
+  }
+
+  // flushed files are referenced by the flush context until it gets reset,
+  // retain them until synced by the next commit
+  for (auto& file: to_flush.to_sync) {
+    auto ref = directory_utils::reference(
+      dir_, std::string(file.c_str(), file.size()), true
+    );
+
+    if (ref) {
+      unsynced_files_.emplace_back(std::move(ref));
+    }
+  }
+
+  return directory_reader::open(dir_, std::move(*(to_flush.meta)), open_segment);
+}
+
+segment_writer::update_context index_writer::make_update_context(
+    flush_context& ctx, const string_ref& field, const bytes_ref& key) {
+  auto filter = std::make_shared<by_term>();
+
+  filter->field(field).term(key);
+
+  auto generation = ++ctx.generation_;
+  SCOPED_LOCK(ctx.mutex_); // lock due to context modification
+  size_t update_id = ctx.modification_queries_.size();
+
+  ctx.modification_queries_.emplace_back(filter, generation - 1, true, true); // -1 for previous generation
+
+  return segment_writer::update_context {
+    generation, // current modification generation
+    update_id // entry in modification_queries_
+  };
+}
+
 bool index_writer::begin() {
   SCOPED_LOCK(commit_lock_);
   return start();
@@ -980,11 +1613,12 @@ bool index_writer::start() {
     });
 
     // sync files
-    for (auto& file: to_commit.to_sync) {
-      if (!to_commit.ctx->dir_->sync(file)) {
-        throw detailed_io_error("Failed to sync file, path: ") << file;
-      }
+    if (!to_commit.ctx->dir_->sync_batch(to_commit.to_sync)) {
+      throw detailed_io_error("Failed to sync files, count: ")
+        << std::to_string(to_commit.to_sync.size());
     }
+
+    unsynced_files_.clear(); // synced as a part of 'to_sync'
   } catch (...) {
     // in case of syncing error, just clear pending meta & peform rollback
     // next commit will create another meta & sync all pending files
@@ -1045,7 +1679,7 @@ void index_writer::rollback() {
   assert(write_lock_);
   SCOPED_LOCK(commit_lock_);
 
-  if (!pending_state_) {
+  if (!pending_state_ && unsynced_files_.empty()) {
     // there is no open transaction
     return;
   }
@@ -1055,8 +1689,12 @@ void index_writer::rollback() {
   // ...........................................................................
 
   // guarded by commit_lock_
-  writer_->rollback();
-  pending_state_.reset();
+  if (pending_state_) {
+    writer_->rollback();
+    pending_state_.reset();
+  }
+
+  unsynced_files_.clear(); // segments flushed by reader() are discarded
 
   // reset actual meta, note that here we don't change 
   // segment counters since it can be changed from insert function
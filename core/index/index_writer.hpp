@@ -24,6 +24,7 @@
 #ifndef IRESEARCH_INDEXWRITER_H
 #define IRESEARCH_INDEXWRITER_H
 
+#include "directory_reader.hpp"
 #include "index_meta.hpp"
 #include "field_meta.hpp"
 #include "segment_reader.hpp"
@@ -40,6 +41,9 @@
 
 #include <cassert>
 #include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <iterator>
 
 NS_ROOT
 
@@ -221,11 +225,17 @@ class IRESEARCH_API index_writer : util::noncopyable {
   /// @param dir directory where index will be should reside
   /// @param codec format that will be used for creating new index segments
   /// @param mode specifies how to open a writer
+  /// @param sort the column documents of new segments are ordered by, i.e.
+  ///        both flushed and merged segments are sorted by the values of the
+  ///        column (lexicographically, documents without a value go last)
+  ///        and are marked as sorted in their segment meta,
+  ///        empty == order of insertion (default)
   ////////////////////////////////////////////////////////////////////////////
   static index_writer::ptr make(
     directory& dir,
     format::ptr codec,
-    OPEN_MODE mode);
+    OPEN_MODE mode,
+    const string_ref& sort = string_ref::nil);
 
   ////////////////////////////////////////////////////////////////////////////
   /// @brief destructor 
@@ -243,6 +253,33 @@ class IRESEARCH_API index_writer : util::noncopyable {
   ////////////////////////////////////////////////////////////////////////////
   void clear();
 
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief sets the amount of memory a single segment writer may use for
+  ///        buffering documents, once exceeded at the end of insert(...) or
+  ///        update(...) the segment is flushed to the directory in background,
+  ///        it becomes visible for readers upon the next commit()
+  /// @param bytes memory limit, 0 == unlimited (default)
+  ////////////////////////////////////////////////////////////////////////////
+  void segment_memory_max(size_t bytes) NOEXCEPT {
+    segment_memory_max_.store(bytes);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns the amount of memory a single segment writer may use for
+  ///          buffering documents, 0 == unlimited
+  ////////////////////////////////////////////////////////////////////////////
+  size_t segment_memory_max() const NOEXCEPT {
+    return segment_memory_max_.load();
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @returns the column documents of new segments are ordered by as
+  ///          specified upon opening the writer, empty == order of insertion
+  ////////////////////////////////////////////////////////////////////////////
+  const std::string& sort() const NOEXCEPT {
+    return sort_;
+  }
+
   ////////////////////////////////////////////////////////////////////////////
   /// @brief inserts document to be filled by the specified functor into index
   /// @note that changes are not visible until commit()
@@ -270,7 +307,57 @@ class IRESEARCH_API index_writer : util::noncopyable {
       }
     } while (has_next);
 
-    return writer->valid();
+    const bool valid = writer->valid();
+
+    flush_if_exceeds(ctx, writer);
+
+    return valid;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief inserts a batch of documents, every element of the range
+  ///        [begin;end) is passed to the specified functor along with the
+  ///        document to be filled, the whole batch is inserted via a single
+  ///        flush context and segment writer
+  /// @note that changes are not visible until commit()
+  /// @note the specified 'func' should return false in order to roll back
+  ///       the current document, the rest of the batch is inserted anyway
+  /// @param begin the beginning of the range
+  /// @param end the end of the range
+  /// @param func the insertion logic, bool(document&, const value_type&)
+  /// @return number of successfully inserted documents
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Iterator, typename Func>
+  size_t insert(Iterator begin, Iterator end, Func func) {
+    typedef typename std::iterator_traits<Iterator>::iterator_category category_t;
+
+    auto ctx = get_flush_context(); // retain lock until end of insert(...)
+    auto writer = get_segment_context(*ctx);
+
+    writer->reserve(batch_size(begin, end, category_t()));
+
+    document doc(*writer);
+    size_t inserted = 0;
+
+    for (; begin != end; ++begin) {
+      writer->begin(make_update_context(*ctx));
+      try {
+        if (func(doc, *begin)) {
+          writer->commit();
+        } else {
+          writer->rollback();
+        }
+      } catch (...) {
+        writer->rollback();
+        throw;
+      }
+
+      inserted += writer->valid();
+    }
+
+    flush_if_exceeds(ctx, writer);
+
+    return inserted;
   }
 
   ////////////////////////////////////////////////////////////////////////////
@@ -289,7 +376,11 @@ class IRESEARCH_API index_writer : util::noncopyable {
 
     writer->begin(make_update_context(*ctx, filter));
 
-    return update(*ctx, *writer, func);
+    const bool valid = update(*ctx, *writer, func);
+
+    flush_if_exceeds(ctx, writer);
+
+    return valid;
   }
 
   ////////////////////////////////////////////////////////////////////////////
@@ -307,7 +398,11 @@ class IRESEARCH_API index_writer : util::noncopyable {
 
     writer->begin(make_update_context(*ctx, std::move(filter)));
 
-    return update(*ctx, *writer, func);
+    const bool valid = update(*ctx, *writer, func);
+
+    flush_if_exceeds(ctx, writer);
+
+    return valid;
   }
 
   ////////////////////////////////////////////////////////////////////////////
@@ -325,9 +420,48 @@ class IRESEARCH_API index_writer : util::noncopyable {
 
     writer->begin(make_update_context(*ctx, filter));
 
-    return update(*ctx, *writer, func);
+    const bool valid = update(*ctx, *writer, func);
+
+    flush_if_exceeds(ctx, writer);
+
+    return valid;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief replaces documents having the specified primary key with the
+  ///        document to be filled by the specified functor, unlike filter
+  ///        based updates all keys are resolved upon commit in a single
+  ///        sorted pass over the term dictionary of every segment
+  /// @note that changes are not visible until commit()
+  /// @param field the name of the field containing primary keys
+  /// @param key the primary key, i.e. an indexed term of the 'field'
+  /// @param func the insertion logic
+  /// @return all fields/attributes successfully insterted
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Func>
+  bool update(const string_ref& field, const bytes_ref& key, Func func) {
+    auto ctx = get_flush_context(); // retain lock until end of update(...)
+    auto writer = get_segment_context(*ctx);
+
+    writer->begin(make_update_context(*ctx, field, key));
+
+    const bool valid = update(*ctx, *writer, func);
+
+    flush_if_exceeds(ctx, writer);
+
+    return valid;
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief marks documents having the specified primary key for removal,
+  ///        unlike filter based removals all keys are resolved upon commit
+  ///        in a single sorted pass over the term dictionary of every segment
+  /// @note that changes are not visible until commit()
+  /// @param field the name of the field containing primary keys
+  /// @param key the primary key, i.e. an indexed term of the 'field'
+  ////////////////////////////////////////////////////////////////////////////
+  void remove(const string_ref& field, const bytes_ref& key);
+
   ////////////////////////////////////////////////////////////////////////////
   /// @brief marks documents matching filter for removal 
   /// @note that changes are not visible until commit()
@@ -388,6 +522,36 @@ class IRESEARCH_API index_writer : util::noncopyable {
   ////////////////////////////////////////////////////////////////////////////
   void consolidate(consolidation_policy_t&& policy, bool immediate);
 
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief schedules a merge of the committed segments accepted by the
+  ///        specified policy on a background thread, commits are not blocked
+  ///        by the merge. Upon completion the merged segment replaces the
+  ///        original ones in the next commit, documents removed from the
+  ///        original segments while the merge was running are removed from
+  ///        the merged segment as well.
+  /// @param policy the speicified defragmentation policy
+  /// @returns true if a merge has been scheduled
+  ////////////////////////////////////////////////////////////////////////////
+  bool consolidate_async(const consolidation_policy_t& policy);
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief sets the maximum number of concurrently running background merges
+  ////////////////////////////////////////////////////////////////////////////
+  void consolidation_threads(size_t count);
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief sets the number of threads merging the columnstore concurrently
+  ///        with the terms dictionary and postings of a merged or sorted
+  ///        segment, 0 == merge sequentially (default), the resulting
+  ///        segments are the same either way
+  ////////////////////////////////////////////////////////////////////////////
+  void merge_threads(size_t count);
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief waits until all scheduled background merges are finished
+  ////////////////////////////////////////////////////////////////////////////
+  void wait_for_consolidation();
+
   ////////////////////////////////////////////////////////////////////////////
   /// @brief imports index from the specified index reader into new segment
   /// @param reader the index reader to import 
@@ -395,6 +559,18 @@ class IRESEARCH_API index_writer : util::noncopyable {
   ////////////////////////////////////////////////////////////////////////////
   bool import(const index_reader& reader);
 
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief flushes buffered documents and applies pending removals/updates
+  ///        without committing them (i.e. neither the flushed files are synced
+  ///        nor a new index meta is written), so the changes become visible
+  ///        for the returned near-real-time reader only. The flushed segments
+  ///        get into the index upon the next commit() and are discarded by
+  ///        rollback(). Segment readers are shared with the writer, so
+  ///        only new or modified segments are opened on every call.
+  /// @returns reader over the committed and the flushed segments
+  ////////////////////////////////////////////////////////////////////////////
+  directory_reader reader();
+
   ////////////////////////////////////////////////////////////////////////////
   /// @brief begins the two-phase transaction
   /// @returns true if transaction has been sucessflully started
@@ -448,15 +624,16 @@ class IRESEARCH_API index_writer : util::noncopyable {
     std::shared_ptr<const iresearch::filter> filter; // keep a handle to the filter for the case when this object has ownership
     const size_t generation;
     const bool update; // this is an update modification (as opposed to remove)
+    const bool keyed; // 'filter' is a 'by_term' filter matching a primary key
     bool seen;
     modification_context(const iresearch::filter& match_filter, size_t gen, bool isUpdate)
-      : filter(&match_filter, [](const iresearch::filter*)->void{}), generation(gen), update(isUpdate), seen(false) {}
-    modification_context(const std::shared_ptr<iresearch::filter>& match_filter, size_t gen, bool isUpdate)
-      : filter(match_filter), generation(gen), update(isUpdate), seen(false) {}
+      : filter(&match_filter, [](const iresearch::filter*)->void{}), generation(gen), update(isUpdate), keyed(false), seen(false) {}
+    modification_context(const std::shared_ptr<iresearch::filter>& match_filter, size_t gen, bool isUpdate, bool isKeyed = false)
+      : filter(match_filter), generation(gen), update(isUpdate), keyed(isKeyed), seen(false) {}
     modification_context(iresearch::filter::ptr&& match_filter, size_t gen, bool isUpdate)
-      : filter(std::move(match_filter)), generation(gen), update(isUpdate), seen(false) {}
+      : filter(std::move(match_filter)), generation(gen), update(isUpdate), keyed(false), seen(false) {}
     modification_context(modification_context&& other) NOEXCEPT
-      : filter(std::move(other.filter)), generation(other.generation), update(other.update), seen(other.seen) {}
+      : filter(std::move(other.filter)), generation(other.generation), update(other.update), keyed(other.keyed), seen(other.seen) {}
     modification_context& operator=(const modification_context& other) = delete; // no default constructor
   }; // modification_context
 
@@ -471,12 +648,43 @@ class IRESEARCH_API index_writer : util::noncopyable {
     const index_meta::index_segment_t segment;
   }; // import_context
 
+  struct flushed_segment {
+    flushed_segment(index_meta::index_segment_t&& v_segment) NOEXCEPT
+      : segment(std::move(v_segment)) {}
+    flushed_segment(flushed_segment&& other) NOEXCEPT
+      : segment(std::move(other.segment)),
+        docs_context(std::move(other.docs_context)),
+        docs_mask(std::move(other.docs_mask)) {}
+    flushed_segment& operator=(const flushed_segment&) = delete;
+
+    index_meta::index_segment_t segment;
+    segment_writer::update_contexts docs_context; // generations of documents, required for applying modification queries
+    document_mask docs_mask; // invalid/removed doc_ids
+  }; // flushed_segment
+
+  struct consolidation_task {
+    struct candidate_t {
+      candidate_t(const segment_meta& meta, segment_reader&& reader)
+        : meta(&meta), reader(std::move(reader)) {}
+      const segment_meta* meta; // segment meta as of scheduling (refs at strings in 'meta')
+      segment_reader reader; // snapshot of the segment being merged
+    }; // candidate_t
+
+    std::shared_ptr<index_meta> meta; // committed meta the candidates belong to
+    file_refs_t refs; // refs to the files of the committed meta
+    ref_tracking_directory::ptr dir; // tracks files of the merged segment
+    std::vector<candidate_t> candidates; // segments to merge
+    index_meta::index_segment_t segment; // merged segment
+  }; // consolidation_task
+
   typedef std::unordered_map<std::string, segment_reader> cached_readers_t;
   typedef std::pair<std::shared_ptr<index_meta>, file_refs_t> committed_state_t;
   typedef std::vector<consolidation_context> consolidation_requests_t;
   typedef std::vector<modification_context> modification_requests_t;
+  typedef std::vector<std::pair<size_t, doc_id_t>> keyed_matches_t; // pairs of modification request offset and matched document
 
   struct IRESEARCH_API flush_context {
+    typedef std::vector<flushed_segment> flushed_segments_t;
     typedef std::vector<import_context> imported_segments_t;
     typedef std::unordered_set<string_ref> segment_mask_t;
     typedef bounded_object_pool<segment_writer> segment_writers_t;
@@ -535,11 +743,14 @@ class IRESEARCH_API index_writer : util::noncopyable {
     }; // ptr
 
     consolidation_requests_t consolidation_policies_; // sequential list of segment merge policies to apply at the end of commit to all segments
+    std::vector<std::shared_ptr<consolidation_task>> consolidation_tasks_; // finished background merges, hold refs to their committed meta and merged segment files until the end of commit (guarded by mutex_)
     std::atomic<size_t> generation_; // current modification/update generation
     ref_tracking_directory::ptr dir_; // ref tracking directory used by this context (tracks all/only refs for this context)
     async_utils::read_write_mutex flush_mutex_; // guard for the current context during flush (write) operations vs update (read)
     modification_requests_t modification_queries_; // sequential list of modification requests (remove/update)
     std::mutex mutex_; // guard for the current context during struct update operations, e.g. modification_queries_, pending_segments_
+    std::exception_ptr flush_error_; // first failure of a segment flush in background (guarded by mutex_)
+    flushed_segments_t flushed_segments_; // segments flushed by segment writers before commit, in order of flushing (guarded by mutex_)
     flush_context* next_context_; // the next context to switch to
     imported_segments_t pending_segments_; // complete segments to be added during next commit (import)
     segment_mask_t segment_mask_; // set of segment names to be removed from the index upon commit (refs at strings in index_writer::meta_)
@@ -571,7 +782,8 @@ class IRESEARCH_API index_writer : util::noncopyable {
     directory& dir, 
     format::ptr codec,
     index_meta&& meta, 
-    committed_state_t&& committed_state
+    committed_state_t&& committed_state,
+    std::string&& sort
   ) NOEXCEPT;
 
   // on open failure returns an empty pointer
@@ -579,6 +791,23 @@ class IRESEARCH_API index_writer : util::noncopyable {
   // flush_all(...) and defragment(...)
   segment_reader get_segment_reader(const segment_meta& meta);
 
+  // finds documents matching keyed modification requests in a single pass over
+  // the term dictionaries of the key fields, 'matches' are ordered by request
+  static void resolve_keyed_modifications(
+    const modification_requests_t& requests,
+    const sub_reader& segment,
+    keyed_matches_t& matches
+  );
+
+  // visits documents of the 'segment' matching valid modification requests
+  // in order of requests, i.e. visitor(modification_context&, doc_id_t)
+  template<typename Visitor>
+  static void visit_modified_records(
+    modification_requests_t& requests,
+    const sub_reader& segment,
+    const Visitor& visitor
+  );
+
   bool add_document_mask_modified_records(
     modification_requests_t& requests, 
     document_mask& docs_mask,
@@ -588,13 +817,15 @@ class IRESEARCH_API index_writer : util::noncopyable {
 
   bool add_document_mask_modified_records(
     modification_requests_t& requests, 
-    segment_writer& writer,
+    const segment_writer::update_contexts& docs_context,
+    document_mask& docs_mask,
     const segment_meta& meta
   ); // return if any new records were added (modification_queries_ modified)
 
   static bool add_document_mask_unused_updates(
     modification_requests_t& requests, 
-    segment_writer& writer,
+    const segment_writer::update_contexts& docs_context,
+    document_mask& docs_mask,
     const segment_meta& meta
   ); // return if any new records were added (modification_queries_ modified)
 
@@ -608,9 +839,33 @@ class IRESEARCH_API index_writer : util::noncopyable {
 
   pending_context_t flush_all();
 
+  // rewrites a flushed segment in order of the column set via sort(...),
+  // generations and masks of documents follow their new doc_ids
+  void sort_segment(directory& dir, flushed_segment& segment);
+
+  // returns the pool for merge_writer instances, nullptr == merge sequentially
+  async_utils::thread_pool* merge_pool() NOEXCEPT {
+    return merge_threads_.load() ? &merge_pool_ : nullptr;
+  }
+
+  // merges segments of the specified task and adds the result to the
+  // current flush_context, called on a background thread
+  void consolidate(const std::shared_ptr<consolidation_task>& task);
+
   flush_context::ptr get_flush_context(bool shared = true);
   index_writer::flush_context::segment_writers_t::ptr get_segment_context(flush_context& ctx);
 
+  // schedules flushing of the segment of the 'writer' in background if the
+  // writer exceeds memory limit, takes ownership of 'ctx' and 'writer' then
+  void flush_if_exceeds(
+    flush_context::ptr& ctx,
+    flush_context::segment_writers_t::ptr& writer
+  );
+
+  // flushes the segment of the 'writer' and adds it to 'ctx' as a segment
+  // to be added during the next commit, resets the 'writer'
+  void flush_segment(flush_context& ctx, segment_writer& writer);
+
   // returns context for "add" operation
   static segment_writer::update_context make_update_context(flush_context& ctx);
 
@@ -618,6 +873,17 @@ class IRESEARCH_API index_writer : util::noncopyable {
   segment_writer::update_context make_update_context(flush_context& ctx, const filter& filter);
   segment_writer::update_context make_update_context(flush_context& ctx, const std::shared_ptr<filter>& filter);
   segment_writer::update_context make_update_context(flush_context& ctx, filter::ptr&& filter);
+  segment_writer::update_context make_update_context(flush_context& ctx, const string_ref& field, const bytes_ref& key);
+
+  template<typename Iterator>
+  static size_t batch_size(Iterator begin, Iterator end, std::forward_iterator_tag) {
+    return size_t(std::distance(begin, end));
+  }
+
+  template<typename Iterator>
+  static size_t batch_size(Iterator, Iterator, std::input_iterator_tag) {
+    return 0; // single-pass range, size is unknown
+  }
 
   template<typename Func>
   bool update(flush_context& ctx, segment_writer& writer, Func func) {
@@ -652,11 +918,21 @@ class IRESEARCH_API index_writer : util::noncopyable {
   format::ptr codec_;
   std::mutex commit_lock_; // guard for cached_segment_readers_, commit_pool_, meta_ (modification during commit()/defragment())
   committed_state_t committed_state_; // last successfully committed state
+  std::condition_variable consolidation_cond_; // signaled upon completion of a background merge (guarded by commit_lock_)
+  size_t consolidation_count_; // number of scheduled background merges (guarded by commit_lock_)
+  async_utils::thread_pool consolidation_pool_; // threads running background merges
+  std::unordered_set<string_ref> consolidating_segments_; // segments being merged in background (refs at strings in consolidation_task::meta, guarded by commit_lock_)
   directory& dir_; // directory used for initialization of readers
+  async_utils::thread_pool flush_pool_; // threads flushing segment writers during commit or upon exceeding memory limit
+  std::atomic<size_t> segment_memory_max_; // memory limit of a single segment writer, 0 == unlimited
+  const std::string sort_; // column documents of new segments are ordered by, empty == unordered (immutable, read by flush threads)
   std::vector<flush_context> flush_context_pool_; // collection of contexts that collect data to be flushed, 2 because just swap them
   std::atomic<flush_context*> flush_context_; // currently active context accumulating data to be processed during the next flush
+  async_utils::thread_pool merge_pool_; // threads merging columnstores of merged segments
+  std::atomic<size_t> merge_threads_; // number of threads in merge_pool_, 0 == merge sequentially
   index_meta meta_; // latest/active state of index metadata
   pending_state_t pending_state_; // current state awaiting commit completion
+  file_refs_t unsynced_files_; // files flushed by reader() awaiting sync upon the next commit (guarded by commit_lock_)
   index_meta_writer::ptr writer_;
   index_lock::ptr write_lock_; // exclusive write lock for directory
   IRESEARCH_API_PRIVATE_VARIABLES_END
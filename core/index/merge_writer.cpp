@@ -21,13 +21,17 @@
 /// @author Vasiliy Nabatchikov
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <condition_variable>
 #include <deque>
+#include <mutex>
 #include <unordered_map>
 
 #include "merge_writer.hpp"
+#include "analysis/token_attributes.hpp"
 #include "index/field_meta.hpp"
 #include "index/index_meta.hpp"
 #include "index/segment_reader.hpp"
+#include "utils/async_utils.hpp"
 #include "utils/directory_utils.hpp"
 #include "utils/log.hpp"
 #include "utils/type_limits.hpp"
@@ -35,6 +39,8 @@
 #include "store/store_utils.hpp"
 
 #include <array>
+#include <cmath>
+#include <numeric>
 
 NS_LOCAL
 
@@ -47,6 +53,9 @@ typedef std::vector<irs::field_id> id_map_t;
 
 typedef std::unordered_map<irs::string_ref, const irs::field_meta*> field_meta_map_t;
 
+// reader with map of old doc_id to new doc_id
+typedef std::pair<const irs::sub_reader*, doc_id_map_t> reader_t;
+
 const irs::doc_id_t MASKED_DOC_ID = irs::integer_traits<irs::doc_id_t>::const_max; // masked doc_id (ignore)
 
 //////////////////////////////////////////////////////////////////////////////
@@ -204,6 +213,205 @@ bool compound_doc_iterator::next() {
   return false;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class sorting_doc_iterator
+/// @brief iterator over doc_ids for a term over all readers in order of
+///        doc_ids, used when the merged segment doesn't preserve the order of
+///        documents of the merged readers, the postings are buffered in memory
+//////////////////////////////////////////////////////////////////////////////
+class sorting_doc_iterator : public irs::doc_iterator {
+ public:
+  sorting_doc_iterator()
+    : attrs_(2) { // frequency + position
+    auto pos = irs::memory::make_unique<pos_iterator>(*this);
+    pos_itr_ = pos.get();
+    pos_.reset(std::move(pos));
+  }
+
+  void reset(irs::doc_iterator& docs, const irs::flags& features);
+
+  virtual const irs::attribute_view& attributes() const NOEXCEPT override {
+    return attrs_;
+  }
+
+  virtual bool next() override {
+    if (next_ >= docs_.size()) {
+      current_id_ = MASKED_DOC_ID;
+      return false;
+    }
+
+    auto& doc = docs_[next_++];
+    current_id_ = doc.id;
+    freq_.value = doc.freq;
+    pos_itr_->reset(doc.pos_begin, doc.pos_end);
+
+    return true;
+  }
+
+  virtual irs::doc_id_t seek(irs::doc_id_t target) override {
+    irs::seek(*this, target);
+    return value();
+  }
+
+  virtual irs::doc_id_t value() const override {
+    return current_id_;
+  }
+
+ private:
+  struct doc_t {
+    irs::doc_id_t id;
+    uint64_t freq;
+    size_t pos_begin; // first position in 'positions_'
+    size_t pos_end; // end of positions in 'positions_'
+  };
+
+  struct pos_t {
+    irs::position::value_t value;
+    uint32_t start; // offset start
+    uint32_t end; // offset end
+    size_t pay_begin; // payload begin in 'payloads_'
+    size_t pay_end; // payload end in 'payloads_'
+  };
+
+  class pos_iterator final : public irs::position::impl {
+   public:
+    explicit pos_iterator(const sorting_doc_iterator& owner)
+      : irs::position::impl(2), // offset + payload
+        owner_(&owner) {
+    }
+
+    void features(const irs::flags& features) {
+      attrs_.clear();
+
+      if (features.check<irs::offset>()) {
+        attrs_.emplace(offs_);
+      }
+
+      if (features.check<irs::payload>()) {
+        attrs_.emplace(pay_);
+      }
+    }
+
+    void reset(size_t begin, size_t end) NOEXCEPT {
+      next_ = begin;
+      end_ = end;
+      clear();
+    }
+
+    virtual void clear() override {
+      value_ = irs::position::INVALID;
+      offs_.clear();
+      pay_.clear();
+    }
+
+    virtual irs::position::value_t value() const override {
+      return value_;
+    }
+
+    virtual bool next() override {
+      if (next_ >= end_) {
+        value_ = irs::position::NO_MORE;
+        return false;
+      }
+
+      auto& pos = owner_->positions_[next_++];
+      value_ = pos.value;
+      offs_.start = pos.start;
+      offs_.end = pos.end;
+      pay_.value = irs::bytes_ref(
+        owner_->payloads_.c_str() + pos.pay_begin, pos.pay_end - pos.pay_begin
+      );
+
+      return true;
+    }
+
+   private:
+    const sorting_doc_iterator* owner_;
+    irs::offset offs_;
+    irs::payload pay_;
+    size_t next_{};
+    size_t end_{};
+    irs::position::value_t value_{ irs::position::INVALID };
+  }; // pos_iterator
+
+  irs::attribute_view attrs_;
+  irs::frequency freq_;
+  irs::position pos_;
+  pos_iterator* pos_itr_; // owned by 'pos_'
+  std::vector<doc_t> docs_;
+  std::vector<pos_t> positions_;
+  irs::bstring payloads_;
+  size_t next_{};
+  irs::doc_id_t current_id_{ irs::type_limits<irs::type_t::doc_id_t>::invalid() };
+}; // sorting_doc_iterator
+
+void sorting_doc_iterator::reset(
+    irs::doc_iterator& docs,
+    const irs::flags& features) {
+  docs_.clear();
+  positions_.clear();
+  payloads_.clear();
+  next_ = 0;
+  current_id_ = irs::type_limits<irs::type_t::doc_id_t>::invalid();
+  attrs_.clear();
+
+  const bool has_freq = features.check<irs::frequency>();
+  const bool has_pos = has_freq && features.check<irs::position>();
+
+  if (has_freq) {
+    attrs_.emplace(freq_);
+  }
+
+  if (has_pos) {
+    pos_itr_->features(features);
+    attrs_.emplace(pos_);
+  }
+
+  // attributes of the compound iterator change along with the underlying reader
+  while (docs.next()) {
+    auto& attrs = docs.attributes();
+    auto& freq = attrs.get<irs::frequency>();
+    doc_t doc{ docs.value(), 0, positions_.size(), positions_.size() };
+
+    if (has_freq && freq) {
+      doc.freq = freq->value;
+    }
+
+    auto& pos = has_pos ? attrs.get<irs::position>() : irs::attribute_view::ref<irs::position>::nil;
+
+    if (pos) {
+      auto& pos_attrs = pos->attributes();
+      const auto* offs = pos_attrs.get<irs::offset>().get();
+      const auto* pay = pos_attrs.get<irs::payload>().get();
+
+      while (pos->next()) {
+        pos_t entry{ pos->value(), 0, 0, payloads_.size(), payloads_.size() };
+
+        if (offs) {
+          entry.start = offs->start;
+          entry.end = offs->end;
+        }
+
+        if (pay) {
+          payloads_.append(pay->value.c_str(), pay->value.size());
+          entry.pay_end = payloads_.size();
+        }
+
+        positions_.emplace_back(entry);
+      }
+
+      doc.pos_end = positions_.size();
+    }
+
+    docs_.emplace_back(doc);
+  }
+
+  std::sort(
+    docs_.begin(), docs_.end(),
+    [](const doc_t& lhs, const doc_t& rhs) { return lhs.id < rhs.id; }
+  );
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @struct compound_iterator
 //////////////////////////////////////////////////////////////////////////////
@@ -319,6 +527,11 @@ class compound_term_iterator : public irs::term_iterator {
     : doc_itr_(std::make_shared<compound_doc_iterator>()) {
   }
 
+  // postings are produced in order of doc_ids regardless of the order of readers
+  void sort_postings() {
+    sorting_itr_ = std::make_shared<sorting_doc_iterator>();
+  }
+
   void reset(const irs::field_meta& meta) NOEXCEPT {
     meta_ = &meta;
     term_iterator_mask_.clear();
@@ -355,6 +568,7 @@ class compound_term_iterator : public irs::term_iterator {
   std::vector<size_t> term_iterator_mask_; // valid iterators for current term
   std::vector<term_iterator_t> term_iterators_; // all term iterators
   irs::doc_iterator::ptr doc_itr_;
+  irs::doc_iterator::ptr sorting_itr_; // set if postings have to be sorted
 }; // compound_term_iterator
 
 void compound_term_iterator::add(
@@ -412,6 +626,12 @@ irs::doc_iterator::ptr compound_term_iterator::postings(const irs::flags& /*feat
     doc_itr.add(term_itr.first->postings(meta().features), *(term_itr.second));
   }
 
+  if (sorting_itr_) {
+    static_cast<sorting_doc_iterator&>(*sorting_itr_).reset(doc_itr, meta().features);
+
+    return sorting_itr_;
+  }
+
   return doc_itr_;
 }
 
@@ -424,6 +644,7 @@ class compound_field_iterator : public irs::basic_term_reader {
   void add(const irs::sub_reader& reader, const doc_id_map_t& doc_id_map);
   bool next();
   size_t size() const { return field_iterators_.size(); }
+  void sort_postings() { term_itr_.sort_postings(); }
 
   // visit matched iterators
   template<typename Visitor>
@@ -601,6 +822,283 @@ irs::doc_id_t compute_doc_ids(
   return next_id;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief assigns new doc_ids to the documents of the merged readers
+/// @param order new position of each document in order of concatenation of
+///        the merged readers
+//////////////////////////////////////////////////////////////////////////////
+void remap_doc_ids(
+    std::deque<reader_t>& readers,
+    const std::vector<irs::doc_id_t>& order) {
+  const auto min = irs::type_limits<irs::type_t::doc_id_t>::min();
+
+  for (auto& reader : readers) {
+    for (auto& doc : reader.second) {
+      if (MASKED_DOC_ID != doc) {
+        assert(doc - min < order.size());
+        doc = min + order[doc - min];
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief orders live documents of the merged readers by the specified key
+/// @returns new position of each document in order of concatenation
+//////////////////////////////////////////////////////////////////////////////
+std::vector<irs::doc_id_t> sort_doc_ids(
+    const std::deque<reader_t>& readers,
+    size_t docs_count,
+    const irs::merge_writer::sort_key_f& sort_key) {
+  const auto min = irs::type_limits<irs::type_t::doc_id_t>::min();
+  std::vector<irs::bstring> keys(docs_count);
+
+  for (auto& reader : readers) {
+    auto& doc_id_map = reader.second;
+
+    for (irs::doc_id_t doc = min, size = doc_id_map.size(); doc < size; ++doc) {
+      if (MASKED_DOC_ID != doc_id_map[doc]) {
+        sort_key(*reader.first, doc, keys[doc_id_map[doc] - min]);
+      }
+    }
+  }
+
+  std::vector<irs::doc_id_t> docs(docs_count);
+  std::iota(docs.begin(), docs.end(), 0);
+  std::stable_sort(
+    docs.begin(), docs.end(),
+    [&keys](irs::doc_id_t lhs, irs::doc_id_t rhs) { return keys[lhs] < keys[rhs]; }
+  );
+
+  std::vector<irs::doc_id_t> order(docs_count);
+
+  for (size_t i = 0; i < docs_count; ++i) {
+    order[docs[i]] = i;
+  }
+
+  return order;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class graph_bisection
+/// @brief orders documents by recursive bisection of the bipartite graph of
+///        documents and terms, each step splits a partition in halves and
+///        swaps documents between the halves while it reduces the estimated
+///        cost of encoding the gaps between doc_ids of the terms, see
+///        "Compressing Graphs and Indexes with Recursive Graph Bisection"
+///        by L. Dhulipala et al.
+//////////////////////////////////////////////////////////////////////////////
+class graph_bisection {
+ public:
+  static const size_t MAX_ITERATIONS = 20; // max number of swap rounds per step
+  static const size_t MIN_PARTITION = 16; // partitions are not split further
+
+  graph_bisection(size_t docs_count, size_t terms_count)
+    : offsets_(docs_count + 1, 0),
+      gains_(docs_count),
+      left_(terms_count),
+      right_(terms_count) {
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief sets terms of the documents
+  /// @param postings docs of each term, concatenated
+  /// @param bounds end of each term in 'postings'
+  //////////////////////////////////////////////////////////////////////////////
+  void index(
+      const std::vector<irs::doc_id_t>& postings,
+      const std::vector<size_t>& bounds) {
+    // transpose term -> docs into doc -> terms
+    for (auto doc : postings) {
+      ++offsets_[doc + 1];
+    }
+
+    std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+    terms_.resize(postings.size());
+
+    std::vector<size_t> next(offsets_.begin(), offsets_.end() - 1);
+
+    for (size_t term = 0, i = 0; term < bounds.size(); ++term) {
+      for (; i < bounds[term]; ++i) {
+        terms_[next[postings[i]]++] = uint32_t(term);
+      }
+    }
+  }
+
+  // @returns new position of each document
+  std::vector<irs::doc_id_t> order() {
+    std::vector<irs::doc_id_t> docs(gains_.size());
+    std::iota(docs.begin(), docs.end(), 0);
+
+    bisect(docs.data(), docs.data() + docs.size());
+
+    std::vector<irs::doc_id_t> order(docs.size());
+
+    for (size_t i = 0; i < docs.size(); ++i) {
+      order[docs[i]] = i;
+    }
+
+    return order;
+  }
+
+ private:
+  // estimated cost of encoding gaps of a term with 'deg' docs in 'size' docs
+  static double cost(uint32_t deg, size_t size) {
+    return deg * std::log2(double(size) / (deg + 1));
+  }
+
+  // reduction of the cost if a document is moved between partitions
+  double gain(irs::doc_id_t doc,
+              const std::vector<uint32_t>& from, size_t from_size,
+              const std::vector<uint32_t>& to, size_t to_size) const {
+    double gain = 0;
+
+    for (auto i = offsets_[doc], end = offsets_[doc + 1]; i < end; ++i) {
+      const auto from_deg = from[terms_[i]];
+      const auto to_deg = to[terms_[i]];
+
+      gain += cost(from_deg, from_size) + cost(to_deg, to_size)
+            - cost(from_deg - 1, from_size) - cost(to_deg + 1, to_size);
+    }
+
+    return gain;
+  }
+
+  void move(irs::doc_id_t doc,
+            std::vector<uint32_t>& from,
+            std::vector<uint32_t>& to) {
+    for (auto i = offsets_[doc], end = offsets_[doc + 1]; i < end; ++i) {
+      --from[terms_[i]];
+      ++to[terms_[i]];
+    }
+  }
+
+  void bisect(irs::doc_id_t* begin, irs::doc_id_t* end);
+
+  std::vector<size_t> offsets_; // start of terms of each document in 'terms_'
+  std::vector<uint32_t> terms_; // terms of documents
+  std::vector<double> gains_; // gains of moving each document
+  std::vector<uint32_t> left_; // degrees of terms in the left partition
+  std::vector<uint32_t> right_; // degrees of terms in the right partition
+}; // graph_bisection
+
+void graph_bisection::bisect(irs::doc_id_t* begin, irs::doc_id_t* end) {
+  const size_t size = size_t(std::distance(begin, end));
+
+  if (size <= MIN_PARTITION) {
+    return;
+  }
+
+  auto* mid = begin + size / 2;
+  const size_t left_size = size_t(std::distance(begin, mid));
+  const size_t right_size = size - left_size;
+
+  // compute degrees of terms in both partitions
+  for (auto* doc = begin; doc != end; ++doc) {
+    auto& degrees = doc < mid ? left_ : right_;
+
+    for (auto i = offsets_[*doc], e = offsets_[*doc + 1]; i < e; ++i) {
+      ++degrees[terms_[i]];
+    }
+  }
+
+  auto by_gain = [this](irs::doc_id_t lhs, irs::doc_id_t rhs) {
+    return gains_[lhs] > gains_[rhs];
+  };
+
+  for (size_t iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
+    for (auto* doc = begin; doc != mid; ++doc) {
+      gains_[*doc] = gain(*doc, left_, left_size, right_, right_size);
+    }
+
+    for (auto* doc = mid; doc != end; ++doc) {
+      gains_[*doc] = gain(*doc, right_, right_size, left_, left_size);
+    }
+
+    std::sort(begin, mid, by_gain);
+    std::sort(mid, end, by_gain);
+
+    size_t swapped = 0;
+
+    for (auto* lhs = begin, *rhs = mid; lhs != mid && rhs != end; ++lhs, ++rhs) {
+      if (gains_[*lhs] + gains_[*rhs] <= 0) {
+        break; // no more beneficial swaps
+      }
+
+      move(*lhs, left_, right_);
+      move(*rhs, right_, left_);
+      std::swap(*lhs, *rhs);
+      ++swapped;
+    }
+
+    if (!swapped) {
+      break;
+    }
+  }
+
+  // reset degrees for the next partitions
+  for (auto* doc = begin; doc != end; ++doc) {
+    for (auto i = offsets_[*doc], e = offsets_[*doc + 1]; i < e; ++i) {
+      left_[terms_[i]] = 0;
+      right_[terms_[i]] = 0;
+    }
+  }
+
+  bisect(begin, mid);
+  bisect(mid, end);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief orders live documents of the merged readers by graph bisection over
+///        the terms of the specified field
+/// @returns new position of each document in order of concatenation
+//////////////////////////////////////////////////////////////////////////////
+std::vector<irs::doc_id_t> bisect_doc_ids(
+    const std::deque<reader_t>& readers,
+    size_t docs_count,
+    const irs::string_ref& field) {
+  const auto min = irs::type_limits<irs::type_t::doc_id_t>::min();
+  compound_term_iterator terms;
+  bool empty = true;
+
+  for (auto& reader : readers) {
+    const auto* term_reader = reader.first->field(field);
+
+    if (!term_reader) {
+      continue;
+    }
+
+    if (empty) {
+      terms.reset(term_reader->meta());
+      empty = false;
+    }
+
+    terms.add(*term_reader, reader.second);
+  }
+
+  std::vector<irs::doc_id_t> postings; // docs of terms in order of terms
+  std::vector<size_t> bounds; // end of each term in 'postings'
+
+  while (!empty && terms.next()) {
+    const auto begin = postings.size();
+
+    for (auto docs = terms.postings(irs::flags::empty_instance()); docs->next();) {
+      postings.emplace_back(docs->value() - min);
+    }
+
+    if (postings.size() - begin < 2) {
+      postings.resize(begin); // term doesn't affect the gaps
+    } else {
+      bounds.emplace_back(postings.size());
+    }
+  }
+
+  graph_bisection bisection(docs_count, bounds.size());
+  bisection.index(postings, bounds);
+
+  return bisection.order();
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief computes fields_type and fields_count
 //////////////////////////////////////////////////////////////////////////////
@@ -668,12 +1166,47 @@ class columnstore {
 
         empty_ = false;
 
+        if (sort_) {
+          // values are written in order of doc_ids by 'finish()'
+          values_.emplace_back(mapped_doc, data_.size());
+          data_.append(in.c_str(), in.size());
+          return true;
+        }
+
         auto& out = column_.second(mapped_doc);
         out.write_bytes(in.c_str(), in.size());
         return true;
     });
   }
 
+  // buffer values of a column until 'finish()' since the merged segment
+  // doesn't preserve the order of documents of the merged readers
+  void sort_values() { sort_ = true; }
+
+  // writes buffered values of the current column
+  void finish() {
+    if (values_.empty()) {
+      return;
+    }
+
+    std::vector<size_t> order(values_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(
+      order.begin(), order.end(),
+      [this](size_t lhs, size_t rhs) { return values_[lhs].first < values_[rhs].first; }
+    );
+
+    for (auto i : order) {
+      const auto begin = values_[i].second;
+      const auto end = i + 1 < values_.size() ? values_[i + 1].second : data_.size();
+      auto& out = column_.second(values_[i].first);
+      out.write_bytes(data_.c_str() + begin, end - begin);
+    }
+
+    values_.clear();
+    data_.clear();
+  }
+
   void reset() {
     if (!empty_) {
       column_ = writer_->push_column();
@@ -698,7 +1231,10 @@ class columnstore {
  private:
   irs::columnstore_writer::ptr writer_;
   irs::columnstore_writer::column_t column_{};
+  std::vector<std::pair<irs::doc_id_t, size_t>> values_; // doc + offset in 'data_'
+  irs::bstring data_; // buffered values
   bool empty_{ false };
+  bool sort_{ false };
 }; // columnstore
 
 bool write_columns(
@@ -729,6 +1265,7 @@ bool write_columns(
     // visit matched columns from merging segments and
     // write all survived values to the new segment 
     column_itr.visit(visitor); 
+    cs.finish();
 
     if (!cs.empty()) {
       cmw->write((*column_itr).name, cs.id());
@@ -739,19 +1276,46 @@ bool write_columns(
   return true;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief merge norms of the current field into a new column
+/// @returns identifier of the merged column, invalid if there are no norms
+//////////////////////////////////////////////////////////////////////////////
+irs::field_id write_norms(columnstore& cs, compound_field_iterator& field_itr) {
+  auto merge_norms = [&cs] (
+      const irs::sub_reader& segment,
+      const doc_id_map_t& doc_id_map,
+      const irs::field_meta& field) {
+    // merge field norms if present
+    if (irs::type_limits<irs::type_t::field_id_t>::valid(field.norm)) {
+      cs.insert(segment, field.norm, doc_id_map);
+    }
+
+    return true;
+  };
+
+  cs.reset();
+
+  // remap merge norms
+  field_itr.visit(merge_norms);
+  cs.finish();
+
+  return cs.empty() ? irs::type_limits<irs::type_t::field_id_t>::invalid() : cs.id();
+}
+
 //////////////////////////////////////////////////////////////////////////////
 /// @brief write field term data
+/// @param norms functor providing the norm column of the current field
 //////////////////////////////////////////////////////////////////////////////
+template<typename NormsProvider>
 bool write(
-    columnstore& cs,
     irs::directory& dir,
     const irs::segment_meta& meta,
     compound_field_iterator& field_itr,
     const field_meta_map_t& field_meta_map,
-    const irs::flags& fields_features
+    const irs::flags& fields_features,
+    NormsProvider& norms
 ) {
   REGISTER_TIMER_DETAILED();
-  assert(cs);
 
   irs::flush_state flush_state;
   flush_state.dir = &dir;
@@ -764,36 +1328,19 @@ bool write(
   auto fw = meta.codec->get_field_writer(true);
   fw->prepare(flush_state);
 
-  auto merge_norms = [&cs] (
-      const irs::sub_reader& segment,
-      const doc_id_map_t& doc_id_map,
-      const irs::field_meta& field) {
-    // merge field norms if present
-    if (irs::type_limits<irs::type_t::field_id_t>::valid(field.norm)) {
-      cs.insert(segment, field.norm, doc_id_map);
-    }
-
-    return true;
-  };
-
-  while (field_itr.next()) {
-    cs.reset();
-
+  for (size_t i = 0; field_itr.next(); ++i) {
     auto& field_meta = field_itr.meta();
     auto& field_features = field_meta.features;
+    irs::field_id norm;
+
+    if (!norms(i, field_itr, norm)) {
+      return false; // failed to merge norms
+    }
 
-    // remap merge norms
-    field_itr.visit(merge_norms); 
-   
     // write field terms
     auto terms = field_itr.iterator();
 
-    fw->write(
-      field_meta.name,
-      cs.empty() ? irs::type_limits<irs::type_t::field_id_t>::invalid() : cs.id(),
-      field_features,
-      *terms
-    );
+    fw->write(field_meta.name, norm, field_features, *terms);
   }
 
   fw->end();
@@ -803,25 +1350,184 @@ bool write(
   return true;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class columnstore_task
+/// @brief merges columns and norms of a segment on a thread pool while terms
+///        are being merged by the caller, the norm column identifiers are
+///        published in the order of fields, so the caller needs to wait only
+///        for the norms of the field it's about to write.
+///        The task is either picked up by the pool or executed inline by the
+///        first caller which needs its results, hence it never waits for a
+///        free pool thread.
+//////////////////////////////////////////////////////////////////////////////
+class columnstore_task : irs::util::noncopyable {
+ public:
+  typedef std::function<bool(columnstore_task&)> task_f;
+
+  explicit columnstore_task(size_t fields_count)
+    : norms_(fields_count, irs::type_limits<irs::type_t::field_id_t>::invalid()) {
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief executes the task unless it has already been picked up
+  //////////////////////////////////////////////////////////////////////////////
+  void run() NOEXCEPT {
+    if (claimed_.exchange(true)) {
+      return; // already picked up
+    }
+
+    bool result = false;
+
+    try {
+      result = task_(*this);
+    } catch (...) {
+      IR_FRMT_ERROR("Caught exception while merging columnstore in: %s", __FUNCTION__);
+      IR_EXCEPTION();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    result_ = result;
+    done_ = true;
+    cond_.notify_all();
+  }
+
+  void task(task_f&& task) { task_ = std::move(task); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief publishes the norm column of the field at a specified position
+  //////////////////////////////////////////////////////////////////////////////
+  void publish_norm(size_t field, irs::field_id id) {
+    assert(field < norms_.size());
+    std::lock_guard<std::mutex> lock(mutex_);
+    norms_[field] = id;
+    ready_ = field + 1;
+    cond_.notify_all();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief waits for the norm column of the field at a specified position
+  /// @returns false if the task has failed
+  //////////////////////////////////////////////////////////////////////////////
+  bool wait_norm(size_t field, irs::field_id& id) {
+    run(); // execute inline if not yet picked up by the pool
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (ready_ <= field && !done_) {
+      cond_.wait(lock);
+    }
+
+    if (ready_ <= field) {
+      return false;
+    }
+
+    id = norms_[field];
+    return true;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief waits for the task to finish
+  /// @returns task result
+  //////////////////////////////////////////////////////////////////////////////
+  bool wait() {
+    run(); // execute inline if not yet picked up by the pool
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!done_) {
+      cond_.wait(lock);
+    }
+
+    return result_;
+  }
+
+ private:
+  std::atomic<bool> claimed_{ false };
+  std::condition_variable cond_;
+  std::mutex mutex_;
+  std::vector<irs::field_id> norms_; // norm columns in the order of fields
+  size_t ready_{}; // number of published norm columns
+  task_f task_;
+  bool done_{ false };
+  bool result_{ false };
+}; // columnstore_task
+
 NS_END // LOCAL
 
 NS_ROOT
 
-merge_writer::merge_writer(directory& dir, const string_ref& name) NOEXCEPT
-  : dir_(dir), name_(name) {
+merge_writer::merge_writer(
+    directory& dir,
+    const string_ref& name,
+    async_utils::thread_pool* pool /*= nullptr*/
+) NOEXCEPT
+  : dir_(dir), name_(name), pool_(pool) {
 }
 
 void merge_writer::add(const sub_reader& reader) {
   readers_.emplace_back(&reader);
 }
 
+void merge_writer::reorder(const sort_key_f& key) {
+  sort_key_ = key;
+  bisect_field_.clear();
+  sort_.clear();
+}
+
+void merge_writer::reorder(const string_ref& field) {
+  sort_key_ = nullptr;
+  bisect_field_.assign(field.c_str(), field.size());
+  sort_.clear();
+}
+
+void merge_writer::sort(const string_ref& column) {
+  struct column_key {
+    std::string column;
+    const sub_reader* reader{};
+    columnstore_reader::values_reader_f values;
+  };
+
+  auto state = std::make_shared<column_key>();
+  state->column.assign(column.c_str(), column.size());
+
+  // values are prefixed by a marker, so documents without a value go last
+  reorder([state](const sub_reader& reader, doc_id_t doc, bstring& key) {
+    if (state->reader != &reader) {
+      auto* column = reader.column_reader(state->column);
+
+      state->reader = &reader;
+      state->values = column ? column->values() : columnstore_reader::empty_reader();
+    }
+
+    bytes_ref value;
+
+    if (!state->values(doc, value)) {
+      key.assign(1, byte_type(1));
+      return;
+    }
+
+    key.assign(1, byte_type(0));
+    key.append(value.c_str(), value.size());
+  });
+
+  sort_.assign(column.c_str(), column.size());
+}
+
+doc_id_t merge_writer::doc_id(size_t reader, doc_id_t doc) const NOEXCEPT {
+  if (reader >= doc_maps_.size() || doc >= doc_maps_[reader].size()) {
+    return type_limits<type_t::doc_id_t>::invalid();
+  }
+
+  const auto mapped = doc_maps_[reader][doc];
+
+  return MASKED_DOC_ID == mapped ? type_limits<type_t::doc_id_t>::invalid() : mapped;
+}
+
 bool merge_writer::flush(std::string& filename, segment_meta& meta) {
   REGISTER_TIMER_DETAILED();
-  // reader with map of old doc_id to new doc_id
-  typedef std::pair<const irs::sub_reader*, doc_id_map_t> reader_t;
-
   std::unordered_map<irs::string_ref, const irs::field_meta*> field_metas;
   compound_field_iterator fields_itr;
+  compound_field_iterator norms_itr; // fields iterator used by columnstore task
   compound_column_iterator_t columns_itr;
   irs::flags fields_features;
   doc_id_t next_id = type_limits<type_t::doc_id_t>::min(); // next valid doc_id
@@ -845,33 +1551,118 @@ bool merge_writer::flush(std::string& filename, segment_meta& meta) {
 
     fields_itr.add(*reader, doc_id_map);
     columns_itr.add(*reader, doc_id_map);
+
+    if (pool_) {
+      norms_itr.add(*reader, doc_id_map);
+    }
   }
 
   meta.docs_count = next_id - type_limits<type_t::doc_id_t>::min(); // total number of doc_ids
+  meta.sort = sort_;
+
+  //...........................................................................
+  // reorder documents of the merged segment
+  //...........................................................................
+
+  const bool reorder = sort_key_ || !bisect_field_.empty();
+
+  if (reorder) {
+    // iterators reference the maps, so they may be updated in place
+    remap_doc_ids(
+      readers,
+      sort_key_
+        ? sort_doc_ids(readers, meta.docs_count, sort_key_)
+        : bisect_doc_ids(readers, meta.docs_count, bisect_field_)
+    );
+    fields_itr.sort_postings();
+  }
 
   //...........................................................................
   // write merged segment data
   //...........................................................................
 
   tracking_directory track_dir(dir_); // track writer created files
-  columnstore cs(track_dir, meta);
+  tracking_directory track_cs_dir(dir_); // track columnstore created files
+  columnstore cs(track_cs_dir, meta);
 
   if (!cs) {
     return false; // flush failure
   }
 
-  // write columns
-  if (!write_columns(cs, track_dir, meta, columns_itr)) {
-    return false; // flush failure
+  if (reorder) {
+    cs.sort_values();
   }
 
-  // write field meta and field term data
-  if (!write(cs, track_dir, meta, fields_itr, field_metas, fields_features)) {
-    return false; // flush failure
+  if (!pool_) {
+    // write columns
+    if (!write_columns(cs, track_cs_dir, meta, columns_itr)) {
+      return false; // flush failure
+    }
+
+    auto norms = [&cs](
+        size_t, compound_field_iterator& field_itr, irs::field_id& norm) {
+      norm = write_norms(cs, field_itr);
+      return true;
+    };
+
+    // write field meta and field term data
+    if (!write(track_dir, meta, fields_itr, field_metas, fields_features, norms)) {
+      return false; // flush failure
+    }
+  } else {
+    // shared with the pool since the task may outlive this call if the
+    // caller has already executed it inline
+    auto task = std::make_shared<columnstore_task>(field_metas.size());
+
+    task->task([&cs, &track_cs_dir, &meta, &columns_itr, &norms_itr](
+        columnstore_task& task) {
+      // write columns
+      if (!write_columns(cs, track_cs_dir, meta, columns_itr)) {
+        return false;
+      }
+
+      // write norms in the same order as the fields are written
+      for (size_t i = 0; norms_itr.next(); ++i) {
+        task.publish_norm(i, write_norms(cs, norms_itr));
+      }
+
+      return true;
+    });
+
+    if (!pool_->run([task]()->void { task->run(); })) {
+      task->run(); // pool is not active, execute inline
+    }
+
+    auto norms = [&task](
+        size_t i, compound_field_iterator&, irs::field_id& norm) {
+      return task->wait_norm(i, norm);
+    };
+
+    // write field meta and field term data
+    bool result = false;
+
+    try {
+      result = write(track_dir, meta, fields_itr, field_metas, fields_features, norms);
+    } catch (...) {
+      task->wait(); // columnstore task references local state
+      throw;
+    }
+
+    if (!task->wait() || !result) {
+      return false; // flush failure
+    }
   }
 
   meta.column_store = cs.flush();
 
+  // merge files created by the columnstore and the field writers
+  tracking_directory::file_set cs_files;
+
+  if (!track_cs_dir.swap_tracked(cs_files)) {
+    IR_FRMT_ERROR("Failed to swap list of tracked files in: %s", __FUNCTION__);
+    return false;
+  }
+
   // ...........................................................................
   // write segment meta
   // ...........................................................................
@@ -880,6 +1671,8 @@ bool merge_writer::flush(std::string& filename, segment_meta& meta) {
     return false;
   }
 
+  meta.files.insert(cs_files.begin(), cs_files.end());
+
   auto writer = meta.codec->get_segment_meta_writer();
 
   writer->write(dir_, meta);
@@ -889,6 +1682,11 @@ bool merge_writer::flush(std::string& filename, segment_meta& meta) {
   // finish/cleanup
   // ...........................................................................
   readers_.clear();
+  doc_maps_.clear();
+
+  for (auto& reader : readers) {
+    doc_maps_.emplace_back(std::move(reader.second));
+  }
 
   return true;
 }
@@ -24,6 +24,7 @@
 #ifndef IRESEARCH_MERGE_WRITER_H
 #define IRESEARCH_MERGE_WRITER_H
 
+#include <functional>
 #include <vector>
 
 #include "utils/memory.hpp"
@@ -38,18 +39,75 @@ typedef std::shared_ptr<format> format_ptr;
 struct segment_meta;
 struct sub_reader;
 
+NS_BEGIN(async_utils)
+class thread_pool;
+NS_END
+
 class IRESEARCH_API merge_writer: public util::noncopyable {
  public:
   DECLARE_PTR(merge_writer);
-  merge_writer(directory& dir, const string_ref& seg_name) NOEXCEPT;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief produces an ordering key of a live document of a merged reader,
+  ///        documents of the merged segment are ordered by their keys
+  ///        lexicographically, documents with equal keys keep their relative
+  ///        order
+  //////////////////////////////////////////////////////////////////////////////
+  typedef std::function<void(const sub_reader& reader, doc_id_t doc, bstring& key)> sort_key_f;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// @param pool if specified, the columnstore (columns and norms) is merged
+  ///        on the pool concurrently with the terms dictionary and postings,
+  ///        the resulting segment is the same as the one merged sequentially
+  ////////////////////////////////////////////////////////////////////////////
+  merge_writer(
+    directory& dir,
+    const string_ref& seg_name,
+    async_utils::thread_pool* pool = nullptr
+  ) NOEXCEPT;
   void add(const sub_reader& reader);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief order documents of the merged segment by the specified key
+  ///        instead of concatenating the merged readers
+  //////////////////////////////////////////////////////////////////////////////
+  void reorder(const sort_key_f& key);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief order documents of the merged segment by recursive graph bisection
+  ///        over the terms of the specified field, i.e. documents sharing
+  ///        terms are clustered together which yields smaller gaps between
+  ///        doc_ids in postings
+  /// @note requires postings of all merged documents to fit in memory
+  //////////////////////////////////////////////////////////////////////////////
+  void reorder(const string_ref& field);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief order documents of the merged segment by the values of the
+  ///        specified column (lexicographically, documents without a value
+  ///        go last), the merged segment is marked as sorted by the column
+  //////////////////////////////////////////////////////////////////////////////
+  void sort(const string_ref& column);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns doc_id in the segment written by the last successful flush()
+  ///          of the document 'doc' of the reader added at position 'reader',
+  ///          invalid doc_id if the document has been dropped
+  //////////////////////////////////////////////////////////////////////////////
+  doc_id_t doc_id(size_t reader, doc_id_t doc) const NOEXCEPT;
+
   bool flush(std::string& filename, segment_meta& meta); // return merge successful
 
  private:
   IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
   directory& dir_;
   string_ref name_;
+  async_utils::thread_pool* pool_;
   std::vector<const iresearch::sub_reader*> readers_;
+  sort_key_f sort_key_; // order documents by key if set
+  std::string bisect_field_; // order documents by bisection if not empty
+  std::string sort_; // column the merged segment is sorted by
+  std::vector<std::vector<doc_id_t>> doc_maps_; // doc_ids of the last flush()
   IRESEARCH_API_PRIVATE_VARIABLES_END
 };
 
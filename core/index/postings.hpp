@@ -73,6 +73,16 @@ class IRESEARCH_API postings: util::noncopyable {
 
   inline size_t size() const { return map_.size(); }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns approximate number of bytes occupied by the postings map,
+  ///          term values are accounted by the underlying byte pool
+  //////////////////////////////////////////////////////////////////////////////
+  size_t memory() const NOEXCEPT {
+    // every node holds a value, a pointer to the next node and a cached hash
+    return map_.size()*(sizeof(map_t::value_type) + 2*sizeof(void*))
+      + map_.bucket_count()*sizeof(void*);
+  }
+
  private:
   IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
   map_t map_;
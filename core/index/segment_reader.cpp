@@ -26,6 +26,7 @@
 
 #include "index/index_meta.hpp"
 
+#include "analysis/token_attributes.hpp"
 #include "formats/format_utils.hpp"
 #include "utils/index_utils.hpp"
 #include "utils/singleton.hpp"
@@ -61,29 +62,17 @@ class mask_doc_iterator final : public irs::doc_iterator {
   explicit mask_doc_iterator(
       irs::doc_iterator::ptr&& it,
       const irs::document_mask& mask) NOEXCEPT
-    : mask_(mask), it_(std::move(it))  {
+    : mask_(mask), it_(std::move(it)), attrs_(it_->attributes()) {
+    attrs_.remove<irs::doc_bitset>(); // bitset would include masked documents
   }
 
   virtual bool next() override {
-    while (it_->next()) {
-      if (mask_.find(value()) == mask_.end()) {
-        return true;
-      }
-    }
-
-    return false;
+    return it_->next()
+      && !irs::type_limits<irs::type_t::doc_id_t>::eof(skip(value()));
   }
 
   virtual irs::doc_id_t seek(irs::doc_id_t target) override {
-    const auto doc = it_->seek(target);
-
-    if (mask_.find(doc) == mask_.end()) {
-      return doc;
-    }
-
-    next();
-
-    return value();
+    return skip(it_->seek(target));
   }
 
   virtual irs::doc_id_t value() const override {
@@ -91,12 +80,22 @@ class mask_doc_iterator final : public irs::doc_iterator {
   }
 
   virtual const irs::attribute_view& attributes() const NOEXCEPT override {
-    return it_->attributes();
+    return attrs_;
   }
 
  private:
+  // skip a whole run of excluded documents at once
+  irs::doc_id_t skip(irs::doc_id_t doc) {
+    while (mask_.contains(doc)) {
+      doc = it_->seek(mask_.skip(doc));
+    }
+
+    return doc;
+  }
+
   const irs::document_mask& mask_; // excluded document ids
   irs::doc_iterator::ptr it_;
+  irs::attribute_view attrs_; // attributes of 'it_' except for 'doc_bitset'
 }; // mask_doc_iterator
 
 class masked_docs_iterator 
@@ -117,12 +116,11 @@ class masked_docs_iterator
   virtual ~masked_docs_iterator() {}
 
   virtual bool next() override {
-    while (next_ < end_) {
-      current_ = next_++;
+    next_ = docs_mask_.skip(next_);
 
-      if (docs_mask_.find(current_) == docs_mask_.end()) {
-        return true;
-      }
+    if (next_ < end_) {
+      current_ = next_++;
+      return true;
     }
 
     current_ = iresearch::type_limits<iresearch::type_t::doc_id_t>::eof();
@@ -258,6 +256,10 @@ class segment_reader_impl : public sub_reader {
     field_id field
   ) const override;
 
+  virtual string_ref sort() const NOEXCEPT override {
+    return sort_;
+  }
+
  private:
   DECLARE_SPTR(segment_reader_impl); // required for NAMED_PTR(...)
   std::vector<column_meta> columns_;
@@ -269,6 +271,7 @@ class segment_reader_impl : public sub_reader {
   std::vector<column_meta*> id_to_column_;
   uint64_t meta_version_;
   std::unordered_map<hashed_string_ref, column_meta*> name_to_column_;
+  std::string sort_; // column documents are ordered by
 
   segment_reader_impl(
     const directory& dir,
@@ -396,6 +399,7 @@ sub_reader::docs_iterator_t::ptr segment_reader_impl::docs_iterator() const {
   PTR_NAMED(segment_reader_impl, reader, dir, meta.version, meta.docs_count);
 
   index_utils::read_document_mask(reader->docs_mask_, dir, meta);
+  reader->sort_ = meta.sort;
 
   auto& codec = *meta.codec;
   auto field_reader = codec.get_field_reader();
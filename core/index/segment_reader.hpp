@@ -112,6 +112,10 @@ class IRESEARCH_API segment_reader final
     return impl_->column_reader(field);
   }
 
+  virtual string_ref sort() const NOEXCEPT override {
+    return impl_->sort();
+  }
+
  private:
   typedef std::shared_ptr<sub_reader> impl_ptr;
 
@@ -57,7 +57,13 @@ segment_writer::segment_writer(directory& dir) NOEXCEPT
 // expect 0-based doc_id
 bool segment_writer::remove(doc_id_t doc_id) {
   return doc_id < docs_cached()
-    && docs_mask_.insert(type_limits<type_t::doc_id_t>::min() + doc_id).second;
+    && docs_mask_.insert(type_limits<type_t::doc_id_t>::min() + doc_id);
+}
+
+size_t segment_writer::memory() const NOEXCEPT {
+  return fields_.memory()
+    + docs_context_.capacity()*sizeof(update_context)
+    + static_cast<const bitset&>(docs_mask_).words()*sizeof(bitset::word_t);
 }
 
 bool segment_writer::index(
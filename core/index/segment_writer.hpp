@@ -50,10 +50,22 @@ class IRESEARCH_API segment_writer: util::noncopyable {
   void begin(const update_context& ctx) {
     valid_ = true;
     norm_fields_.clear(); // clear norm fields
-    docs_mask_.reserve(docs_mask_.size() + 1); // reserve space for potential rollback
+    docs_mask_.reserve(docs_cached() + type_limits<type_t::doc_id_t>::min()); // reserve space for potential rollback
     docs_context_.emplace_back(ctx);
   }
 
+  // reserves space for 'count' more documents
+  void reserve(size_t count) {
+    if (!count) {
+      return; // nothing to reserve
+    }
+
+    docs_context_.reserve(docs_context_.size() + count);
+    docs_mask_.reserve(doc_id_t(
+      docs_cached() + count - 1 + type_limits<type_t::doc_id_t>::min()
+    ));
+  }
+
   // adds stored document field
   template<typename Field>
   bool store(Field& field) {
@@ -98,6 +110,18 @@ class IRESEARCH_API segment_writer: util::noncopyable {
   const update_context& doc_context() const { return docs_context_.back(); }
   const document_mask& docs_mask() NOEXCEPT { return docs_mask_; }
   bool initialized() const NOEXCEPT { return initialized_; }
+
+  // returns approximate number of bytes occupied by the buffered documents
+  size_t memory() const NOEXCEPT;
+
+  // moves per-document state of the flushed segment to the caller, it's
+  // required for applying modifications to the segment later on,
+  // writer must be reset afterwards
+  void release(update_contexts& docs_context, document_mask& docs_mask) NOEXCEPT {
+    docs_context = std::move(docs_context_);
+    docs_mask = std::move(docs_mask_);
+  }
+
   bool remove(doc_id_t doc_id); // expect 0-based doc_id
   bool valid() const NOEXCEPT { return valid_; }
   void reset();
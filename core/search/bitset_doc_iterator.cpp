@@ -38,15 +38,7 @@ bitset_doc_iterator::bitset_doc_iterator(
    size_(set.size()) {
   auto docs_count = set.count();
 
-  // make doc_id accessible via attribute
-  attrs_.emplace(doc_);
-  doc_.value = docs_count
-    ? type_limits<type_t::doc_id_t>::invalid()
-    : type_limits<type_t::doc_id_t>::eof() // seal iterator
-    ;
-
-  // set estimation value
-  estimate(docs_count);
+  init(docs_count);
 
   // set scorers
   scorers_ = ord_->prepare_scorers(
@@ -61,6 +53,30 @@ bitset_doc_iterator::bitset_doc_iterator(
   });
 }
 
+bitset_doc_iterator::bitset_doc_iterator(const bitset& set)
+  : doc_iterator_base(order::prepared::unordered()),
+    begin_(set.begin()), end_(set.end()),
+    size_(set.size()) {
+  init(set.count());
+}
+
+void bitset_doc_iterator::init(size_t docs_count) {
+  // make doc_id accessible via attribute
+  attrs_.emplace(doc_);
+  doc_.value = docs_count
+    ? type_limits<type_t::doc_id_t>::invalid()
+    : type_limits<type_t::doc_id_t>::eof() // seal iterator
+    ;
+
+  // expose the underlying words
+  bits_.begin = begin_;
+  bits_.end = end_;
+  attrs_.emplace(bits_);
+
+  // set estimation value
+  estimate(docs_count);
+}
+
 bool bitset_doc_iterator::next() NOEXCEPT {
   return !type_limits<type_t::doc_id_t>::eof(
     seek(doc_.value + irs::doc_id_t(doc_.value < size_))
@@ -25,6 +25,7 @@
 #define IRESEARCH_BITSET_DOC_ITERATOR_H
 
 #include "cost.hpp"
+#include "analysis/token_attributes.hpp"
 #include "search/score_doc_iterators.hpp"
 #include "utils/type_limits.hpp"
 #include "utils/bitset.hpp"
@@ -40,18 +41,75 @@ class bitset_doc_iterator final: public doc_iterator_base, util::noncopyable {
     const order::prepared& order
   );
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief unscored iterator over the specified 'set'
+  //////////////////////////////////////////////////////////////////////////////
+  explicit bitset_doc_iterator(const bitset& set);
+
   virtual bool next() NOEXCEPT override;
   virtual doc_id_t seek(doc_id_t target) NOEXCEPT override;
   virtual doc_id_t value() const NOEXCEPT override { return doc_.value; }
 
  private:
+  void init(size_t docs_count);
+
   document doc_;
+  doc_bitset bits_;
   const bitset::word_t* begin_;
   const bitset::word_t* end_;
   order::prepared::scorers scorers_;
   size_t size_;
 }; // bitset_doc_iterator
 
+//////////////////////////////////////////////////////////////////////////////
+/// @brief replaces the iterators exposing 'doc_bitset' with a single iterator
+///        over the word-wise union (Intersect == false) or intersection
+///        (Intersect == true) of their postings, does nothing if there are
+///        less than 2 such iterators
+/// @param itrs not yet positioned iterators
+/// @param buf storage for the combined postings, must outlive 'itrs'
+//////////////////////////////////////////////////////////////////////////////
+template<bool Intersect, typename Iterators>
+void combine_doc_bitsets(Iterators& itrs, bitset& buf) {
+  typedef typename Iterators::value_type iterator_t;
+
+  const auto bitsets_end = std::partition(
+    itrs.begin(), itrs.end(),
+    [](const iterator_t& it) {
+      return bool(it->attributes().template get<doc_bitset>());
+  });
+
+  if (std::distance(itrs.begin(), bitsets_end) < 2) {
+    return; // nothing to combine
+  }
+
+  // the union spans up to the last word among the sets,
+  // the intersection up to the first set end
+  size_t words = Intersect ? integer_traits<size_t>::const_max : 0;
+
+  for (auto it = itrs.begin(); it != bitsets_end; ++it) {
+    auto& bits = *(*it)->attributes().template get<doc_bitset>();
+    const size_t end = bits.offset + std::distance(bits.begin, bits.end);
+
+    words = Intersect ? (std::min)(words, end) : (std::max)(words, end);
+  }
+
+  buf.reset(bitset::bit_offset(words));
+
+  for (auto it = itrs.begin(); it != bitsets_end; ++it) {
+    auto& bits = *(*it)->attributes().template get<doc_bitset>();
+
+    if (Intersect && it != itrs.begin()) {
+      buf.intersect(bits.offset, bits.begin, bits.end);
+    } else {
+      buf.unite(bits.offset, bits.begin, bits.end);
+    }
+  }
+
+  itrs.erase(itrs.begin(), bitsets_end);
+  itrs.emplace_back(doc_iterator::make<bitset_doc_iterator>(buf));
+}
+
 NS_END // ROOT
 
 #endif // IRESEARCH_BITSET_DOC_ITERATOR_H
@@ -0,0 +1,294 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_BLOCK_MAX_DISJUNCTION_H
+#define IRESEARCH_BLOCK_MAX_DISJUNCTION_H
+
+#include "conjunction.hpp"
+#include "utils/type_limits.hpp"
+#include "index/iterators.hpp"
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class block_max_disjunction
+/// @brief scoring disjunction implementing block-max WAND dynamic pruning,
+///        every sub-iterator is expected to expose 'max_score' attribute.
+///        Until the consumer sets 'score_threshold' attribute the iterator
+///        behaves like an ordinary disjunction, after that it skips documents
+///        (and whole blocks of documents) which can't get a score better than
+///        or equal to the threshold.
+///-----------------------------------------------------------------------------
+///   [0]       <-- cursors sorted by current document
+///   ...          |
+///   [pivot]   <-- first cursor the upper bounds of the preceding ones
+///   ...           (inclusively) are summed up to a competitive score
+///   [n-1]
+///-----------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+class block_max_disjunction final : public doc_iterator_base {
+ public:
+  typedef score_iterator_adapter doc_iterator_t;
+  typedef std::vector<doc_iterator_t> doc_iterators_t;
+
+  block_max_disjunction(
+      doc_iterators_t&& itrs,
+      const order::prepared& ord,
+      cost::cost_t est)
+    : block_max_disjunction(std::move(itrs), ord, resolve_overload_tag()) {
+    // estimate disjunction
+    estimate(est);
+  }
+
+  block_max_disjunction(
+      doc_iterators_t&& itrs,
+      const order::prepared& ord)
+    : block_max_disjunction(std::move(itrs), ord, resolve_overload_tag()) {
+    // estimate disjunction
+    estimate([this](){
+      return std::accumulate(
+        cursors_.begin(), cursors_.end(), cost::cost_t(0),
+        [](cost::cost_t lhs, const cursor& rhs) {
+          return lhs + cost::extract(rhs.it->attributes(), 0);
+      });
+    });
+  }
+
+  virtual doc_id_t value() const override {
+    return doc_;
+  }
+
+  virtual bool next() override {
+    if (type_limits<type_t::doc_id_t>::eof(doc_)) {
+      return false;
+    }
+
+    // all cursors are positioned not before the current document
+    for (auto& cursor : cursors_) {
+      if (cursor.it->value() > doc_) {
+        break;
+      }
+
+      cursor.it->next();
+    }
+
+    refresh();
+
+    return !type_limits<type_t::doc_id_t>::eof(find());
+  }
+
+  virtual doc_id_t seek(doc_id_t target) override {
+    if (target <= doc_ || type_limits<type_t::doc_id_t>::eof(doc_)) {
+      return doc_;
+    }
+
+    for (auto& cursor : cursors_) {
+      if (cursor.it->value() >= target) {
+        break;
+      }
+
+      cursor.it->seek(target);
+    }
+
+    refresh();
+
+    return find();
+  }
+
+ private:
+  struct resolve_overload_tag{};
+
+  struct cursor {
+    cursor(doc_iterator_t&& it, size_t idx) NOEXCEPT
+      : it(std::move(it)), idx(idx) {
+      bound = this->it->attributes().get<irs::max_score>().get();
+      assert(bound);
+    }
+
+    doc_id_t value() const {
+      return it->value();
+    }
+
+    doc_iterator_t it;
+    const irs::max_score* bound;
+    size_t idx; // index of the sub-iterator, determines scoring order
+  }; // cursor
+
+  block_max_disjunction(
+      doc_iterators_t&& itrs,
+      const order::prepared& ord,
+      resolve_overload_tag)
+    : doc_iterator_base(ord),
+      doc_(type_limits<type_t::doc_id_t>::invalid()) {
+    assert(!ord_->empty());
+
+    cursors_.reserve(itrs.size());
+    for (auto& it : itrs) {
+      cursors_.emplace_back(std::move(it), cursors_.size());
+    }
+
+    acc_.resize(ord_->size());
+    block_.resize(ord_->size());
+    tmp_.resize(ord_->size());
+
+    attrs_.emplace(threshold_);
+
+    // prepare score
+    prepare_score([this](byte_type* score) {
+      ord_->prepare_score(score);
+
+      for (auto& cursor : cursors_) {
+        if (cursor.value() != doc_) {
+          break;
+        }
+
+        cursor.it.score->evaluate();
+        ord_->add(score, cursor.it.score->c_str());
+      }
+    });
+  }
+
+  bool competitive(const byte_type* score) const {
+    return !ord_->less(threshold_.c_str(), score);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief restores cursors order after some of them were moved forward,
+  ///        exhausted cursors are removed
+  //////////////////////////////////////////////////////////////////////////////
+  void refresh() {
+    // insertion sort since only a few cursors are usually out of order
+    for (auto begin = cursors_.begin(), it = begin, end = cursors_.end();
+         it != end; ++it) {
+      for (auto prev = it; prev != begin && less(*prev, *(prev - 1)); --prev) {
+        std::swap(*prev, *(prev - 1));
+      }
+    }
+
+    while (!cursors_.empty()
+           && type_limits<type_t::doc_id_t>::eof(cursors_.back().value())) {
+      cursors_.pop_back();
+    }
+  }
+
+  static bool less(const cursor& lhs, const cursor& rhs) {
+    const auto lhs_doc = lhs.value(), rhs_doc = rhs.value();
+    return lhs_doc < rhs_doc || (lhs_doc == rhs_doc && lhs.idx < rhs.idx);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief moves the cursors to the first document which may be competitive
+  //////////////////////////////////////////////////////////////////////////////
+  doc_id_t find() {
+    for (;;) {
+      if (cursors_.empty()) {
+        return doc_ = type_limits<type_t::doc_id_t>::eof();
+      }
+
+      const auto min_doc = cursors_.front().value();
+
+      if (threshold_.empty()) {
+        return doc_ = min_doc;
+      }
+
+      // find pivot using upper bounds of the whole posting lists
+      const size_t size = cursors_.size();
+      size_t pivot = 0;
+
+      ord_->prepare_score(&acc_[0]);
+      for (; pivot < size; ++pivot) {
+        ord_->add(&acc_[0], cursors_[pivot].bound->c_str());
+
+        if (competitive(acc_.c_str())) {
+          break;
+        }
+      }
+
+      if (pivot == size) {
+        // threshold can only grow, no more competitive documents
+        cursors_.clear();
+        return doc_ = type_limits<type_t::doc_id_t>::eof();
+      }
+
+      const auto pivot_doc = cursors_[pivot].value();
+
+      // all cursors positioned at the pivot document contribute to its score
+      while (pivot + 1 < size && cursors_[pivot + 1].value() == pivot_doc) {
+        ++pivot;
+      }
+
+      // refine the upper bound using block data
+      auto up_to = type_limits<type_t::doc_id_t>::eof();
+
+      ord_->prepare_score(&block_[0]);
+      for (size_t i = 0; i <= pivot; ++i) {
+        up_to = std::min(
+          up_to, cursors_[i].bound->seek(pivot_doc, &tmp_[0])
+        );
+        ord_->add(&block_[0], tmp_.c_str());
+      }
+
+      if (competitive(block_.c_str())) {
+        if (min_doc == pivot_doc) {
+          return doc_ = pivot_doc;
+        }
+
+        // move lagging cursors to the pivot document
+        for (size_t i = 0; i <= pivot && cursors_[i].value() < pivot_doc; ++i) {
+          cursors_[i].it->seek(pivot_doc);
+        }
+      } else {
+        // none of the documents up to the end of the shortest block (or the
+        // first document of the cursors after the pivot) can be competitive
+        auto target = pivot + 1 < size
+          ? cursors_[pivot + 1].value()
+          : type_limits<type_t::doc_id_t>::eof();
+
+        if (!type_limits<type_t::doc_id_t>::eof(up_to)) {
+          target = std::min(target, up_to + 1);
+        }
+
+        if (type_limits<type_t::doc_id_t>::eof(target)) {
+          cursors_.clear();
+          return doc_ = target;
+        }
+
+        for (size_t i = 0; i <= pivot; ++i) {
+          cursors_[i].it->seek(target);
+        }
+      }
+
+      refresh();
+    }
+  }
+
+  std::vector<cursor> cursors_;
+  irs::score_threshold threshold_;
+  bstring acc_; // sum of the upper bounds of the posting lists
+  bstring block_; // sum of the upper bounds of the blocks
+  bstring tmp_;
+  doc_id_t doc_;
+}; // block_max_disjunction
+
+NS_END // ROOT
+
+#endif // IRESEARCH_BLOCK_MAX_DISJUNCTION_H
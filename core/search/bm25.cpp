@@ -211,10 +211,12 @@ class scorer : public iresearch::sort::scorer_base<bm25::score_t> {
       float_t k, 
       iresearch::boost::boost_t boost,
       const bm25::stats* stats,
-      const frequency* freq)
+      const frequency* freq,
+      bool reverse)
     : freq_(freq ? freq : &EMPTY_FREQ),
       num_(boost * (k + 1) * (stats ? stats->idf : 1.f)),
-      norm_const_(k) {
+      norm_const_(k),
+      reverse_(reverse) {
     assert(freq_);
   }
 
@@ -223,6 +225,18 @@ class scorer : public iresearch::sort::scorer_base<bm25::score_t> {
     score_cast(score_buf) = num_ * freq / (norm_const_ + freq);
   }
 
+  virtual bool bound(uint64_t freq, byte_type* score_buf) const override {
+    // score grows along with the term frequency, hence the bound
+    // is the best score only in case if greater scores go first
+    if (!reverse_ || num_ < 0.f || norm_const_ < 0.f) {
+      return false;
+    }
+
+    const float_t tf = float_t(std::sqrt(freq));
+    score_cast(score_buf) = num_ * tf / (norm_const_ + tf);
+    return true;
+  }
+
  protected:
   FORCE_INLINE float_t tf() const {
     return float_t(std::sqrt(freq_->value));
@@ -231,6 +245,7 @@ class scorer : public iresearch::sort::scorer_base<bm25::score_t> {
   const frequency* freq_; // document frequency
   float_t num_; // partially precomputed numerator : boost * (k + 1) * idf
   float_t norm_const_; // 'k' factor
+  bool reverse_; // greater scores go first
 }; // scorer
 
 class norm_scorer final : public scorer {
@@ -242,8 +257,9 @@ class norm_scorer final : public scorer {
       iresearch::boost::boost_t boost,
       const bm25::stats* stats,
       const frequency* freq,
-      const iresearch::norm* norm)
-    : scorer(k, boost, stats, freq),
+      const iresearch::norm* norm,
+      bool reverse)
+    : scorer(k, boost, stats, freq, reverse),
       norm_(norm) {
     assert(norm_);
 
@@ -259,6 +275,11 @@ class norm_scorer final : public scorer {
     score_cast(score_buf) = num_ * freq / (norm_const_ + norm_length_ * norm_->read() + freq);
   }
 
+  virtual bool bound(uint64_t freq, byte_type* score_buf) const override {
+    // norm is not negative, so the length part only decreases the score
+    return norm_length_ >= 0.f && scorer::bound(freq, score_buf);
+  }
+
  private:
   const iresearch::norm* norm_;
   float_t norm_length_{ 0.f }; // precomputed 'k*b/avgD' if norms presetn, '0' otherwise
@@ -332,7 +353,8 @@ class sort final : iresearch::sort::prepared_base<bm25::score_t> {
   sort(float_t k, float_t b, bool normalize, bool reverse)
     : k_(k),
       b_(b),
-      normalize_(normalize) {
+      normalize_(normalize),
+      reverse_(reverse) {
     static const std::function<bool(score_t, score_t)> greater = std::greater<score_t>();
     static const std::function<bool(score_t, score_t)> less = std::less<score_t>();
     less_ = reverse ? &greater : &less;
@@ -369,7 +391,8 @@ class sort final : iresearch::sort::prepared_base<bm25::score_t> {
         boost::extract(query_attrs),
         query_attrs.get<bm25::stats>().get(),
         doc_attrs.get<frequency>().get(),
-        &*norm
+        &*norm,
+        reverse_
       );
     }
 
@@ -377,7 +400,8 @@ class sort final : iresearch::sort::prepared_base<bm25::score_t> {
       k_, 
       boost::extract(query_attrs),
       query_attrs.get<bm25::stats>().get(),
-      doc_attrs.get<frequency>().get()
+      doc_attrs.get<frequency>().get(),
+      reverse_
     );
   }
 
@@ -394,6 +418,7 @@ class sort final : iresearch::sort::prepared_base<bm25::score_t> {
   float_t k_;
   float_t b_;
   bool normalize_;
+  bool reverse_;
 }; // sort
 
 NS_END // bm25
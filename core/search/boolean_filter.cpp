@@ -25,6 +25,7 @@
 #include "boolean_filter.hpp"
 #include "conjunction.hpp"
 #include "disjunction.hpp"
+#include "block_max_disjunction.hpp"
 #include "min_match_disjunction.hpp"
 #include "exclusion.hpp"
 #include <boost/functional/hash.hpp>
@@ -77,6 +78,18 @@ irs::doc_iterator::ptr make_disjunction(
     }
   }
 
+  // use dynamic pruning if every sub-iterator is able to bound its score
+  if (!ord.empty() && itrs.size() > 1
+      && std::all_of(
+           itrs.begin(), itrs.end(),
+           [](const irs::disjunction::doc_iterator_t& it) {
+             return bool(it->attributes().get<irs::max_score>());
+      })) {
+    return irs::doc_iterator::make<irs::block_max_disjunction>(
+      std::move(itrs), ord, std::forward<Args>(args)...
+    );
+  }
+
   return irs::make_disjunction<irs::disjunction>(
     std::move(itrs), ord, std::forward<Args>(args)...
   );
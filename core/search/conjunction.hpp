@@ -25,6 +25,7 @@
 #define IRESEARCH_CONJUNCTION_H
 
 #include "cost.hpp"
+#include "bitset_doc_iterator.hpp"
 #include "score_doc_iterators.hpp"
 #include "analysis/token_attributes.hpp"
 #include "utils/type_limits.hpp"
@@ -89,6 +90,12 @@ class conjunction : public doc_iterator_base {
       itrs_(std::move(itrs)) {
     assert(!itrs_.empty());
 
+    // intersect postings stored as bitsets word-wise,
+    // only possible if sub-iterators needn't be scored
+    if (ord_->empty()) {
+      combine_doc_bitsets<true>(itrs_, bits_);
+    }
+
     // sort subnodes in ascending order by their cost
     std::sort(itrs_.begin(), itrs_.end(),
       [](const doc_iterator_t& lhs, const doc_iterator_t& rhs) {
@@ -168,6 +175,7 @@ class conjunction : public doc_iterator_base {
     return target;
   }
 
+  bitset bits_; // intersection of sub-iterators exposing 'doc_bitset'
   doc_iterators_t itrs_;
   irs::doc_iterator* front_;
 }; // conjunction
@@ -271,6 +271,12 @@ class disjunction : public doc_iterator_base {
     // iterators are equal here */
     //assert(irstd::all_equal(itrs_.begin(), itrs_.end()));
 
+    // unite postings stored as bitsets word-wise,
+    // only possible if sub-iterators needn't be scored
+    if (ord_->empty()) {
+      combine_doc_bitsets<false>(itrs_, bits_);
+    }
+
     // prepare score
     prepare_score([this](byte_type* score) {
       ord_->prepare_score(score);
@@ -383,6 +389,7 @@ class disjunction : public doc_iterator_base {
     order.add(dst, score.c_str());
   }
 
+  bitset bits_; // union of sub-iterators exposing 'doc_bitset'
   doc_iterators_t itrs_;
   doc_id_t doc_;
 }; // disjunction
@@ -24,6 +24,7 @@
 #ifndef IRESEARCH_EXCLUSION_H
 #define IRESEARCH_EXCLUSION_H
 
+#include "analysis/token_attributes.hpp"
 #include "index/iterators.hpp"
 
 NS_ROOT
@@ -37,6 +38,8 @@ class exclusion final : public doc_iterator {
     : incl_(std::move(incl)), excl_(std::move(excl)) {
     assert(incl_);
     assert(excl_);
+    attrs_ = attribute_view(incl_->attributes());
+    attrs_.remove<doc_bitset>(); // bitset would include excluded documents
   }
 
   virtual doc_id_t value() const override {
@@ -64,7 +67,7 @@ class exclusion final : public doc_iterator {
   }
 
   virtual const attribute_view& attributes() const NOEXCEPT override {
-    return incl_->attributes();
+    return attrs_;
   }
 
  private:
@@ -94,6 +97,7 @@ class exclusion final : public doc_iterator {
 
   doc_iterator::ptr incl_;
   doc_iterator::ptr excl_;
+  attribute_view attrs_; // attributes of 'incl_' except for 'doc_bitset'
 }; // exclusion
 
 NS_END // ROOT
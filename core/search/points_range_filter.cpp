@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "shared.hpp"
+#include "points_range_filter.hpp"
+#include "bitset_doc_iterator.hpp"
+#include "formats/formats.hpp"
+#include "index/index_reader.hpp"
+#include "utils/bitset.hpp"
+#include "utils/numeric_utils.hpp"
+
+#include <boost/functional/hash.hpp>
+
+NS_LOCAL
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class range_visitor
+/// @brief collects documents of the points within a range into a bitset
+//////////////////////////////////////////////////////////////////////////////
+class range_visitor final : public irs::points_visitor {
+ public:
+  range_visitor(
+      const irs::bytes_ref& min, irs::Bound_Type min_type,
+      const irs::bytes_ref& max, irs::Bound_Type max_type) NOEXCEPT
+    : min_(min), max_(max), min_type_(min_type), max_type_(max_type) {
+  }
+
+  void reset(irs::bitset& docs) NOEXCEPT {
+    docs_ = &docs;
+  }
+
+  virtual relation compare(
+      const irs::bytes_ref& min, const irs::bytes_ref& max) override {
+    if (!above_min(max) || !below_max(min)) {
+      return relation::OUTSIDE;
+    }
+
+    return above_min(min) && below_max(max)
+      ? relation::INSIDE
+      : relation::CROSSES;
+  }
+
+  virtual void visit(irs::doc_id_t doc) override {
+    assert(docs_);
+    docs_->set(doc);
+  }
+
+  virtual void visit(
+      irs::doc_id_t doc, const irs::bytes_ref& value) override {
+    if (above_min(value) && below_max(value)) {
+      visit(doc);
+    }
+  }
+
+  bool above_min(const irs::bytes_ref& value) const NOEXCEPT {
+    switch (min_type_) {
+      case irs::Bound_Type::INCLUSIVE:
+        return min_ <= value;
+      case irs::Bound_Type::EXCLUSIVE:
+        return min_ < value;
+      default:
+        return true;
+    }
+  }
+
+  bool below_max(const irs::bytes_ref& value) const NOEXCEPT {
+    switch (max_type_) {
+      case irs::Bound_Type::INCLUSIVE:
+        return value <= max_;
+      case irs::Bound_Type::EXCLUSIVE:
+        return value < max_;
+      default:
+        return true;
+    }
+  }
+
+ private:
+  irs::bytes_ref min_;
+  irs::bytes_ref max_;
+  irs::Bound_Type min_type_;
+  irs::Bound_Type max_type_;
+  irs::bitset* docs_{};
+}; // range_visitor
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief collects documents of the exact terms within a range, used for
+///        fields without points index
+//////////////////////////////////////////////////////////////////////////////
+void visit_terms(
+    const irs::term_reader& field,
+    const irs::bytes_ref& min,
+    range_visitor& visitor) {
+  auto terms = field.iterator();
+
+  if (min.empty()
+      ? !terms->next()
+      : irs::SeekResult::END == terms->seek_ge(min)) {
+    return;
+  }
+
+  do {
+    const auto& term = terms->value();
+
+    if (!visitor.below_max(term)) {
+      break; // terms are ordered
+    }
+
+    if (irs::numeric_utils::is_exact(term) && visitor.above_min(term)) {
+      auto docs = terms->postings(irs::flags::empty_instance());
+
+      while (docs->next()) {
+        visitor.visit(docs->value());
+      }
+    }
+  } while (terms->next());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class points_range_query
+/// @brief compiled query holding the matched documents of each segment
+//////////////////////////////////////////////////////////////////////////////
+class points_range_query final : public irs::filter::prepared {
+ public:
+  typedef irs::states_cache<irs::bitset> states_t;
+
+  points_range_query(states_t&& states, irs::attribute_store&& attrs)
+    : irs::filter::prepared(std::move(attrs)), states_(std::move(states)) {
+  }
+
+  virtual irs::doc_iterator::ptr execute(
+      const irs::sub_reader& rdr,
+      const irs::order::prepared& ord,
+      const irs::attribute_view& /*ctx*/) const override {
+    const auto* docs = states_.find(rdr);
+
+    if (!docs) {
+      return irs::doc_iterator::empty();
+    }
+
+    return irs::doc_iterator::make<irs::bitset_doc_iterator>(
+      rdr,
+      attributes(), // prepared_filter attributes
+      *docs,
+      ord
+    );
+  }
+
+ private:
+  states_t states_;
+}; // points_range_query
+
+NS_END // NS_LOCAL
+
+NS_ROOT
+
+DEFINE_FILTER_TYPE(by_points_range)
+DEFINE_FACTORY_DEFAULT(by_points_range)
+
+by_points_range::by_points_range() NOEXCEPT
+  : filter(by_points_range::type()) {
+}
+
+bool by_points_range::equals(const filter& rhs) const {
+  const auto& trhs = static_cast<const by_points_range&>(rhs);
+  return filter::equals(rhs) && fld_ == trhs.fld_ && rng_ == trhs.rng_;
+}
+
+size_t by_points_range::hash() const {
+  size_t seed = 0;
+  ::boost::hash_combine(seed, filter::hash());
+  ::boost::hash_combine(seed, fld_);
+  ::boost::hash_combine(seed, rng_.min);
+  ::boost::hash_combine(seed, rng_.min_type);
+  ::boost::hash_combine(seed, rng_.max);
+  ::boost::hash_combine(seed, rng_.max_type);
+  return seed;
+}
+
+filter::prepared::ptr by_points_range::prepare(
+    const index_reader& rdr,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_view& /*ctx*/) const {
+  bytes_ref min = rng_.min;
+  bytes_ref max = rng_.max;
+  auto min_type = rng_.min_type;
+  auto max_type = rng_.max_type;
+
+  // encoded values of a numeric type share the leading byte, open bound is
+  // limited to the values of the same type as the other bound
+  byte_type type_min, type_max;
+
+  if (Bound_Type::UNBOUNDED == min_type
+      && Bound_Type::UNBOUNDED != max_type && !max.empty()) {
+    type_min = max[0];
+    min = bytes_ref(&type_min, 1); // less than any value of the type
+    min_type = Bound_Type::INCLUSIVE;
+  } else if (Bound_Type::UNBOUNDED == max_type
+             && Bound_Type::UNBOUNDED != min_type && !min.empty()) {
+    type_max = min[0] + 1;
+    max = bytes_ref(&type_max, 1); // greater than any value of the type
+    max_type = Bound_Type::EXCLUSIVE;
+  }
+
+  range_visitor visitor(min, min_type, max, max_type);
+  points_range_query::states_t states(rdr.size());
+
+  for (auto& segment : rdr) {
+    const auto* field = segment.field(fld_);
+
+    if (!field) {
+      continue; // no such field in this reader
+    }
+
+    bitset docs((type_limits<type_t::doc_id_t>::min)() + segment.docs_count());
+
+    visitor.reset(docs);
+
+    if (!field->intersect(visitor)) {
+      visit_terms(*field, min, visitor);
+    }
+
+    if (docs.any()) {
+      states.insert(segment) = std::move(docs);
+    }
+  }
+
+  attribute_store attrs;
+
+  // skip field-level/term-level statistics because matches aren't scored by terms
+  ord.prepare_stats().finish(attrs, rdr);
+
+  irs::boost::apply(attrs, this->boost() * boost); // apply boost
+
+  return filter::prepared::make<points_range_query>(
+    std::move(states), std::move(attrs)
+  );
+}
+
+NS_END // ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
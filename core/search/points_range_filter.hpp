@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_POINTS_RANGE_FILTER_H
+#define IRESEARCH_POINTS_RANGE_FILTER_H
+
+#include "range_filter.hpp"
+#include "analysis/token_attributes.hpp"
+#include "analysis/token_streams.hpp"
+
+NS_ROOT
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class by_points_range
+/// @brief user-side numeric range filter evaluated over the points index of
+///        a 'granularity_prefix' field instead of expanding the range into
+///        granular terms, all matched documents get the same score
+///        bounds are exact values as emitted first by 'numeric_token_stream',
+///        an open bound is limited to the numeric type of the other one
+///        NOTE: segments without points index for the field are evaluated
+///              over the exact terms of the field
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API by_points_range : public filter {
+ public:
+  DECLARE_FILTER_TYPE();
+  DECLARE_FACTORY_DEFAULT();
+
+  by_points_range() NOEXCEPT;
+
+  using filter::prepare;
+
+  virtual filter::prepared::ptr prepare(
+    const index_reader& rdr,
+    const order::prepared& ord,
+    boost_t boost,
+    const attribute_view& ctx
+  ) const override;
+
+  by_points_range& field(std::string fld) {
+    fld_ = std::move(fld);
+    return *this;
+  }
+
+  const std::string& field() const {
+    return fld_;
+  }
+
+  template<Bound B>
+  const bstring& term() const {
+    return get<B>::term(rng_);
+  }
+
+  template<Bound B>
+  by_points_range& term(bstring&& term) {
+    get<B>::term(rng_) = std::move(term);
+
+    if (Bound_Type::UNBOUNDED == get<B>::type(rng_)) {
+      get<B>::type(rng_) = Bound_Type::EXCLUSIVE;
+    }
+
+    return *this;
+  }
+
+  template<Bound B>
+  by_points_range& term(const bytes_ref& term) {
+    get<B>::term(rng_) = term;
+
+    if (term.null()) {
+      get<B>::type(rng_) = Bound_Type::UNBOUNDED;
+    } else if (Bound_Type::UNBOUNDED == get<B>::type(rng_)) {
+      get<B>::type(rng_) = Bound_Type::EXCLUSIVE;
+    }
+
+    return *this;
+  }
+
+  // use the most precise term of the stream, i.e. the exact value
+  template<Bound B>
+  by_points_range& term(numeric_token_stream& stream) {
+    auto& term = stream.attributes().get<term_attribute>();
+
+    return stream.next()
+      ? this->term<B>(term->value())
+      : this->term<B>(bytes_ref::nil);
+  }
+
+  template<Bound B>
+  by_points_range& include(bool incl) {
+    get<B>::type(rng_) = incl ? Bound_Type::INCLUSIVE : Bound_Type::EXCLUSIVE;
+    return *this;
+  }
+
+  template<Bound B>
+  bool include() const {
+    return Bound_Type::INCLUSIVE == get<B>::type(rng_);
+  }
+
+  virtual size_t hash() const override;
+
+ protected:
+  virtual bool equals(const filter& rhs) const override;
+
+ private:
+  typedef detail::range<bstring> range_t;
+  template<Bound B> struct get;
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::string fld_;
+  range_t rng_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // by_points_range
+
+template<> struct by_points_range::get<Bound::MIN> {
+  static bstring& term(range_t& rng) { return rng.min; }
+  static const bstring& term(const range_t& rng) { return rng.min; }
+  static Bound_Type& type(range_t& rng) { return rng.min_type; }
+  static const Bound_Type& type(const range_t& rng) { return rng.min_type; }
+}; // get<Bound::MIN>
+
+template<> struct by_points_range::get<Bound::MAX> {
+  static bstring& term(range_t& rng) { return rng.max; }
+  static const bstring& term(const range_t& rng) { return rng.max; }
+  static Bound_Type& type(range_t& rng) { return rng.max_type; }
+  static const Bound_Type& type(const range_t& rng) { return rng.max_type; }
+}; // get<Bound::MAX>
+
+NS_END // ROOT
+
+#endif // IRESEARCH_POINTS_RANGE_FILTER_H
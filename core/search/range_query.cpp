@@ -38,6 +38,14 @@ void set_doc_ids(irs::bitset& buf, const irs::term_iterator& term) {
     return; // no doc_ids in iterator
   }
 
+  auto& bits = itr->attributes().get<irs::doc_bitset>();
+
+  if (bits) {
+    // postings are stored as a bitset, merge them word-wise
+    buf.unite(bits->offset, bits->begin, bits->end);
+    return;
+  }
+
   while(itr->next()) {
     buf.set(itr->value());
   }
@@ -46,4 +46,16 @@ score::score() NOEXCEPT
   : func_([](byte_type*){}) {
 }
 
+// ----------------------------------------------------------------------------
+// --SECTION--                                                        max_score
+// ----------------------------------------------------------------------------
+
+DEFINE_ATTRIBUTE_TYPE(iresearch::max_score);
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                  score_threshold
+// ----------------------------------------------------------------------------
+
+DEFINE_ATTRIBUTE_TYPE(iresearch::score_threshold);
+
 NS_END // ROOT
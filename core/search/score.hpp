@@ -88,6 +88,91 @@ class IRESEARCH_API score : public attribute {
   IRESEARCH_API_PRIVATE_VARIABLES_END
 }; // score
 
+//////////////////////////////////////////////////////////////////////////////
+/// @class max_score
+/// @brief represents an upper bound of the score of the documents within
+///        the block starting at the particular document
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API max_score : public attribute {
+ public:
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief evaluates an upper bound of the scores of the documents within
+  ///        [target, returned doc] into 'score', returns eof() if the bound
+  ///        holds for the rest of the iterator
+  ////////////////////////////////////////////////////////////////////////////
+  typedef std::function<doc_id_t(doc_id_t target, byte_type* score)> seek_f;
+
+  DECLARE_ATTRIBUTE_TYPE();
+
+  max_score() = default;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns upper bound of the score of the whole iterator
+  //////////////////////////////////////////////////////////////////////////////
+  const byte_type* c_str() const {
+    return value_.c_str();
+  }
+
+  const bstring& value() const {
+    return value_;
+  }
+
+  doc_id_t seek(doc_id_t target, byte_type* score) const {
+    assert(func_);
+    return func_(target, score);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns buffer to be filled with the upper bound of the whole iterator
+  //////////////////////////////////////////////////////////////////////////////
+  byte_type* prepare(const order::prepared& ord, seek_f&& func) {
+    value_.resize(ord.size());
+    ord.prepare_score(&value_[0]);
+
+    func_ = std::move(func);
+    return &value_[0];
+  }
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  bstring value_;
+  seek_f func_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // max_score
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class score_threshold
+/// @brief the least competitive score, documents ranked strictly behind it
+///        in terms of order::prepared::less(...) may be skipped by iterator
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API score_threshold : public attribute {
+ public:
+  DECLARE_ATTRIBUTE_TYPE();
+
+  score_threshold() = default;
+
+  const byte_type* c_str() const {
+    return value_.c_str();
+  }
+
+  bool empty() const NOEXCEPT {
+    return value_.empty();
+  }
+
+  void reset(const byte_type* score, size_t size) {
+    value_.assign(score, size);
+  }
+
+  void clear() NOEXCEPT {
+    value_.clear();
+  }
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  bstring value_;
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // score_threshold
+
 NS_END // ROOT
 
 #endif // IRESEARCH_SCORE_H
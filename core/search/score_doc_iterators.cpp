@@ -52,6 +52,13 @@ basic_doc_iterator::basic_doc_iterator(
   // set estimation value
   estimate(estimation);
 
+  // expose postings stored as a bitset for word-wise combining
+  auto& bits = it_->attributes().get<doc_bitset>();
+
+  if (bits) {
+    attrs_.emplace(*bits);
+  }
+
   // set scorers
   scorers_ = ord_->prepare_scorers(
     segment, field, *stats_, it_->attributes()
@@ -60,6 +67,23 @@ basic_doc_iterator::basic_doc_iterator(
   prepare_score([this](byte_type* score) {
     scorers_.score(*ord_, score);
   });
+
+  // set score upper bounds
+  if (!ord_->empty()
+      && (max_freq_ = it_->attributes().get<max_frequency>().get())) {
+    auto* bound = max_score_.prepare(
+      *ord_, [this](doc_id_t target, byte_type* score) {
+        uint64_t freq;
+        const auto doc = max_freq_->seek(target, freq);
+        ord_->prepare_score(score);
+        scorers_.bound(*ord_, freq, score);
+        return doc;
+    });
+
+    if (scorers_.bound(*ord_, max_freq_->value, bound)) {
+      attrs_.emplace(max_score_);
+    }
+  }
 }
 
 #if defined(_MSC_VER)
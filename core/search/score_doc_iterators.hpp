@@ -95,6 +95,8 @@ class basic_doc_iterator final : public doc_iterator_base {
   order::prepared::scorers scorers_;
   doc_iterator::ptr it_;
   const attribute_store* stats_;
+  const max_frequency* max_freq_{};
+  irs::max_score max_score_;
 }; // basic_doc_iterator
 
 NS_END // ROOT
@@ -51,6 +51,10 @@ sort::collector::~collector() { }
 
 sort::scorer::~scorer() { }
 
+bool sort::scorer::bound(uint64_t /*freq*/, byte_type* /*score_buf*/) const {
+  return false;
+}
+
 sort::prepared::prepared(attribute_view&& attrs): attrs_(std::move(attrs)) {
 }
 
@@ -224,6 +228,20 @@ void order::prepared::scorers::score(
   });
 }
 
+bool order::prepared::scorers::bound(
+  const order::prepared& ord, uint64_t freq, byte_type* scr
+) const {
+  size_t i = 0;
+  for (auto& scorer : scorers_) {
+    // score is not changed by a missing scorer
+    if (scorer && !scorer->bound(freq, scr)) {
+      return false;
+    }
+    scr += ord[i++].bucket->size();
+  }
+  return true;
+}
+
 order::prepared::prepared() : size_(0) { }
 
 order::prepared::stats 
@@ -135,6 +135,13 @@ class IRESEARCH_API sort {
     /// @brief set the document score based on the stored state
     ////////////////////////////////////////////////////////////////////////////////
     virtual void score(byte_type* score_buf) = 0;
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief set the best possible score (in terms of prepared::less(...)) of
+    ///        a document with the term frequency not greater than 'freq'
+    /// @returns false if the scorer is unable to bound the score
+    ////////////////////////////////////////////////////////////////////////////////
+    virtual bool bound(uint64_t freq, byte_type* score_buf) const;
   }; // scorer
 
   template <typename T>
@@ -433,6 +440,13 @@ class IRESEARCH_API order final {
 
       void score(const prepared& ord, byte_type* score) const;
 
+      ////////////////////////////////////////////////////////////////////////////////
+      /// @brief set the best possible score of a document with the term
+      ///        frequency not greater than 'freq', 'score' must be prepared
+      /// @returns false if any of the scorers is unable to bound the score
+      ////////////////////////////////////////////////////////////////////////////////
+      bool bound(const prepared& ord, uint64_t freq, byte_type* score) const;
+
      private:
       IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
       scorers_t scorers_;
@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "shared.hpp"
+#include "sorted_collector.hpp"
+#include "index/index_reader.hpp"
+
+#include <algorithm>
+
+NS_ROOT
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                 sorted_collector
+// ----------------------------------------------------------------------------
+
+sorted_collector::sorted_collector(const string_ref& column, size_t k)
+  : column_(column.c_str(), column.size()), k_(k) {
+}
+
+/*static*/ bool sorted_collector::ordered_before(
+    const bytes_ref& lhs, bool lhs_has_value,
+    const bytes_ref& rhs, bool rhs_has_value) NOEXCEPT {
+  if (lhs_has_value != rhs_has_value) {
+    return lhs_has_value; // documents without a value go last
+  }
+
+  return lhs_has_value && lhs < rhs;
+}
+
+/*static*/ bool sorted_collector::ordered_before(
+    const node& lhs,
+    const node& rhs) NOEXCEPT {
+  const bytes_ref lhs_value = lhs.value;
+  const bytes_ref rhs_value = rhs.value;
+
+  if (ordered_before(lhs_value, lhs.has_value, rhs_value, rhs.has_value)) {
+    return true;
+  }
+
+  return !ordered_before(rhs_value, rhs.has_value, lhs_value, lhs.has_value)
+    && lhs.seq < rhs.seq;
+}
+
+void sorted_collector::collect(
+    const index_reader& reader,
+    const filter::prepared& filter) {
+  for (auto& segment : reader) {
+    collect(segment, filter);
+  }
+}
+
+void sorted_collector::collect(
+    const sub_reader& segment,
+    const filter::prepared& filter) {
+  if (!k_) {
+    return; // none of the documents can get into the result
+  }
+
+  auto* column = segment.column_reader(column_);
+  auto values = column ? column->values() : columnstore_reader::empty_reader();
+  const bool sorted = segment.sort() == string_ref(column_);
+  size_t collected = 0;
+  bytes_ref value;
+
+  for (auto docs = filter.execute(segment); docs->next();) {
+    const auto doc = docs->value();
+
+    if (!values(doc, value)) {
+      value = bytes_ref::nil;
+    }
+
+    if (collect(segment, doc, value)) {
+      if (sorted && ++collected >= k_) {
+        break; // the following documents of the segment go after collected ones
+      }
+    } else if (sorted) {
+      break; // the following documents of the segment aren't competitive either
+    }
+  }
+}
+
+bool sorted_collector::collect(
+    const sub_reader& segment,
+    doc_id_t doc,
+    const bytes_ref& value) {
+  ++hits_;
+
+  if (!k_) {
+    return false;
+  }
+
+  const bool has_value = !value.null();
+  auto less = [](const node& lhs, const node& rhs) {
+    return ordered_before(lhs, rhs);
+  };
+
+  if (heap_.size() < k_) {
+    heap_.push_back(node{
+      &segment, seq_++, doc, bstring(value.c_str(), value.size()), has_value
+    });
+    std::push_heap(heap_.begin(), heap_.end(), less);
+
+    return true;
+  }
+
+  auto& last = heap_.front();
+
+  // a candidate goes after any retained document with an equal value
+  if (!ordered_before(value, has_value, last.value, last.has_value)) {
+    return false; // not competitive
+  }
+
+  // replace the last retained document
+  std::pop_heap(heap_.begin(), heap_.end(), less);
+
+  auto& replaced = heap_.back();
+
+  replaced.segment = &segment;
+  replaced.seq = seq_++;
+  replaced.doc = doc;
+  replaced.value.assign(value.c_str(), value.size());
+  replaced.has_value = has_value;
+  std::push_heap(heap_.begin(), heap_.end(), less);
+
+  return true;
+}
+
+bool sorted_collector::visit(const visitor_f& visitor) const {
+  std::vector<const node*> nodes;
+
+  nodes.reserve(heap_.size());
+
+  for (auto& node : heap_) {
+    nodes.emplace_back(&node);
+  }
+
+  std::sort(
+    nodes.begin(), nodes.end(),
+    [](const node* lhs, const node* rhs) {
+      return ordered_before(*lhs, *rhs);
+  });
+
+  for (auto* node : nodes) {
+    const bytes_ref value = node->has_value
+      ? bytes_ref(node->value)
+      : bytes_ref::nil;
+
+    if (!visitor(entry{ node->segment, node->doc, value })) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void sorted_collector::clear() NOEXCEPT {
+  heap_.clear();
+  hits_ = 0;
+  seq_ = 0;
+}
+
+NS_END // ROOT
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_SORTED_COLLECTOR_H
+#define IRESEARCH_SORTED_COLLECTOR_H
+
+#include "filter.hpp"
+#include "utils/noncopyable.hpp"
+#include "utils/string.hpp"
+
+#include <functional>
+#include <vector>
+
+NS_ROOT
+
+struct index_reader;
+struct sub_reader;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class sorted_collector
+/// @brief collects the first 'k' documents of a query in order of the values
+///        of a column (lexicographically, documents without a value go last),
+///        documents with equal values are ordered the way they were collected.
+///        Segments sorted by the same column (see index_writer::sort(...))
+///        produce documents in the requested order, so their collection stops
+///        after 'k' hits or at the first document that can't get into the
+///        result, other segments are collected entirely.
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API sorted_collector : private util::noncopyable {
+ public:
+  struct entry {
+    const sub_reader* segment;
+    doc_id_t doc;
+    bytes_ref value; // nil if the document has no value
+  }; // entry
+
+  typedef std::function<bool(const entry&)> visitor_f;
+
+  sorted_collector(const string_ref& column, size_t k);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collects matches of 'filter' in every segment of 'reader'
+  //////////////////////////////////////////////////////////////////////////////
+  void collect(const index_reader& reader, const filter::prepared& filter);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collects matches of 'filter' in the specified 'segment'
+  //////////////////////////////////////////////////////////////////////////////
+  void collect(const sub_reader& segment, const filter::prepared& filter);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief offers a document with the specified column 'value' to the
+  ///        collector, nil 'value' denotes a document without a value
+  /// @returns true if the document got into the first 'k'
+  //////////////////////////////////////////////////////////////////////////////
+  bool collect(const sub_reader& segment, doc_id_t doc, const bytes_ref& value);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief visits retained documents in the requested order
+  /// @returns false if visiting was stopped by the 'visitor'
+  //////////////////////////////////////////////////////////////////////////////
+  bool visit(const visitor_f& visitor) const;
+
+  void clear() NOEXCEPT;
+  const std::string& column() const NOEXCEPT { return column_; }
+  bool empty() const NOEXCEPT { return heap_.empty(); }
+  bool full() const NOEXCEPT { return heap_.size() >= k_; }
+  size_t size() const NOEXCEPT { return heap_.size(); }
+  size_t k() const NOEXCEPT { return k_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns number of documents offered to the collector
+  //////////////////////////////////////////////////////////////////////////////
+  size_t hits() const NOEXCEPT { return hits_; }
+
+ private:
+  struct node {
+    const sub_reader* segment;
+    uint64_t seq; // collection order, breaks ties of equal values
+    doc_id_t doc;
+    bstring value;
+    bool has_value;
+  }; // node
+
+  static bool ordered_before(
+    const bytes_ref& lhs, bool lhs_has_value,
+    const bytes_ref& rhs, bool rhs_has_value
+  ) NOEXCEPT;
+  static bool ordered_before(const node& lhs, const node& rhs) NOEXCEPT;
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::string column_;
+  std::vector<node> heap_; // the last document in the requested order goes first
+  size_t k_;
+  size_t hits_{};
+  uint64_t seq_{};
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // sorted_collector
+
+NS_END // ROOT
+
+#endif // IRESEARCH_SORTED_COLLECTOR_H
@@ -49,7 +49,7 @@ term_query::ptr term_query::make(
     // get field
     const auto* reader = segment.field(field);
 
-    if (!reader) {
+    if (!reader || !reader->may_contain(term)) {
       continue;
     }
 
@@ -176,9 +176,11 @@ class scorer : public iresearch::sort::scorer_base<tfidf::score_t> {
   scorer(
       iresearch::boost::boost_t boost,
       const tfidf::idf* idf,
-      const frequency* freq)
+      const frequency* freq,
+      bool reverse)
     : idf_(boost * (idf ? idf->value : 1.f)), 
-      freq_(freq ? freq : &EMPTY_FREQ) {
+      freq_(freq ? freq : &EMPTY_FREQ),
+      reverse_(reverse) {
     assert(freq_);
   }
 
@@ -186,6 +188,17 @@ class scorer : public iresearch::sort::scorer_base<tfidf::score_t> {
     score_cast(score_buf) = tfidf();
   }
 
+  virtual bool bound(uint64_t freq, byte_type* score_buf) const override {
+    // score grows along with the term frequency, hence the bound
+    // is the best score only in case if greater scores go first
+    if (!reverse_ || idf_ < 0.f) {
+      return false;
+    }
+
+    score_cast(score_buf) = idf_ * float_t(std::sqrt(freq));
+    return true;
+  }
+
  protected:
   FORCE_INLINE float_t tfidf() const {
    return idf_ * float_t(std::sqrt(freq_->value));
@@ -194,6 +207,7 @@ class scorer : public iresearch::sort::scorer_base<tfidf::score_t> {
  private:
   float_t idf_; // precomputed : boost * idf
   const frequency* freq_;
+  bool reverse_; // greater scores go first
 }; // scorer
 
 class norm_scorer final : public scorer {
@@ -204,8 +218,9 @@ class norm_scorer final : public scorer {
       const iresearch::norm* norm,
       iresearch::boost::boost_t boost,
       const tfidf::idf* idf,
-      const frequency* freq)
-    : scorer(boost, idf, freq),
+      const frequency* freq,
+      bool reverse)
+    : scorer(boost, idf, freq, reverse),
       norm_(norm) {
     assert(norm_);
   }
@@ -214,6 +229,11 @@ class norm_scorer final : public scorer {
     score_cast(score_buf) = tfidf() * norm_->read();
   }
 
+  virtual bool bound(uint64_t, byte_type*) const override {
+    // norm includes index time field boost and thus isn't bounded
+    return false;
+  }
+
  private:
   const iresearch::norm* norm_;
 }; // norm_scorer
@@ -222,7 +242,8 @@ class sort final: iresearch::sort::prepared_base<tfidf::score_t> {
  public:
   DECLARE_FACTORY(prepared);
 
-  sort(bool normalize, bool reverse): normalize_(normalize) {
+  sort(bool normalize, bool reverse)
+    : normalize_(normalize), reverse_(reverse) {
     static const std::function<bool(score_t, score_t)> greater = std::greater<score_t>();
     static const std::function<bool(score_t, score_t)> less = std::less<score_t>();
     less_ = reverse ? &greater : &less;
@@ -258,14 +279,16 @@ class sort final: iresearch::sort::prepared_base<tfidf::score_t> {
         &*norm,
         boost::extract(query_attrs),
         query_attrs.get<tfidf::idf>().get(),
-        doc_attrs.get<frequency>().get()
+        doc_attrs.get<frequency>().get(),
+        reverse_
       );
     }
 
     return tfidf::scorer::make<tfidf::scorer>(
       boost::extract(query_attrs),
       query_attrs.get<tfidf::idf>().get(),
-      doc_attrs.get<frequency>().get()
+      doc_attrs.get<frequency>().get(),
+      reverse_
     );
   }
 
@@ -280,6 +303,7 @@ class sort final: iresearch::sort::prepared_base<tfidf::score_t> {
  private:
   const std::function<bool(score_t, score_t)>* less_;
   bool normalize_;
+  bool reverse_;
 }; // sort
 
 NS_END // tfidf 
@@ -0,0 +1,289 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "shared.hpp"
+#include "top_k.hpp"
+#include "score.hpp"
+#include "index/index_reader.hpp"
+#include "utils/async_utils.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <exception>
+
+NS_ROOT
+
+// ----------------------------------------------------------------------------
+// --SECTION--                                                  top_k_collector
+// ----------------------------------------------------------------------------
+
+top_k_collector::top_k_collector(const order::prepared& ord, size_t k)
+  : ord_(&ord), k_(k) {
+}
+
+top_k_collector::top_k_collector(top_k_collector&& rhs) NOEXCEPT
+  : ord_(rhs.ord_),
+    heap_(std::move(rhs.heap_)),
+    scores_(std::move(rhs.scores_)),
+    k_(rhs.k_),
+    hits_(rhs.hits_),
+    seq_(rhs.seq_) {
+  rhs.hits_ = 0;
+  rhs.seq_ = 0;
+}
+
+bool top_k_collector::ranked_before(const node& lhs, const node& rhs) const {
+  const auto* lhs_score = score(lhs.slot);
+  const auto* rhs_score = score(rhs.slot);
+
+  if (ord_->less(lhs_score, rhs_score)) {
+    return true;
+  }
+
+  return !ord_->less(rhs_score, lhs_score) && lhs.seq < rhs.seq;
+}
+
+bool top_k_collector::ranked_before(
+    const byte_type* score,
+    const node& rhs) const {
+  // a candidate comes after any retained document with an equal score
+  return ord_->less(score, this->score(rhs.slot));
+}
+
+void top_k_collector::collect(
+    const index_reader& reader,
+    const filter::prepared& filter) {
+  for (auto& segment : reader) {
+    collect(segment, filter);
+  }
+}
+
+void top_k_collector::collect(
+    const index_reader& reader,
+    const filter::prepared& filter,
+    size_t threads) {
+  const auto size = reader.size();
+
+  if (threads < 2 || size < 2) {
+    collect(reader, filter);
+    return;
+  }
+
+  std::vector<top_k_collector> collectors;
+  std::vector<std::exception_ptr> errors(size);
+
+  collectors.reserve(size);
+
+  for (size_t i = 0; i < size; ++i) {
+    collectors.emplace_back(*ord_, k_);
+  }
+
+  {
+    async_utils::thread_pool pool(std::min(threads, size));
+
+    size_t i = 0;
+
+    for (auto& segment : reader) {
+      auto* collector = &collectors[i];
+      auto* error = &errors[i++];
+
+      pool.run([collector, error, &segment, &filter]()->void {
+        try {
+          collector->collect(segment, filter);
+        } catch (...) {
+          *error = std::current_exception();
+        }
+      });
+    }
+
+    pool.stop(); // wait for all segments to be collected
+  }
+
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  // merge in the order of segments to rank ties the same way as sequentially
+  for (auto& collector : collectors) {
+    merge(collector);
+  }
+}
+
+void top_k_collector::collect(
+    const sub_reader& segment,
+    const filter::prepared& filter) {
+  if (!k_ || (ord_->empty() && full())) {
+    return; // none of the documents can get into top 'k'
+  }
+
+  auto docs = filter.execute(segment, *ord_);
+  auto& attrs = docs->attributes();
+  const auto& score = irs::score::extract(attrs);
+  auto* threshold = attrs.get<score_threshold>().get();
+
+  if (threshold) {
+    update(*threshold);
+  }
+
+  const byte_type* value = score.c_str();
+  bstring empty_score;
+
+  if (score.empty() && !ord_->empty()) {
+    // iterator isn't scored, treat all documents as equal
+    empty_score.resize(ord_->size());
+    ord_->prepare_score(&empty_score[0]);
+    value = empty_score.c_str();
+  }
+
+  while (docs->next()) {
+    score.evaluate();
+
+    if (collect(segment, docs->value(), value) && threshold) {
+      update(*threshold);
+    }
+
+    if (ord_->empty() && full()) {
+      break; // unordered, none of the following documents can get into top 'k'
+    }
+  }
+}
+
+bool top_k_collector::collect(
+    const sub_reader& segment,
+    doc_id_t doc,
+    const byte_type* score) {
+  ++hits_;
+
+  if (!k_) {
+    return false;
+  }
+
+  const auto score_size = ord_->size();
+  auto less = [this](const node& lhs, const node& rhs) {
+    return ranked_before(lhs, rhs);
+  };
+
+  if (heap_.size() < k_) {
+    const auto slot = heap_.size();
+
+    scores_.resize(scores_.size() + score_size);
+
+    if (score_size) {
+      std::memcpy(&scores_[slot*score_size], score, score_size);
+    }
+
+    heap_.push_back(node{ &segment, seq_++, slot, doc });
+    std::push_heap(heap_.begin(), heap_.end(), less);
+
+    return true;
+  }
+
+  if (!ranked_before(score, heap_.front())) {
+    return false; // not competitive
+  }
+
+  // replace the least competitive document reusing its score slot
+  std::pop_heap(heap_.begin(), heap_.end(), less);
+
+  auto& last = heap_.back();
+
+  if (score_size) {
+    std::memcpy(&scores_[last.slot*score_size], score, score_size);
+  }
+
+  last.segment = &segment;
+  last.seq = seq_++;
+  last.doc = doc;
+  std::push_heap(heap_.begin(), heap_.end(), less);
+
+  return true;
+}
+
+void top_k_collector::merge(const top_k_collector& other) {
+  assert(ord_->size() == other.ord_->size());
+
+  // offer documents in the order they were collected by 'other'
+  std::vector<const node*> nodes;
+
+  nodes.reserve(other.heap_.size());
+
+  for (auto& node : other.heap_) {
+    nodes.emplace_back(&node);
+  }
+
+  std::sort(
+    nodes.begin(), nodes.end(),
+    [](const node* lhs, const node* rhs) { return lhs->seq < rhs->seq; }
+  );
+
+  const auto hits = hits_;
+
+  for (auto* node : nodes) {
+    collect(*node->segment, node->doc, other.score(node->slot));
+  }
+
+  hits_ = hits + other.hits_;
+}
+
+void top_k_collector::update(score_threshold& threshold) const {
+  const auto* value = this->threshold();
+
+  if (value) {
+    threshold.reset(value, ord_->size());
+  }
+}
+
+bool top_k_collector::visit(const visitor_f& visitor) const {
+  std::vector<const node*> nodes;
+
+  nodes.reserve(heap_.size());
+
+  for (auto& node : heap_) {
+    nodes.emplace_back(&node);
+  }
+
+  std::sort(
+    nodes.begin(), nodes.end(),
+    [this](const node* lhs, const node* rhs) {
+      return ranked_before(*lhs, *rhs);
+  });
+
+  for (auto* node : nodes) {
+    if (!visitor(entry{ node->segment, node->doc, score(node->slot) })) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void top_k_collector::clear() NOEXCEPT {
+  heap_.clear();
+  scores_.clear();
+  hits_ = 0;
+  seq_ = 0;
+}
+
+NS_END // ROOT
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_TOP_K_H
+#define IRESEARCH_TOP_K_H
+
+#include "filter.hpp"
+#include "sort.hpp"
+#include "utils/noncopyable.hpp"
+#include "utils/string.hpp"
+
+#include <functional>
+#include <vector>
+
+NS_ROOT
+
+struct index_reader;
+struct sub_reader;
+class score_threshold;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class top_k_collector
+/// @brief collects 'k' best ranked documents of a query into a fixed-size heap
+///        ordered by order::prepared::less(...), documents with equal scores
+///        are ranked in the order they were collected.
+///        Once the heap is full the least competitive retained score is
+///        propagated to the query iterators via 'score_threshold' attribute,
+///        so they may skip documents (and whole blocks of documents) which
+///        can't get into the result.
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API top_k_collector : private util::noncopyable {
+ public:
+  struct entry {
+    const sub_reader* segment;
+    doc_id_t doc;
+    const byte_type* score;
+  }; // entry
+
+  typedef std::function<bool(const entry&)> visitor_f;
+
+  top_k_collector(const order::prepared& ord, size_t k);
+  top_k_collector(top_k_collector&& rhs) NOEXCEPT;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collects matches of 'filter' in every segment of 'reader'
+  //////////////////////////////////////////////////////////////////////////////
+  void collect(const index_reader& reader, const filter::prepared& filter);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collects matches of 'filter' in every segment of 'reader' using
+  ///        up to 'threads' threads, each segment is collected into its own
+  ///        heap, heaps are merged afterwards in the order of segments
+  //////////////////////////////////////////////////////////////////////////////
+  void collect(
+    const index_reader& reader,
+    const filter::prepared& filter,
+    size_t threads
+  );
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collects matches of 'filter' in the specified 'segment'
+  //////////////////////////////////////////////////////////////////////////////
+  void collect(const sub_reader& segment, const filter::prepared& filter);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief offers a document with the specified 'score' to the collector
+  /// @returns true if the document got into the top 'k'
+  //////////////////////////////////////////////////////////////////////////////
+  bool collect(const sub_reader& segment, doc_id_t doc, const byte_type* score);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief offers all documents retained by 'other' to the collector
+  //////////////////////////////////////////////////////////////////////////////
+  void merge(const top_k_collector& other);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief sets 'threshold' to the least competitive retained score,
+  ///        does nothing while fewer than 'k' documents are retained
+  //////////////////////////////////////////////////////////////////////////////
+  void update(score_threshold& threshold) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns the least competitive retained score,
+  ///          nullptr while fewer than 'k' documents are retained
+  //////////////////////////////////////////////////////////////////////////////
+  const byte_type* threshold() const NOEXCEPT {
+    return full() && !empty() ? score(heap_.front().slot) : nullptr;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief visits retained documents from the best ranked to the worst one
+  /// @returns false if visiting was stopped by the 'visitor'
+  //////////////////////////////////////////////////////////////////////////////
+  bool visit(const visitor_f& visitor) const;
+
+  void clear() NOEXCEPT;
+  bool empty() const NOEXCEPT { return heap_.empty(); }
+  bool full() const NOEXCEPT { return heap_.size() >= k_; }
+  size_t size() const NOEXCEPT { return heap_.size(); }
+  size_t k() const NOEXCEPT { return k_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns number of documents offered to the collector
+  //////////////////////////////////////////////////////////////////////////////
+  size_t hits() const NOEXCEPT { return hits_; }
+
+ private:
+  struct node {
+    const sub_reader* segment;
+    uint64_t seq; // collection order, breaks ties of equal scores
+    size_t slot; // offset of the score in 'scores_' in units of 'ord_->size()'
+    doc_id_t doc;
+  }; // node
+
+  const byte_type* score(size_t slot) const NOEXCEPT {
+    return scores_.c_str() + slot*ord_->size();
+  }
+
+  bool ranked_before(const node& lhs, const node& rhs) const;
+  bool ranked_before(const byte_type* score, const node& rhs) const;
+
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  const order::prepared* ord_;
+  std::vector<node> heap_; // the least competitive document goes first
+  bstring scores_;
+  size_t k_;
+  size_t hits_{};
+  uint64_t seq_{};
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // top_k_collector
+
+NS_END // ROOT
+
+#endif // IRESEARCH_TOP_K_H
@@ -0,0 +1,450 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "shared.hpp"
+#include "async_directory.hpp"
+#include "error/error.hpp"
+#include "utils/file_utils.hpp"
+#include "utils/log.hpp"
+#include "utils/memory.hpp"
+#include "utils/thread_utils.hpp"
+#include "utils/utf8_path.hpp"
+
+#ifndef _WIN32
+  #include <unistd.h> // for pread(...)
+#endif
+
+#include <boost/locale/encoding.hpp>
+
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
+#ifndef _WIN32
+
+NS_LOCAL
+
+using irs::byte_type;
+
+// maximum number of ranges fetched ahead per file
+const size_t READ_AHEAD_SLOTS = 8;
+
+// maximum length of a single range fetched ahead
+const size_t MAX_READ_AHEAD = 256 * 1024;
+
+//////////////////////////////////////////////////////////////////////////////
+/// @brief reads 'len' bytes at 'offset' into 'b'
+/// @returns number of bytes read, less than 'len' only on eof (errno == 0)
+///          or on error (errno != 0)
+//////////////////////////////////////////////////////////////////////////////
+size_t pread_fully(int fd, byte_type* b, size_t len, size_t offset) NOEXCEPT {
+  size_t read = 0;
+
+  while (read < len) {
+    const auto chunk = ::pread(fd, b + read, len - read, off_t(offset + read));
+
+    if (chunk < 0) {
+      if (EINTR == errno) {
+        continue; // interrupted before any data was read
+      }
+
+      break; // read error
+    }
+
+    if (!chunk) {
+      errno = 0; // read past eof
+      break;
+    }
+
+    read += size_t(chunk);
+  }
+
+  return read;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class async_file
+/// @brief file shared by all copies of an async_index_input, holds the
+///        ranges fetched ahead on behalf of any of the copies
+//////////////////////////////////////////////////////////////////////////////
+class async_file {
+ public:
+  typedef std::shared_ptr<async_file> ptr;
+
+  async_file(irs::file_utils::handle_t&& handle, size_t size) NOEXCEPT
+    : handle_(std::move(handle)), size_(size) {
+  }
+
+  int fd() const NOEXCEPT { return file_no(handle_.get()); }
+
+  size_t size() const NOEXCEPT { return size_; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief schedules a read of the specified range on the pool unless the
+  ///        range is already fetched or being fetched, the request is dropped
+  ///        if all slots are being fetched
+  //////////////////////////////////////////////////////////////////////////////
+  static void prefetch(
+      const ptr& file,
+      irs::async_utils::thread_pool& pool,
+      size_t offset,
+      size_t length) NOEXCEPT {
+    if (offset >= file->size_) {
+      return;
+    }
+
+    length = std::min(std::min(length, file->size_ - offset), MAX_READ_AHEAD);
+
+    if (!length) {
+      return;
+    }
+
+    size_t i = 0;
+
+    {
+      SCOPED_LOCK(file->mutex_);
+      slot_t* victim = nullptr;
+
+      for (auto& slot : file->slots_) {
+        if (slot_t::EMPTY != slot.state
+            && slot.offset <= offset
+            && offset + length <= slot.offset + slot.length) {
+          return; // already fetched or being fetched
+        }
+
+        // prefer empty slots, otherwise replace the least recently used one
+        if (slot_t::PENDING != slot.state
+            && (!victim
+                || (slot_t::EMPTY != victim->state
+                    && (slot_t::EMPTY == slot.state || slot.used < victim->used)))) {
+          victim = &slot;
+        }
+      }
+
+      if (!victim) {
+        return; // all slots are being fetched
+      }
+
+      victim->state = slot_t::PENDING;
+      victim->offset = offset;
+      victim->length = length;
+      victim->used = ++file->tick_;
+      i = std::distance(file->slots_, victim);
+    }
+
+    bool scheduled = false;
+
+    try {
+      scheduled = pool.run([file, i]()->void { file->fill(i); });
+    } catch (...) {
+      IR_EXCEPTION();
+    }
+
+    if (!scheduled) {
+      file->reset(i); // pool isn't active
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief copies fetched data at 'offset' into 'b', waits if the data is
+  ///        still being fetched
+  /// @returns number of bytes copied, 0 if the data at 'offset' isn't fetched
+  //////////////////////////////////////////////////////////////////////////////
+  size_t read(byte_type* b, size_t len, size_t offset) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for (;;) {
+      slot_t* found = nullptr;
+
+      for (auto& slot : slots_) {
+        if (slot_t::EMPTY != slot.state
+            && slot.offset <= offset
+            && offset < slot.offset + slot.length) {
+          found = &slot;
+          break;
+        }
+      }
+
+      if (!found) {
+        return 0;
+      }
+
+      if (slot_t::PENDING == found->state) {
+        cond_.wait(lock); // slot is either filled or reset by fill(...)
+        continue;
+      }
+
+      const size_t read = std::min(len, found->offset + found->length - offset);
+      std::memcpy(b, found->data.get() + (offset - found->offset), read);
+      found->used = ++tick_;
+
+      return read;
+    }
+  }
+
+ private:
+  struct slot_t {
+    enum state_t { EMPTY, PENDING, READY };
+
+    std::unique_ptr<byte_type[]> data;
+    size_t offset{};
+    size_t length{};
+    uint64_t used{}; // tick of the last access
+    state_t state{ EMPTY };
+  }; // slot_t
+
+  // reads the range of the specified pending slot, executed on the pool
+  void fill(size_t i) NOEXCEPT {
+    size_t offset, length;
+
+    {
+      SCOPED_LOCK(mutex_);
+      assert(slot_t::PENDING == slots_[i].state);
+      offset = slots_[i].offset; // not modified while pending
+      length = slots_[i].length;
+    }
+
+    std::unique_ptr<byte_type[]> data;
+    size_t read = 0;
+
+    try {
+      data = irs::memory::make_unique<byte_type[]>(length);
+      read = pread_fully(fd(), data.get(), length, offset);
+    } catch (...) {
+      IR_EXCEPTION();
+    }
+
+    SCOPED_LOCK(mutex_);
+    auto& slot = slots_[i];
+
+    if (read) {
+      slot.data = std::move(data);
+      slot.length = read;
+      slot.state = slot_t::READY;
+    } else {
+      slot.state = slot_t::EMPTY; // failed reads are retried by the reader
+    }
+
+    cond_.notify_all();
+  }
+
+  void reset(size_t i) NOEXCEPT {
+    SCOPED_LOCK(mutex_);
+    slots_[i].state = slot_t::EMPTY;
+    cond_.notify_all();
+  }
+
+  std::mutex mutex_; // guards 'slots_' and 'tick_'
+  std::condition_variable cond_; // signaled upon completion of a fetch
+  slot_t slots_[READ_AHEAD_SLOTS];
+  uint64_t tick_{}; // access counter
+  irs::file_utils::handle_t handle_;
+  size_t size_;
+}; // async_file
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class async_index_input
+/// @brief all copies (both dup() and reopen()) share a single file and read
+///        via pread(...), each copy has its own position and buffer
+//////////////////////////////////////////////////////////////////////////////
+class async_index_input : public irs::buffered_index_input {
+ public:
+  static irs::index_input::ptr open(
+      const file_path_t name,
+      const std::shared_ptr<irs::async_utils::thread_pool>& pool) NOEXCEPT {
+    assert(name);
+
+    irs::file_utils::handle_t handle(file_open(name, "rb"));
+
+    if (nullptr == handle) {
+      auto path = boost::locale::conv::utf_to_utf<char>(name);
+
+      IR_FRMT_ERROR("Failed to open input file, error: %d, path: %s", errno, path.c_str());
+
+      return nullptr;
+    }
+
+    const auto size = irs::file_utils::file_size(file_no(handle.get()));
+
+    if (size < 0) {
+      auto path = boost::locale::conv::utf_to_utf<char>(name);
+
+      IR_FRMT_ERROR("Failed to get stat for input file, error: %d, path: %s", errno, path.c_str());
+
+      return nullptr;
+    }
+
+    try {
+      return async_index_input::make<async_index_input>(
+        std::make_shared<async_file>(std::move(handle), size_t(size)), pool
+      );
+    } catch(...) {
+      IR_EXCEPTION();
+    }
+
+    return nullptr;
+  }
+
+  virtual ptr dup() const NOEXCEPT override {
+    try {
+      PTR_NAMED(async_index_input, ptr, *this);
+      return ptr;
+    } catch(...) {
+      IR_EXCEPTION();
+    }
+
+    return nullptr;
+  }
+
+  virtual ptr reopen() const NOEXCEPT override {
+    return dup(); // reads are positional, the shared file is safe to use concurrently
+  }
+
+  virtual size_t length() const override {
+    return file_->size();
+  }
+
+  virtual void prefetch(size_t offset, size_t length) const NOEXCEPT override {
+    if (pool_) {
+      async_file::prefetch(file_, *pool_, offset, length);
+    }
+  }
+
+ protected:
+  virtual void seek_internal(size_t pos) override {
+    if (pos >= file_->size()) {
+      throw irs::detailed_io_error("Seek out of range for input file, length ")
+              << std::to_string(file_->size())
+              << ", position " << std::to_string(pos);
+    }
+
+    pos_ = pos;
+  }
+
+  virtual size_t read_internal(byte_type* b, size_t len) override {
+    assert(b);
+    size_t read = 0;
+
+    // serve as much as possible from the fetched ranges
+    while (read < len) {
+      const auto chunk = file_->read(b + read, len - read, pos_ + read);
+
+      if (!chunk) {
+        break;
+      }
+
+      read += chunk;
+    }
+
+    if (read < len) {
+      const auto chunk = pread_fully(file_->fd(), b + read, len - read, pos_ + read);
+
+      if (chunk < len - read) {
+        if (!errno) {
+          throw irs::eof_error(); // read past eof
+        }
+
+        // read error
+        throw irs::detailed_io_error("Failed to read from input file, read ")
+                << std::to_string(read + chunk)
+                << " out of " << std::to_string(len)
+                << " bytes, error " << std::to_string(errno);
+      }
+
+      read += chunk;
+    }
+
+    pos_ += read;
+    return read;
+  }
+
+ private:
+  DECLARE_FACTORY(index_input);
+
+  async_index_input(
+      async_file::ptr&& file,
+      const std::shared_ptr<irs::async_utils::thread_pool>& pool) NOEXCEPT
+    : file_(std::move(file)), pool_(pool) {
+    assert(file_);
+  }
+
+  async_index_input(const async_index_input&) = default;
+  async_index_input& operator=(const async_index_input&) = delete;
+
+  async_file::ptr file_; // shared file
+  std::shared_ptr<irs::async_utils::thread_pool> pool_; // nullptr == no prefetch
+  size_t pos_{}; // current input stream position
+}; // async_index_input
+
+NS_END // LOCAL
+
+#endif
+
+NS_ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                    async_directory implementation
+// -----------------------------------------------------------------------------
+
+async_directory::async_directory(
+    const std::string& dir,
+    size_t read_threads /*= DEFAULT_READ_THREADS*/)
+  : fs_directory(dir) {
+  if (read_threads) {
+    read_pool_ = std::make_shared<async_utils::thread_pool>(
+      read_threads, read_threads
+    );
+  }
+}
+
+async_directory::~async_directory() {
+  if (read_pool_) {
+    read_pool_->stop(); // inputs that outlive the directory no longer prefetch
+  }
+}
+
+index_input::ptr async_directory::open(
+    const std::string& name,
+    IOAdvice advice) const NOEXCEPT {
+#ifndef _WIN32
+  UNUSED(advice);
+  utf8_path path;
+
+  try {
+    (path/=directory())/=name;
+  } catch(...) {
+    IR_EXCEPTION();
+    return nullptr;
+  }
+
+  return async_index_input::open(path.c_str(), read_pool_);
+#else
+  return fs_directory::open(name, advice);
+#endif
+}
+
+NS_END // ROOT
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
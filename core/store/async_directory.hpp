@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_ASYNC_DIRECTORY_H
+#define IRESEARCH_ASYNC_DIRECTORY_H
+
+#include "fs_directory.hpp"
+
+NS_ROOT
+
+//////////////////////////////////////////////////////////////////////////////
+/// @class async_directory
+/// @brief file system directory serving index_input::prefetch(...) requests
+///        by reading the specified ranges on a pool of threads, so reads
+///        are overlapped with decoding of the already fetched data, the
+///        inputs serve subsequent reads of the fetched ranges from memory
+/// @note on win32 inputs are the same as the ones of fs_directory
+//////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API async_directory : public fs_directory {
+ public:
+  static const size_t DEFAULT_READ_THREADS = 4;
+
+  explicit async_directory(
+    const std::string& dir,
+    size_t read_threads = DEFAULT_READ_THREADS
+  );
+
+  virtual ~async_directory();
+
+  virtual index_input::ptr open(
+    const std::string& name,
+    IOAdvice advice
+  ) const NOEXCEPT final;
+
+ private:
+  IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
+  std::shared_ptr<async_utils::thread_pool> read_pool_; // threads reading prefetched ranges (shared with inputs)
+  IRESEARCH_API_PRIVATE_VARIABLES_END
+}; // async_directory
+
+NS_END // ROOT
+
+#endif // IRESEARCH_ASYNC_DIRECTORY_H
@@ -111,6 +111,13 @@ class checksum_index_input final : public index_input {
     assert(impl_);
   }
 
+  // computes checksum starting from the specified checksum state
+  checksum_index_input(index_input::ptr&& impl, const Checksum& crc)
+    : crc_(crc),
+      impl_(std::move(impl)) {
+    assert(impl_);
+  }
+
   virtual ~checksum_index_input() { }
 
   /* data_input */
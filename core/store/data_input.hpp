@@ -81,6 +81,16 @@ struct IRESEARCH_API index_input : public data_input {
   virtual ptr reopen() const NOEXCEPT = 0; // thread-safe new low-level-fd (offset preserved)
   virtual void seek(size_t pos) = 0;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief hints that the specified range is going to be read soon so the
+  ///        implementation may start fetching it asynchronously, doesn't
+  ///        change the current position and is safe to call concurrently
+  //////////////////////////////////////////////////////////////////////////////
+  virtual void prefetch(size_t offset, size_t length) const NOEXCEPT {
+    UNUSED(offset);
+    UNUSED(length);
+  }
+
  private:
   index_input& operator=( const index_input& ) = delete;
 };
@@ -36,6 +36,22 @@ NS_ROOT
 
 directory::~directory() {}
 
+bool directory::sync_batch(const std::vector<string_ref>& names) NOEXCEPT {
+  try {
+    for (auto& name: names) {
+      if (!sync(name)) {
+        return false;
+      }
+    }
+
+    return true;
+  } catch (...) {
+    IR_EXCEPTION();
+  }
+
+  return false;
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                        index_lock implementation
 // ----------------------------------------------------------------------------
@@ -222,6 +222,15 @@ struct IRESEARCH_API directory
   ////////////////////////////////////////////////////////////////////////////
   virtual bool sync(const std::string& name) NOEXCEPT = 0;
 
+  ////////////////////////////////////////////////////////////////////////////
+  /// @brief ensures that all modification of the specified files have been
+  ///        sucessfully persisted, implementation may persist them
+  ///        concurrently, by default files are synced one by one via sync()
+  /// @param[in] names names of the files
+  /// @returns true if every file has been synced
+  ////////////////////////////////////////////////////////////////////////////
+  virtual bool sync_batch(const std::vector<string_ref>& names) NOEXCEPT;
+
   ////////////////////////////////////////////////////////////////////////////
   /// @brief applies the specified 'visitor' to every filename in a directory
   /// @param[in] visitor to be applied
@@ -26,25 +26,29 @@
 #include "fs_directory.hpp"
 #include "checksum_io.hpp"
 #include "error/error.hpp"
+#include "utils/async_utils.hpp"
+#include "utils/crc.hpp"
 #include "utils/log.hpp"
 #include "utils/object_pool.hpp"
+#include "utils/thread_utils.hpp"
 #include "utils/utf8_path.hpp"
 #include "utils/file_utils.hpp"
 
 #ifdef _WIN32
   #include <Windows.h> // for GetLastError()
+#else
+  #include <unistd.h> // for pread(...)
 #endif
 
 #include <boost/locale/encoding.hpp>
 
-MSVC_ONLY(__pragma(warning(push)))
-MSVC_ONLY(__pragma(warning(disable:4244)))
-MSVC_ONLY(__pragma(warning(disable:4245)))
-#include <boost/crc.hpp>
-MSVC_ONLY(__pragma(warning(pop)))
+#include <atomic>
 
 NS_LOCAL
 
+// maximum number of files synced concurrently by fs_directory::sync_batch(...)
+const size_t MAX_SYNC_THREADS = 8;
+
 inline size_t buffer_size(FILE* file) NOEXCEPT {
   UNUSED(file);
   return 1024;
@@ -246,6 +250,9 @@ class fs_index_output : public buffered_index_output {
 
 //////////////////////////////////////////////////////////////////////////////
 /// @class fs_index_input
+/// @brief on POSIX all copies (both dup() and reopen()) share a single file
+///        descriptor and read via pread(...), each copy has its own position
+///        and buffer; on win32 reopen() takes a separate handle from a pool
 //////////////////////////////////////////////////////////////////////////////
 class pooled_fs_index_input; // predeclaration used by fs_index_input
 class fs_index_input : public buffered_index_input {
@@ -309,6 +316,25 @@ class fs_index_input : public buffered_index_input {
 
   virtual ptr reopen() const NOEXCEPT override;
 
+  virtual void prefetch(size_t offset, size_t length) const NOEXCEPT override {
+#if !defined(_WIN32) && !defined(__APPLE__)
+    if (offset >= handle_->size) {
+      return;
+    }
+
+    // kernel reads the range into the page cache in background
+    ::posix_fadvise(
+      file_no(*handle_),
+      off_t(offset),
+      off_t(std::min(length, handle_->size - offset)),
+      IR_FADVICE_WILLNEED
+    );
+#else
+    UNUSED(offset);
+    UNUSED(length);
+#endif
+  }
+
  protected:
   virtual void seek_internal(size_t pos) override {
     if (pos >= handle_->size) {
@@ -324,6 +350,38 @@ class fs_index_input : public buffered_index_input {
     assert(b);
     assert(handle_->handle);
 
+#ifndef _WIN32
+    // positional reads neither move nor depend on the descriptor position,
+    // so all clones may share the descriptor without any synchronization
+    const auto fd = file_no(*handle_);
+    size_t read = 0;
+
+    while (read < len) {
+      const auto chunk = ::pread(fd, b + read, len - read, off_t(pos_ + read));
+
+      if (chunk < 0) {
+        if (EINTR == errno) {
+          continue; // interrupted before any data was read
+        }
+
+        // read error
+        throw detailed_io_error("Failed to read from input file, read ")
+                << std::to_string(read)
+                << " out of " << std::to_string(len)
+                << " bytes, error " << std::to_string(errno);
+      }
+
+      if (!chunk) {
+        // read past eof
+        throw eof_error();
+      }
+
+      read += size_t(chunk);
+    }
+
+    pos_ += read;
+    return read;
+#else
     FILE* stream = *handle_;
 
     if (handle_->pos != pos_) {
@@ -355,6 +413,7 @@ class fs_index_input : public buffered_index_input {
 
     assert(handle_->pos == pos_);
     return read;
+#endif
   }
 
  private:
@@ -362,7 +421,7 @@ class fs_index_input : public buffered_index_input {
 
   /* use shared wrapper here since we don't want to
   * call "ftell" every time we need to know current 
-  * position */
+  * position (win32 only, otherwise the position isn't used) */
   struct file_handle {
     DECLARE_SPTR(file_handle);
     DECLARE_FACTORY_DEFAULT();
@@ -397,6 +456,8 @@ class fs_index_input : public buffered_index_input {
 
 DEFINE_FACTORY_DEFAULT(fs_index_input::file_handle);
 
+#ifdef _WIN32
+
 class pooled_fs_index_input: public fs_index_input {
  public:
   explicit pooled_fs_index_input(const fs_index_input& in);
@@ -412,6 +473,8 @@ class pooled_fs_index_input: public fs_index_input {
   file_handle::ptr reopen(const file_handle& src) const NOEXCEPT;
 };
 
+#endif
+
 index_input::ptr fs_index_input::dup() const NOEXCEPT {
   try {
     PTR_NAMED(fs_index_input, ptr, *this);
@@ -424,6 +487,11 @@ index_input::ptr fs_index_input::dup() const NOEXCEPT {
 }
 
 index_input::ptr fs_index_input::reopen() const NOEXCEPT {
+#ifndef _WIN32
+  // reads are positional, the shared descriptor is safe to use concurrently,
+  // i.e. a thread-safe copy is the same as dup()
+  return dup();
+#else
   auto ptr = index_input::make<pooled_fs_index_input>(*this);
 
   if (!ptr) {
@@ -433,8 +501,11 @@ index_input::ptr fs_index_input::reopen() const NOEXCEPT {
   auto& in = static_cast<pooled_fs_index_input&>(*ptr);
 
   return in.handle_ && in.handle_->handle ? std::move(ptr) : nullptr;
+#endif
 }
 
+#ifdef _WIN32
+
 pooled_fs_index_input::pooled_fs_index_input(const fs_index_input& in)
   : fs_index_input(in), fd_pool_(memory::make_unique<fd_pool_t>(pool_size_)) {
   handle_ = reopen(*handle_);
@@ -492,6 +563,8 @@ fs_index_input::file_handle::ptr pooled_fs_index_input::reopen(
   return handle;
 }
 
+#endif
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                       fs_directory implementation
 // -----------------------------------------------------------------------------
@@ -505,7 +578,8 @@ fs_index_input::file_handle::ptr pooled_fs_index_input::reopen(
 }
 
 fs_directory::fs_directory(const std::string& dir)
-  : dir_(dir) {
+  : dir_(dir),
+    sync_pool_(MAX_SYNC_THREADS - 1, MAX_SYNC_THREADS - 1) { // +1 calling thread
 }
 
 attribute_store& fs_directory::attributes() NOEXCEPT {
@@ -515,7 +589,7 @@ attribute_store& fs_directory::attributes() NOEXCEPT {
 void fs_directory::close() NOEXCEPT { }
 
 index_output::ptr fs_directory::create(const std::string& name) NOEXCEPT {
-  typedef checksum_index_output<boost::crc_32_type> checksum_output_t;
+  typedef checksum_index_output<crc32c> checksum_output_t;
 
   try {
     utf8_path path;
@@ -665,6 +739,73 @@ bool fs_directory::sync(const std::string& name) NOEXCEPT {
   return false;
 }
 
+bool fs_directory::sync_batch(const std::vector<string_ref>& names) NOEXCEPT {
+  const size_t threads = std::min(names.size(), MAX_SYNC_THREADS);
+
+  if (threads < 2) {
+    return directory::sync_batch(names);
+  }
+
+  // state is shared with the pool tasks, a task might still be started after
+  // return if 'run' threw after queueing it
+  struct batch_state {
+    std::vector<std::string> names;
+    std::atomic<size_t> next{0};
+    std::atomic<bool> success{true};
+    std::mutex mutex;
+    std::condition_variable finished;
+    size_t done{0}; // number of finished pool tasks
+  };
+
+  auto sync_files = [this](batch_state& state)->void {
+    for (size_t i; state.success && (i = state.next++) < state.names.size();) {
+      if (!sync(state.names[i])) {
+        state.success = false;
+      }
+    }
+  };
+
+  std::shared_ptr<batch_state> state;
+
+  try {
+    state = std::make_shared<batch_state>();
+    state->names.assign(names.begin(), names.end());
+  } catch (...) {
+    IR_EXCEPTION();
+    return false;
+  }
+
+  size_t scheduled = 0; // number of tasks scheduled on the pool
+
+  try {
+    for (; scheduled + 1 < threads; ++scheduled) {
+      const bool run = sync_pool_.run([state, sync_files]()->void {
+        sync_files(*state);
+
+        SCOPED_LOCK(state->mutex);
+        ++state->done;
+        state->finished.notify_all();
+      });
+
+      if (!run) {
+        break;
+      }
+    }
+  } catch (...) {
+    IR_EXCEPTION(); // the calling thread syncs the rest of the files
+  }
+
+  sync_files(*state);
+
+  // wait for the rest of the files to be synced
+  SCOPED_LOCK_NAMED(state->mutex, lock);
+  state->finished.wait(lock, [&state, scheduled]()->bool {
+    return state->done >= scheduled;
+  });
+
+  return state->success;
+}
+
 MSVC_ONLY(__pragma(warning(pop)))
 NS_END
 
@@ -25,6 +25,7 @@
 #define IRESEARCH_FILE_SYSTEM_DIRECTORY_H
 
 #include "directory.hpp"
+#include "utils/async_utils.hpp"
 #include "utils/string.hpp"
 #include "utils/attributes.hpp"
 
@@ -78,12 +79,20 @@ class IRESEARCH_API fs_directory : public directory {
 
   virtual bool sync(const std::string& name) NOEXCEPT override;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief syncs files concurrently, since a device is able to serve several
+  ///        outstanding flush requests at once, while every file is synced
+  ///        exactly as by sync(...)
+  //////////////////////////////////////////////////////////////////////////////
+  virtual bool sync_batch(const std::vector<string_ref>& names) NOEXCEPT override;
+
   virtual bool visit(const visitor_f& visitor) const override;
 
  private:
   IRESEARCH_API_PRIVATE_VARIABLES_BEGIN
   attribute_store attributes_;
   std::string dir_;
+  async_utils::thread_pool sync_pool_; // threads reused by sync_batch(...)
   IRESEARCH_API_PRIVATE_VARIABLES_END
 }; // fs_directory
 
@@ -103,6 +103,12 @@ class mmap_index_input : public irs::bytes_ref_input {
     return dup();
   }
 
+  virtual void prefetch(size_t offset, size_t length) const NOEXCEPT override {
+    if (handle_) {
+      handle_->advise(offset, length, IR_MADVICE_WILLNEED);
+    }
+  }
+
  private:
   DECLARE_FACTORY(index_input);
 
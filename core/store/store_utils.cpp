@@ -293,6 +293,232 @@ uint32_t write_block(
 
 
 NS_END // bitpack
+
+// ----------------------------------------------------------------------------
+// --SECTION--                              patched frame of reference helpers
+// ----------------------------------------------------------------------------
+
+NS_BEGIN(pfor)
+NS_LOCAL
+
+using bitpack::ALL_EQUAL;
+
+FORCE_INLINE void write_value(data_output& out, uint32_t value) {
+  out.write_vint(value);
+}
+
+FORCE_INLINE void write_value(data_output& out, uint64_t value) {
+  out.write_vlong(value);
+}
+
+template<typename T>
+FORCE_INLINE T read_value(data_input& in);
+
+template<>
+FORCE_INLINE uint32_t read_value<uint32_t>(data_input& in) {
+  return in.read_vint();
+}
+
+template<>
+FORCE_INLINE uint64_t read_value<uint64_t>(data_input& in) {
+  return in.read_vlong();
+}
+
+FORCE_INLINE uint32_t bits_required(uint32_t value) {
+  return value ? packed::bits_required_32(value) : 0;
+}
+
+FORCE_INLINE uint32_t bits_required(uint64_t value) {
+  return value ? packed::bits_required_64(value) : 0;
+}
+
+template<typename T>
+FORCE_INLINE size_t bytes_required(uint32_t size, uint32_t bits) {
+  assert(0 == size % (8*sizeof(T)));
+  return size_t(size) * bits / 8;
+}
+
+template<typename T>
+void skip_block(index_input& in, uint32_t size) {
+  assert(size);
+
+  const uint32_t bits = in.read_vint();
+  if (ALL_EQUAL == bits) {
+    read_value<T>(in);
+    return;
+  }
+
+  uint32_t exceptions = in.read_vint();
+  in.seek(in.file_pointer() + bytes_required<T>(size, bits));
+
+  for (; exceptions; --exceptions) {
+    in.read_byte(); // position
+    read_value<T>(in); // high bits
+  }
+}
+
+template<typename T>
+void read_block(
+    data_input& in,
+    uint32_t size,
+    T* RESTRICT encoded,
+    T* RESTRICT decoded) {
+  assert(size);
+  assert(encoded);
+  assert(decoded);
+
+  const uint32_t bits = in.read_vint();
+  if (ALL_EQUAL == bits) {
+    std::fill(decoded, decoded + size, read_value<T>(in));
+    return;
+  }
+
+  uint32_t exceptions = in.read_vint();
+  const size_t required = bytes_required<T>(size, bits);
+
+#ifdef IRESEARCH_DEBUG
+  const auto read = in.read_bytes(
+    reinterpret_cast<byte_type*>(encoded),
+    required
+  );
+  assert(read == required);
+#else
+  in.read_bytes(
+    reinterpret_cast<byte_type*>(encoded),
+    required
+  );
+#endif // IRESEARCH_DEBUG
+
+  packed::unpack(decoded, decoded + size, encoded, bits);
+
+  // patch exceptions
+  for (; exceptions; --exceptions) {
+    const auto i = in.read_byte();
+    assert(i < size);
+    decoded[i] |= read_value<T>(in) << bits;
+  }
+}
+
+template<typename T>
+uint32_t write_block(
+    data_output& out,
+    const T* RESTRICT decoded,
+    uint32_t size,
+    T* RESTRICT encoded) {
+  static const uint32_t MAX_BITS = 8*sizeof(T);
+
+  assert(size && size <= 256);
+  assert(encoded);
+  assert(decoded);
+
+  if (irstd::all_equal(decoded, decoded + size)) {
+    out.write_vint(ALL_EQUAL);
+    write_value(out, *decoded);
+    return ALL_EQUAL;
+  }
+
+  // number of values per number of bits required
+  uint32_t histogram[MAX_BITS + 1]{};
+  uint32_t max_bits = 0;
+  for (auto* begin = decoded, *end = decoded + size; begin != end; ++begin) {
+    const auto value_bits = bits_required(*begin);
+    ++histogram[value_bits];
+    max_bits = std::max(max_bits, value_bits);
+  }
+
+  // choose the number of bits minimizing the block size,
+  // every exception costs its position and the varint encoded high bits
+  uint32_t bits = max_bits;
+  size_t min_cost = bytes_required<T>(size, bits);
+  for (uint32_t candidate = max_bits - 1; candidate > 0; --candidate) {
+    size_t cost = bytes_required<T>(size, candidate);
+    for (auto value_bits = candidate + 1; value_bits <= max_bits; ++value_bits) {
+      cost += histogram[value_bits] * (1 + (value_bits - candidate + 6) / 7);
+    }
+
+    if (cost < min_cost) {
+      min_cost = cost;
+      bits = candidate;
+    }
+  }
+
+  // pack low bits of the values
+  const T mask = packed::max_value<T>(bits);
+  T chunk[MAX_BITS]; // pack works on chunks of MAX_BITS values
+  std::memset(encoded, 0, sizeof(T) * size);
+  uint32_t exceptions = 0;
+  for (uint32_t i = 0; i < size; i += MAX_BITS) {
+    for (uint32_t j = 0; j < MAX_BITS; ++j) {
+      const auto value = decoded[i + j];
+      exceptions += (value > mask);
+      chunk[j] = value & mask;
+    }
+
+    packed::pack(chunk, chunk + MAX_BITS, encoded + (i / MAX_BITS) * bits, bits);
+  }
+
+  out.write_vint(bits);
+  out.write_vint(exceptions);
+  out.write_bytes(
+    reinterpret_cast<const byte_type*>(encoded),
+    bytes_required<T>(size, bits)
+  );
+
+  // write high bits of the exceptions
+  for (uint32_t i = 0; exceptions; ++i) {
+    if (decoded[i] > mask) {
+      out.write_byte(static_cast<byte_type>(i));
+      write_value(out, T(decoded[i] >> bits));
+      --exceptions;
+    }
+  }
+
+  return bits;
+}
+
+NS_END // NS_LOCAL
+
+void skip_block32(index_input& in, uint32_t size) {
+  skip_block<uint32_t>(in, size);
+}
+
+void skip_block64(index_input& in, uint64_t size) {
+  skip_block<uint64_t>(in, uint32_t(size));
+}
+
+void read_block(
+    data_input& in,
+    uint32_t size,
+    uint32_t* RESTRICT encoded,
+    uint32_t* RESTRICT decoded) {
+  read_block<uint32_t>(in, size, encoded, decoded);
+}
+
+void read_block(
+    data_input& in,
+    uint32_t size,
+    uint64_t* RESTRICT encoded,
+    uint64_t* RESTRICT decoded) {
+  read_block<uint64_t>(in, size, encoded, decoded);
+}
+
+uint32_t write_block(
+    data_output& out,
+    const uint32_t* RESTRICT decoded,
+    uint32_t size,
+    uint32_t* RESTRICT encoded) {
+  return write_block<uint32_t>(out, decoded, size, encoded);
+}
+
+uint32_t write_block(
+    data_output& out,
+    const uint64_t* RESTRICT decoded,
+    uint32_t size,
+    uint64_t* RESTRICT encoded) {
+  return write_block<uint64_t>(out, decoded, size, encoded);
+}
+
+NS_END // pfor
 NS_END // encode
 
 // ----------------------------------------------------------------------------
@@ -650,6 +650,88 @@ IRESEARCH_API uint32_t write_block(
 
 NS_END
 
+// ----------------------------------------------------------------------------
+// --SECTION--                  patched frame of reference encode/decode helpers
+// ----------------------------------------------------------------------------
+//
+// Values are bit packed using the number of bits which minimizes the size of
+// the block, high bits of the values which don't fit (exceptions) are stored
+// separately and patched in after unpacking:
+//   <BlockHeader>
+//     </NumberOfBits>
+//     </NumberOfExceptions>
+//   </BlockHeader>
+//   </PackedData>
+//   <Exceptions>
+//     </Position></HighBits>
+//     ...
+//   </Exceptions>
+//
+// In case if all elements in a block are equal:
+//   <BlockHeader>
+//     <ALL_EQUAL>
+//   </BlockHeader>
+//   </PackedData>
+//
+// Block size must be a multiple of the number of bits in a value and must
+// not exceed 256.
+//
+// ----------------------------------------------------------------------------
+
+NS_BEGIN(pfor)
+
+// skip block of the specified size that was previously
+// written with the corresponding 'write_block' function
+IRESEARCH_API void skip_block32(index_input& in, uint32_t size);
+
+// skip block of the specified size that was previously
+// written with the corresponding 'write_block' function
+IRESEARCH_API void skip_block64(index_input& in, uint64_t size);
+
+// reads block of the specified size from the stream
+// that was previously encoded with the corresponding
+// 'write_block' funcion
+IRESEARCH_API void read_block(
+  data_input& in,
+  uint32_t size,
+  uint32_t* RESTRICT encoded,
+  uint32_t* RESTRICT decoded
+);
+
+// reads block of the specified size from the stream
+// that was previously encoded with the corresponding
+// 'write_block' funcion
+IRESEARCH_API void read_block(
+  data_input& in,
+  uint32_t size,
+  uint64_t* RESTRICT encoded,
+  uint64_t* RESTRICT decoded
+);
+
+// writes block of the specified size to stream
+//   all values are equal -> RL encoding,
+//   otherwise            -> patched bit packing
+// returns number of bits used to pack the block (0 == RL)
+IRESEARCH_API uint32_t write_block(
+  data_output& out,
+  const uint32_t* RESTRICT decoded,
+  uint32_t size,
+  uint32_t* RESTRICT encoded
+);
+
+// writes block of the specified size to stream
+//   all values are equal -> RL encoding,
+//   otherwise            -> patched bit packing
+// returns number of bits used to pack the block (0 == RL)
+IRESEARCH_API uint32_t write_block(
+  data_output& out,
+  const uint64_t* RESTRICT decoded,
+  uint32_t size,
+  uint64_t* RESTRICT encoded
+);
+
+NS_END // pfor
+
 // ----------------------------------------------------------------------------
 // --SECTION--                                      delta encode/decode helpers
 // ----------------------------------------------------------------------------
@@ -560,6 +560,8 @@ class IRESEARCH_API attribute_view
 
   explicit attribute_view(size_t reserve = 0);
 
+  attribute_view(const attribute_view&) = default;
+
   attribute_view(attribute_view&& rhs) NOEXCEPT
     : base_t(std::move(rhs)) {
   }
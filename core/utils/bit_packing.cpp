@@ -23,10 +23,26 @@
 
 #include "shared.hpp"
 #include "bit_packing.hpp"
+#include "cpuinfo.hpp"
 
 #include <cassert>
 #include <cstring>
 
+// SIMD unpacking is only available on x86, the corresponding instruction set
+// support is checked at runtime, so the kernels are compiled for their
+// specific target regardless of the global compiler flags
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define IRESEARCH_SSE4_1 __attribute__((target("sse4.1")))
+  #define IRESEARCH_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #define IRESEARCH_SSE4_1
+  #define IRESEARCH_AVX2
+#endif
+
+#if defined(IRESEARCH_SSE4_1)
+  #include <immintrin.h>
+#endif
+
 NS_LOCAL
 
 #if defined(_MSC_VER)
@@ -551,6 +567,125 @@ uint64_t __fastpack_at(const uint64_t* in, const size_t i, const uint32_t bits)
 }
 MSVC_ONLY(__pragma(warning(push)))
 
+#if defined(IRESEARCH_SSE4_1) || defined(IRESEARCH_AVX2)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief location of the I-th N-bit value of a packed 32 value block, as a
+///        64-bit window starting at 32-bit word 'WORD' and an offset 'SHIFT'
+///        within that window, the window never crosses the end of the block
+////////////////////////////////////////////////////////////////////////////////
+template<int N, int I>
+struct __fastunpack_lane {
+  static_assert(N > 1 && N < 32, "N <= 1 || N >= 32");
+  static_assert(I >= 0 && I < 32, "I < 0 || I >= 32");
+
+  static const int WORD = (N*I / 32 + 1 < N) ? N*I / 32 : N*I / 32 - 1;
+  static const int SHIFT = N*I - 32*WORD;
+}; // __fastunpack_lane
+
+template<int N, int I>
+IRESEARCH_SSE4_1 FORCE_INLINE __m128i __fastunpack_window(const uint32_t* RESTRICT in) NOEXCEPT {
+  return _mm_loadl_epi64(
+    reinterpret_cast<const __m128i*>(in + __fastunpack_lane<N, I>::WORD)
+  );
+}
+
+#endif
+
+#if defined(IRESEARCH_SSE4_1)
+
+template<int N, int I>
+IRESEARCH_SSE4_1 FORCE_INLINE __m128i __fastunpack4_sse(const uint32_t* RESTRICT in) NOEXCEPT {
+  // SSE has no per-lane variable shifts, but every shift is a compile time
+  // constant here, so shift the whole register twice and blend the lanes
+  const __m128i w01 = _mm_unpacklo_epi64(
+    __fastunpack_window<N, I + 0>(in), __fastunpack_window<N, I + 1>(in)
+  );
+  const __m128i w23 = _mm_unpacklo_epi64(
+    __fastunpack_window<N, I + 2>(in), __fastunpack_window<N, I + 3>(in)
+  );
+  const __m128i v01 = _mm_blend_epi16(
+    _mm_srli_epi64(w01, __fastunpack_lane<N, I + 0>::SHIFT),
+    _mm_srli_epi64(w01, __fastunpack_lane<N, I + 1>::SHIFT),
+    0xF0
+  );
+  const __m128i v23 = _mm_blend_epi16(
+    _mm_srli_epi64(w23, __fastunpack_lane<N, I + 2>::SHIFT),
+    _mm_srli_epi64(w23, __fastunpack_lane<N, I + 3>::SHIFT),
+    0xF0
+  );
+
+  // gather low 32 bits of every 64-bit lane
+  return _mm_castps_si128(_mm_shuffle_ps(
+    _mm_castsi128_ps(v01), _mm_castsi128_ps(v23), _MM_SHUFFLE(2, 0, 2, 0)
+  ));
+}
+
+template<int N>
+IRESEARCH_SSE4_1 void __fastunpack_sse(const uint32_t* RESTRICT in, uint32_t* RESTRICT out) NOEXCEPT {
+  const __m128i mask = _mm_set1_epi32((1U << N) - 1);
+  __m128i* RESTRICT dst = reinterpret_cast<__m128i*>(out);
+
+  _mm_storeu_si128(dst + 0, _mm_and_si128(__fastunpack4_sse<N,  0>(in), mask));
+  _mm_storeu_si128(dst + 1, _mm_and_si128(__fastunpack4_sse<N,  4>(in), mask));
+  _mm_storeu_si128(dst + 2, _mm_and_si128(__fastunpack4_sse<N,  8>(in), mask));
+  _mm_storeu_si128(dst + 3, _mm_and_si128(__fastunpack4_sse<N, 12>(in), mask));
+  _mm_storeu_si128(dst + 4, _mm_and_si128(__fastunpack4_sse<N, 16>(in), mask));
+  _mm_storeu_si128(dst + 5, _mm_and_si128(__fastunpack4_sse<N, 20>(in), mask));
+  _mm_storeu_si128(dst + 6, _mm_and_si128(__fastunpack4_sse<N, 24>(in), mask));
+  _mm_storeu_si128(dst + 7, _mm_and_si128(__fastunpack4_sse<N, 28>(in), mask));
+}
+
+#endif
+
+#if defined(IRESEARCH_AVX2)
+
+template<int N, int I>
+IRESEARCH_AVX2 FORCE_INLINE __m256i __fastunpack4_avx2(const uint32_t* RESTRICT in) NOEXCEPT {
+  const __m256i w = _mm256_inserti128_si256(
+    _mm256_castsi128_si256(_mm_unpacklo_epi64(
+      __fastunpack_window<N, I + 0>(in), __fastunpack_window<N, I + 1>(in)
+    )),
+    _mm_unpacklo_epi64(
+      __fastunpack_window<N, I + 2>(in), __fastunpack_window<N, I + 3>(in)
+    ),
+    1
+  );
+
+  return _mm256_srlv_epi64(w, _mm256_setr_epi64x(
+    __fastunpack_lane<N, I + 0>::SHIFT,
+    __fastunpack_lane<N, I + 1>::SHIFT,
+    __fastunpack_lane<N, I + 2>::SHIFT,
+    __fastunpack_lane<N, I + 3>::SHIFT
+  ));
+}
+
+template<int N, int I>
+IRESEARCH_AVX2 FORCE_INLINE __m256i __fastunpack8_avx2(const uint32_t* RESTRICT in) NOEXCEPT {
+  // gather low 32 bits of every 64-bit lane, _mm256_shuffle_ps operates
+  // within 128-bit lanes, i.e. produces values in order: 0 1 4 5 2 3 6 7
+  const __m256 v = _mm256_shuffle_ps(
+    _mm256_castsi256_ps(__fastunpack4_avx2<N, I + 0>(in)),
+    _mm256_castsi256_ps(__fastunpack4_avx2<N, I + 4>(in)),
+    _MM_SHUFFLE(2, 0, 2, 0)
+  );
+
+  return _mm256_permute4x64_epi64(_mm256_castps_si256(v), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+template<int N>
+IRESEARCH_AVX2 void __fastunpack_avx2(const uint32_t* RESTRICT in, uint32_t* RESTRICT out) NOEXCEPT {
+  const __m256i mask = _mm256_set1_epi32((1U << N) - 1);
+  __m256i* RESTRICT dst = reinterpret_cast<__m256i*>(out);
+
+  _mm256_storeu_si256(dst + 0, _mm256_and_si256(__fastunpack8_avx2<N,  0>(in), mask));
+  _mm256_storeu_si256(dst + 1, _mm256_and_si256(__fastunpack8_avx2<N,  8>(in), mask));
+  _mm256_storeu_si256(dst + 2, _mm256_and_si256(__fastunpack8_avx2<N, 16>(in), mask));
+  _mm256_storeu_si256(dst + 3, _mm256_and_si256(__fastunpack8_avx2<N, 24>(in), mask));
+}
+
+#endif
+
 NS_END // NS_LOCAL
 
 NS_ROOT
@@ -780,6 +915,90 @@ void unpack_block(
   }
 }
 
+void unpack_block_sse4_1(
+  const uint32_t* RESTRICT in, uint32_t* RESTRICT out, const uint32_t bit
+) NOEXCEPT {
+#if defined(IRESEARCH_SSE4_1)
+  switch (bit) {
+    case 2:  __fastunpack_sse<2>(in, out); break;
+    case 3:  __fastunpack_sse<3>(in, out); break;
+    case 4:  __fastunpack_sse<4>(in, out); break;
+    case 5:  __fastunpack_sse<5>(in, out); break;
+    case 6:  __fastunpack_sse<6>(in, out); break;
+    case 7:  __fastunpack_sse<7>(in, out); break;
+    case 8:  __fastunpack_sse<8>(in, out); break;
+    case 9:  __fastunpack_sse<9>(in, out); break;
+    case 10: __fastunpack_sse<10>(in, out); break;
+    case 11: __fastunpack_sse<11>(in, out); break;
+    case 12: __fastunpack_sse<12>(in, out); break;
+    case 13: __fastunpack_sse<13>(in, out); break;
+    case 14: __fastunpack_sse<14>(in, out); break;
+    case 15: __fastunpack_sse<15>(in, out); break;
+    case 16: __fastunpack_sse<16>(in, out); break;
+    case 17: __fastunpack_sse<17>(in, out); break;
+    case 18: __fastunpack_sse<18>(in, out); break;
+    case 19: __fastunpack_sse<19>(in, out); break;
+    case 20: __fastunpack_sse<20>(in, out); break;
+    case 21: __fastunpack_sse<21>(in, out); break;
+    case 22: __fastunpack_sse<22>(in, out); break;
+    case 23: __fastunpack_sse<23>(in, out); break;
+    case 24: __fastunpack_sse<24>(in, out); break;
+    case 25: __fastunpack_sse<25>(in, out); break;
+    case 26: __fastunpack_sse<26>(in, out); break;
+    case 27: __fastunpack_sse<27>(in, out); break;
+    case 28: __fastunpack_sse<28>(in, out); break;
+    case 29: __fastunpack_sse<29>(in, out); break;
+    case 30: __fastunpack_sse<30>(in, out); break;
+    case 31: __fastunpack_sse<31>(in, out); break;
+    default: unpack_block(in, out, bit); break; // nothing to gain for 1 and 32
+  }
+#else
+  unpack_block(in, out, bit);
+#endif
+}
+
+void unpack_block_avx2(
+  const uint32_t* RESTRICT in, uint32_t* RESTRICT out, const uint32_t bit
+) NOEXCEPT {
+#if defined(IRESEARCH_AVX2)
+  switch (bit) {
+    case 2:  __fastunpack_avx2<2>(in, out); break;
+    case 3:  __fastunpack_avx2<3>(in, out); break;
+    case 4:  __fastunpack_avx2<4>(in, out); break;
+    case 5:  __fastunpack_avx2<5>(in, out); break;
+    case 6:  __fastunpack_avx2<6>(in, out); break;
+    case 7:  __fastunpack_avx2<7>(in, out); break;
+    case 8:  __fastunpack_avx2<8>(in, out); break;
+    case 9:  __fastunpack_avx2<9>(in, out); break;
+    case 10: __fastunpack_avx2<10>(in, out); break;
+    case 11: __fastunpack_avx2<11>(in, out); break;
+    case 12: __fastunpack_avx2<12>(in, out); break;
+    case 13: __fastunpack_avx2<13>(in, out); break;
+    case 14: __fastunpack_avx2<14>(in, out); break;
+    case 15: __fastunpack_avx2<15>(in, out); break;
+    case 16: __fastunpack_avx2<16>(in, out); break;
+    case 17: __fastunpack_avx2<17>(in, out); break;
+    case 18: __fastunpack_avx2<18>(in, out); break;
+    case 19: __fastunpack_avx2<19>(in, out); break;
+    case 20: __fastunpack_avx2<20>(in, out); break;
+    case 21: __fastunpack_avx2<21>(in, out); break;
+    case 22: __fastunpack_avx2<22>(in, out); break;
+    case 23: __fastunpack_avx2<23>(in, out); break;
+    case 24: __fastunpack_avx2<24>(in, out); break;
+    case 25: __fastunpack_avx2<25>(in, out); break;
+    case 26: __fastunpack_avx2<26>(in, out); break;
+    case 27: __fastunpack_avx2<27>(in, out); break;
+    case 28: __fastunpack_avx2<28>(in, out); break;
+    case 29: __fastunpack_avx2<29>(in, out); break;
+    case 30: __fastunpack_avx2<30>(in, out); break;
+    case 31: __fastunpack_avx2<31>(in, out); break;
+    default: unpack_block(in, out, bit); break; // nothing to gain for 1 and 32
+  }
+#else
+  unpack_block(in, out, bit);
+#endif
+}
+
 uint32_t at(const uint32_t* encoded, size_t i, const uint32_t bit) NOEXCEPT {
   return __fastpack_at(
     encoded + bit * (i / BLOCK_SIZE_32), 
@@ -818,12 +1037,40 @@ void pack(
 
 void unpack(
   uint32_t* first, uint32_t* last, const uint32_t* in, const uint32_t bit
+) NOEXCEPT {
+  if (cpuinfo::support_avx2()) {
+    unpack_avx2(first, last, in, bit);
+  } else if (cpuinfo::support_sse4_1()) {
+    unpack_sse4_1(first, last, in, bit);
+  } else {
+    unpack_scalar(first, last, in, bit);
+  }
+}
+
+void unpack_scalar(
+  uint32_t* first, uint32_t* last, const uint32_t* in, const uint32_t bit
 ) NOEXCEPT {
   for (; first < last; first += BLOCK_SIZE_32, in += bit) {
     unpack_block(in, first, bit);
   }
 }
 
+void unpack_sse4_1(
+  uint32_t* first, uint32_t* last, const uint32_t* in, const uint32_t bit
+) NOEXCEPT {
+  for (; first < last; first += BLOCK_SIZE_32, in += bit) {
+    unpack_block_sse4_1(in, first, bit);
+  }
+}
+
+void unpack_avx2(
+  uint32_t* first, uint32_t* last, const uint32_t* in, const uint32_t bit
+) NOEXCEPT {
+  for (; first < last; first += BLOCK_SIZE_32, in += bit) {
+    unpack_block_avx2(in, first, bit);
+  }
+}
+
 void unpack(
   uint64_t* first, uint64_t* last, const uint64_t* in, const uint32_t bit
 ) NOEXCEPT {
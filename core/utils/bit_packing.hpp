@@ -119,6 +119,30 @@ IRESEARCH_API void unpack(
   const uint32_t* in, 
   const uint32_t bit) NOEXCEPT;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief explicit implementations of 32-bit 'unpack', the one above picks
+///        the fastest implementation supported by the current CPU,
+///        SIMD versions fall back to the scalar one if not compiled in,
+///        the caller is responsible for checking CPU support via 'cpuinfo'
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API void unpack_scalar(
+  uint32_t* first, 
+  uint32_t* last, 
+  const uint32_t* in, 
+  const uint32_t bit) NOEXCEPT;
+
+IRESEARCH_API void unpack_sse4_1(
+  uint32_t* first, 
+  uint32_t* last, 
+  const uint32_t* in, 
+  const uint32_t bit) NOEXCEPT;
+
+IRESEARCH_API void unpack_avx2(
+  uint32_t* first, 
+  uint32_t* last, 
+  const uint32_t* in, 
+  const uint32_t bit) NOEXCEPT;
+
 IRESEARCH_API void unpack(
   uint64_t* first, 
   uint64_t* last, 
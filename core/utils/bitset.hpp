@@ -24,6 +24,7 @@
 #ifndef IRESEARCH_BITSET_H
 #define IRESEARCH_BITSET_H
 
+#include <algorithm>
 #include <memory>
 
 #include "shared.hpp"
@@ -153,6 +154,39 @@ class bitset : util::noncopyable {
     std::memset(data_.get(), 0, sizeof(word_t)*words_);
   }
 
+  // word-wise 'or' with the words [begin, end) placed at word 'offset',
+  // words past the end of the bitset are ignored
+  void unite(size_t offset, const word_t* begin, const word_t* end) NOEXCEPT {
+    auto* word = data_.get() + (std::min)(offset, words_);
+    const auto* last = data_.get() + words_;
+
+    for (; begin < end && word < last; ++begin, ++word) {
+      *word |= *begin;
+    }
+
+    sanitize();
+  }
+
+  // word-wise 'and' with the words [begin, end) placed at word 'offset',
+  // words not covered by [begin, end) are treated as zeroes
+  void intersect(size_t offset, const word_t* begin, const word_t* end) NOEXCEPT {
+    auto* word = data_.get();
+    const auto* first = word + (std::min)(offset, words_);
+    const auto* last = word + words_;
+
+    for (; word < first; ++word) {
+      *word = 0;
+    }
+
+    for (; begin < end && word < last; ++begin, ++word) {
+      *word &= *begin;
+    }
+
+    for (; word < last; ++word) {
+      *word = 0;
+    }
+  }
+
   // counts bits set
   word_t count() const NOEXCEPT {
     return std::accumulate(
@@ -157,7 +157,10 @@ class block_pool_const_iterator : public std::iterator < std::random_access_iter
 
   size_t block_offset() const { return block_start_; }
 
-  size_t pool_offset() const { return block_offset() + std::distance(block_->begin, pos_); }
+  size_t pool_offset() const {
+    // iterator past the last allocated block has no block assigned
+    return block_ ? block_offset() + std::distance(block_->begin, pos_) : block_offset();
+  }
 
   void refresh() {
     const auto pos = std::distance(block_->begin, pos_);
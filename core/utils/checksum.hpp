@@ -45,6 +45,14 @@ class buffered_checksum {
     assert(buf_size_);
   }
 
+  explicit buffered_checksum(const Checksum& impl, size_t buf_size = DEFAULT_BUF_SIZE)
+    : impl_(impl),
+      buf_(new byte_type[buf_size]),
+      buf_size_(buf_size),
+      size_(0) {
+    assert(buf_size_);
+  }
+
   buffered_checksum( const buffered_checksum& rhs )
     : impl_( rhs.impl_ ),
       buf_( new byte_type[rhs.buf_size_] ),
@@ -22,20 +22,41 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "cpuinfo.hpp"
-
-#if defined(_MSC_VER)
-
 #include "bit_utils.hpp"
 
 NS_ROOT
 
 const cpuinfo cpuinfo::instance_;
 
-/*static*/ bool cpuinfo::support_popcnt() {
-  // according to https://msdn.microsoft.com/en-us/library/bb385231.aspx
-  return check_bit<23>(instance_.f1_cpuinfo_[2]);
+cpuinfo::cpuinfo()
+  : popcnt_(false), sse4_1_(false), sse4_2_(false), avx2_(false) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  int info[4];
+
+  // according to https://msdn.microsoft.com/en-us/library/hskdteyh.aspx
+  __cpuid(info, 0);
+  const int max_leaf = info[0];
+
+  __cpuid(info, 1);
+  popcnt_ = check_bit<23>(info[2]);
+  sse4_1_ = check_bit<19>(info[2]);
+  sse4_2_ = check_bit<20>(info[2]);
+
+  // AVX2 also requires OS support for saving YMM registers
+  const bool os_ymm = check_bit<27>(info[2]) // OSXSAVE
+    && 6 == (_xgetbv(0) & 6); // XMM and YMM state
+
+  if (os_ymm && max_leaf >= 7) {
+    __cpuidex(info, 7, 0);
+    avx2_ = check_bit<5>(info[1]);
+  }
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init(); // may be called before constructors of libgcc
+  popcnt_ = 0 != __builtin_cpu_supports("popcnt");
+  sse4_1_ = 0 != __builtin_cpu_supports("sse4.1");
+  sse4_2_ = 0 != __builtin_cpu_supports("sse4.2");
+  avx2_ = 0 != __builtin_cpu_supports("avx2");
+#endif
 }
 
 NS_END
-
-#endif
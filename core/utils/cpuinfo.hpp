@@ -24,28 +24,36 @@
 #ifndef IRESEARCH_CPUID_ID
 #define IRESEARCH_CPUID_ID
 
-#if defined(_MSC_VER)
-
 #include "shared.hpp"
-#include <intrin.h>
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
 
 NS_ROOT
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief runtime detection of the optional instruction set extensions
+///        supported by the current CPU (always 'false' on non-x86 platforms)
+////////////////////////////////////////////////////////////////////////////////
 class IRESEARCH_API cpuinfo {
  public:
-  static bool support_popcnt();
+  static bool support_popcnt() { return instance_.popcnt_; }
+  static bool support_sse4_1() { return instance_.sse4_1_; }
+  static bool support_sse4_2() { return instance_.sse4_2_; }
+  static bool support_avx2() { return instance_.avx2_; }
+
  private:
   static const cpuinfo instance_;
 
-  cpuinfo() {
-    __cpuid( f1_cpuinfo_, 1 );
-  }
+  cpuinfo();
 
-  int f1_cpuinfo_[4];
+  bool popcnt_;
+  bool sse4_1_;
+  bool sse4_2_;
+  bool avx2_;
 };
 
 NS_END
 
 #endif
-
-#endif
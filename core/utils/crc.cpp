@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "shared.hpp"
+#include "crc.hpp"
+#include "cpuinfo.hpp"
+
+#include <cstring>
+
+// the instruction set support is checked at runtime, so the hardware version
+// is compiled for its specific target regardless of the global compiler flags
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define IRESEARCH_SSE4_2 __attribute__((target("sse4.2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #define IRESEARCH_SSE4_2
+#endif
+
+#if defined(IRESEARCH_SSE4_2)
+  #include <nmmintrin.h>
+#endif
+
+NS_LOCAL
+
+using irs::byte_type;
+
+const uint32_t POLYNOMIAL = 0x82F63B78; // reversed Castagnoli polynomial
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lookup tables for the slice-by-8 algorithm, table[k][b] is CRC of
+///        the byte 'b' followed by 'k' zero bytes
+////////////////////////////////////////////////////////////////////////////////
+struct slice8_tables {
+  slice8_tables() NOEXCEPT {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+
+      for (size_t j = 0; j < 8; ++j) {
+        crc = (crc >> 1) ^ (POLYNOMIAL & (0 - (crc & 1)));
+      }
+
+      table[0][i] = crc;
+    }
+
+    for (uint32_t i = 0; i < 256; ++i) {
+      for (size_t k = 1; k < 8; ++k) {
+        table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+      }
+    }
+  }
+
+  uint32_t table[8][256];
+}; // slice8_tables
+
+const slice8_tables TABLES;
+
+uint32_t update_slice8(uint32_t crc, const byte_type* data, size_t size) NOEXCEPT {
+  const auto& t = TABLES.table;
+
+  for (; size >= 8; data += 8, size -= 8) {
+    // little-endian loads regardless of the platform byte order
+    const uint32_t lo = crc ^ (uint32_t(data[0]) | uint32_t(data[1]) << 8
+                               | uint32_t(data[2]) << 16 | uint32_t(data[3]) << 24);
+    const uint32_t hi = uint32_t(data[4]) | uint32_t(data[5]) << 8
+                      | uint32_t(data[6]) << 16 | uint32_t(data[7]) << 24;
+
+    crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF]
+        ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24]
+        ^ t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF]
+        ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+  }
+
+  for (; size; ++data, --size) {
+    crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xFF];
+  }
+
+  return crc;
+}
+
+#if defined(IRESEARCH_SSE4_2)
+
+IRESEARCH_SSE4_2 uint32_t update_sse4_2(uint32_t crc, const byte_type* data, size_t size) NOEXCEPT {
+#if defined(__x86_64__) || defined(_M_X64)
+  uint64_t crc64 = crc;
+
+  for (; size >= sizeof(uint64_t); data += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof value);
+    crc64 = _mm_crc32_u64(crc64, value);
+  }
+
+  crc = uint32_t(crc64);
+#endif
+
+  for (; size >= sizeof(uint32_t); data += sizeof(uint32_t), size -= sizeof(uint32_t)) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof value);
+    crc = _mm_crc32_u32(crc, value);
+  }
+
+  for (; size; ++data, --size) {
+    crc = _mm_crc32_u8(crc, *data);
+  }
+
+  return crc;
+}
+
+#endif
+
+NS_END // LOCAL
+
+NS_ROOT
+
+/*static*/ crc32c::value_type crc32c::update(
+    value_type crc, const void* data, size_t size) NOEXCEPT {
+  const auto* begin = static_cast<const byte_type*>(data);
+
+  crc = ~crc;
+
+#if defined(IRESEARCH_SSE4_2)
+  if (cpuinfo::support_sse4_2()) {
+    return ~update_sse4_2(crc, begin, size);
+  }
+#endif
+
+  return ~update_slice8(crc, begin, size);
+}
+
+NS_END
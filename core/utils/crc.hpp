@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IRESEARCH_CRC_H
+#define IRESEARCH_CRC_H
+
+#include "shared.hpp"
+
+NS_ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// @class crc32c
+/// @brief CRC-32C (Castagnoli) checksum, uses SSE4.2 'crc32' instruction when
+///        supported by the current CPU and slice-by-8 tables otherwise,
+///        interface mirrors the one of boost::crc_32_type
+////////////////////////////////////////////////////////////////////////////////
+class IRESEARCH_API crc32c {
+ public:
+  typedef uint32_t value_type;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @returns checksum 'crc' updated with the specified data
+  //////////////////////////////////////////////////////////////////////////////
+  static value_type update(value_type crc, const void* data, size_t size) NOEXCEPT;
+
+  void process_byte(byte_type b) NOEXCEPT {
+    value_ = update(value_, &b, 1);
+  }
+
+  void process_bytes(const void* data, size_t size) NOEXCEPT {
+    value_ = update(value_, data, size);
+  }
+
+  value_type checksum() const NOEXCEPT { return value_; }
+
+  void reset() NOEXCEPT { value_ = 0; }
+
+ private:
+  value_type value_{};
+}; // crc32c
+
+NS_END
+
+#endif
@@ -371,6 +371,11 @@ bool tracking_directory::sync(const std::string& name) NOEXCEPT {
   return impl_.sync(name);
 }
 
+bool tracking_directory::sync_batch(
+    const std::vector<string_ref>& names) NOEXCEPT {
+  return impl_.sync_batch(names);
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                            ref_tracking_directory
 // -----------------------------------------------------------------------------
@@ -525,6 +530,11 @@ bool ref_tracking_directory::sync(const std::string& name) NOEXCEPT {
   return impl_.sync(name);
 }
 
+bool ref_tracking_directory::sync_batch(
+    const std::vector<string_ref>& names) NOEXCEPT {
+  return impl_.sync_batch(names);
+}
+
 bool ref_tracking_directory::visit(const visitor_f& visitor) const {
   return impl_.visit(visitor);
 }
@@ -116,6 +116,7 @@ struct IRESEARCH_API tracking_directory: public directory {
   bool swap_tracked(file_set& other) NOEXCEPT;
   bool swap_tracked(tracking_directory& other) NOEXCEPT;
   virtual bool sync(const std::string& name) NOEXCEPT override;
+  virtual bool sync_batch(const std::vector<string_ref>& names) NOEXCEPT override;
   virtual bool visit(const visitor_f& visitor) const override;
 
  private:
@@ -161,6 +162,7 @@ struct IRESEARCH_API ref_tracking_directory: public directory {
   virtual bool remove(const std::string& name) NOEXCEPT override;
   virtual bool rename(const std::string& src, const std::string& dst) NOEXCEPT override;
   virtual bool sync(const std::string& name) NOEXCEPT override;
+  virtual bool sync_batch(const std::vector<string_ref>& names) NOEXCEPT override;
   virtual bool visit(const visitor_f& visitor) const override;
   bool visit_refs(const std::function<bool(const index_file_refs::ref_t& ref)>& visitor) const;
 
@@ -48,6 +48,7 @@
   #define IR_FADVICE_RANDOM 2
   #define IR_FADVICE_DONTNEED 4
   #define IR_FADVICE_NOREUSE 5
+  #define IR_FADVICE_WILLNEED 3
 #else
   #include <unistd.h> // close
   #define file_path_t char*
@@ -65,6 +66,7 @@
   #define IR_FADVICE_RANDOM POSIX_FADV_RANDOM
   #define IR_FADVICE_DONTNEED POSIX_FADV_DONTNEED
   #define IR_FADVICE_NOREUSE POSIX_FADV_NOREUSE
+  #define IR_FADVICE_WILLNEED POSIX_FADV_WILLNEED
 #endif
 
 #include "shared.hpp"
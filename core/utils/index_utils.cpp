@@ -24,7 +24,20 @@
 #include "formats/format_utils.hpp"
 #include "index_utils.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_set>
+
 namespace {
+
+struct tier_segment {
+  size_t pos; // position in the original list
+  double live_bytes; // bytes occupied by the live documents
+  double size; // live bytes rounded up to the floor size
+  double fill; // ratio of live documents
+};
+
 }
 
 NS_ROOT
@@ -158,6 +171,162 @@ index_writer::consolidation_policy_t consolidate_fill(float fill_threshold /*= 0
   };
 }
 
+std::vector<size_t> tier_candidates(
+    const std::vector<segment_stat>& segments,
+    const consolidate_tier_options& options /*= consolidate_tier_options()*/) {
+  const auto min_segments = std::max(size_t(2), options.min_segments);
+  const auto max_segments = std::max(min_segments, options.max_segments);
+  const auto max_bytes = double(options.max_segments_bytes);
+  const auto floor_bytes = double(std::max(uint64_t(1), options.floor_segment_bytes));
+  std::vector<tier_segment> sorted;
+
+  sorted.reserve(segments.size());
+
+  for (size_t i = 0, count = segments.size(); i < count; ++i) {
+    auto& segment = segments[i];
+    const auto fill = segment.docs_count
+      ? double(segment.live_docs_count) / segment.docs_count
+      : 0.;
+    const auto live_bytes = segment.bytes * fill;
+
+    // a segment which would make up a half of the merged one can only be
+    // merged with segments of its own size, leave it for good
+    if (live_bytes > max_bytes / 2) {
+      continue;
+    }
+
+    sorted.push_back(tier_segment{ i, live_bytes, std::max(live_bytes, floor_bytes), fill });
+  }
+
+  // similar sized segments are neighbours
+  std::sort(
+    sorted.begin(), sorted.end(),
+    [](const tier_segment& lhs, const tier_segment& rhs) {
+      return lhs.size < rhs.size || (lhs.size == rhs.size && lhs.pos < rhs.pos);
+  });
+
+  if (sorted.size() < min_segments) {
+    return {}; // nothing to merge
+  }
+
+  // number of segments allowed by the log-structured layout: {max_segments}
+  // per tier, each tier is {max_segments} times larger than the previous one
+  double total_size = 0;
+
+  for (auto& segment: sorted) {
+    total_size += segment.size;
+  }
+
+  double allowed_segments = 0;
+
+  for (auto tier_size = sorted.front().size;;) {
+    const auto tier_segments = total_size / tier_size;
+
+    if (tier_segments < max_segments || tier_size >= max_bytes) {
+      allowed_segments += std::ceil(tier_segments);
+      break;
+    }
+
+    allowed_segments += max_segments;
+    total_size -= max_segments * tier_size;
+    tier_size = std::min(max_bytes, tier_size * max_segments);
+  }
+
+  if (sorted.size() <= allowed_segments) {
+    return {}; // index is within the budget, merging would only add writes
+  }
+
+  size_t best_begin = 0, best_end = 0;
+  double best_score = std::numeric_limits<double>::max();
+
+  for (size_t begin = 0, count = sorted.size(); begin + min_segments <= count; ++begin) {
+    double size = 0, live_bytes = 0, bytes = 0;
+    size_t end = begin;
+
+    for (; end < count && end - begin < max_segments; ++end) {
+      auto& segment = sorted[end];
+
+      if (live_bytes + segment.live_bytes > max_bytes) {
+        break; // merged segment would be too large
+      }
+
+      size += segment.size;
+      live_bytes += segment.live_bytes;
+      bytes += segment.fill ? segment.live_bytes / segment.fill : 0.;
+
+      if (end + 1 - begin < min_segments) {
+        continue; // not enough segments yet
+      }
+
+      // skew is 1/#segments for segments of equal size and approaches 1
+      // if the largest segment dominates (as the runs are sorted by size)
+      const auto skew = segment.size / size;
+
+      // prefer smaller merges and reclaiming space of removed documents
+      const auto fill = bytes ? live_bytes / bytes : 0.;
+      const auto score = skew * std::pow(size, 0.05) * fill * fill;
+
+      if (score < best_score) {
+        best_score = score;
+        best_begin = begin;
+        best_end = end + 1;
+      }
+    }
+  }
+
+  std::vector<size_t> candidates;
+
+  for (auto i = best_begin; i < best_end; ++i) {
+    candidates.push_back(sorted[i].pos);
+  }
+
+  std::sort(candidates.begin(), candidates.end()); // keep segments order
+
+  return candidates;
+}
+
+index_writer::consolidation_policy_t consolidate_tier(
+    const consolidate_tier_options& options /*= consolidate_tier_options()*/) {
+  return [options](
+    const directory& dir, const index_meta& meta
+  )->index_writer::consolidation_acceptor_t {
+    std::vector<segment_stat> segments;
+    uint64_t length;
+
+    segments.reserve(meta.size());
+
+    for (auto& segment: meta) {
+      auto& segment_meta = segment.meta;
+      document_mask docs_mask;
+      uint64_t bytes = 0;
+
+      for (auto& file: segment_meta.files) {
+        if (dir.length(length, file)) {
+          bytes += length;
+        }
+      }
+
+      read_document_mask(docs_mask, dir, segment_meta);
+      segments.push_back(segment_stat{
+        bytes,
+        segment_meta.docs_count,
+        segment_meta.docs_count - std::min(segment_meta.docs_count, uint64_t(docs_mask.size()))
+      });
+    }
+
+    std::unordered_set<std::string> candidates;
+
+    for (auto pos: tier_candidates(segments, options)) {
+      candidates.emplace(meta.segment(pos).meta.name);
+    }
+
+    // merge segment if it belongs to the selected tier
+    return [candidates](const segment_meta& meta)->bool {
+      return candidates.end() != candidates.find(meta.name);
+    };
+  };
+}
+
 void read_document_mask(
   iresearch::document_mask& docs_mask,
   const iresearch::directory& dir,
@@ -41,6 +41,51 @@ IRESEARCH_API index_writer::consolidation_policy_t consolidate_count(float docs_
 // merge segment if: {threshold} > #segment_docs{valid} / (#segment_docs{valid} + #segment_docs{removed})
 IRESEARCH_API index_writer::consolidation_policy_t consolidate_fill(float fill_threshold = 0);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief size of a segment as seen by the tiered consolidation policy
+////////////////////////////////////////////////////////////////////////////////
+struct segment_stat {
+  uint64_t bytes; // total size of segment files
+  uint64_t docs_count; // number of documents including removed ones
+  uint64_t live_docs_count; // number of not removed documents
+}; // segment_stat
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief options of the tiered consolidation policy
+////////////////////////////////////////////////////////////////////////////////
+struct consolidate_tier_options {
+  size_t min_segments = 4; // minimum number of segments of a similar size to merge
+  size_t max_segments = 10; // maximum number of segments to merge at once
+  uint64_t max_segments_bytes = uint64_t(5) << 30; // maximum size of the merged segment
+  uint64_t floor_segment_bytes = uint64_t(2) << 20; // smaller segments are treated as equal
+}; // consolidate_tier_options
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief selects the best group of segments to merge according to the
+///        tiered (log-structured) policy: segments are sized by their live
+///        bytes, i.e. the bytes not occupied by the removed documents, then
+///        consecutive runs of at least {min_segments} and at most
+///        {max_segments} segments of a similar size whose live bytes fit
+///        into {max_segments_bytes} are scored by skew (the largest segment
+///        to the whole run), by merged size and by removed documents ratio.
+///        Segments which are already large enough to be merged only with
+///        the segments of their own size are left alone. Nothing is selected
+///        while the number of segments doesn't exceed the budget of a
+///        log-structured index of the same size with {max_segments} segments
+///        per tier.
+/// @returns positions of the selected segments in 'segments', empty if
+///          there is nothing worth merging
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API std::vector<size_t> tier_candidates(
+  const std::vector<segment_stat>& segments,
+  const consolidate_tier_options& options = consolidate_tier_options()
+);
+
+// merge segments selected by tier_candidates(...)
+IRESEARCH_API index_writer::consolidation_policy_t consolidate_tier(
+  const consolidate_tier_options& options = consolidate_tier_options()
+);
+
 void read_document_mask(
   iresearch::document_mask& docs_mask,
   const iresearch::directory& dir,
@@ -25,8 +25,13 @@
 #include "mmap_utils.hpp"
 #include "utils/log.hpp"
 
+#include <algorithm>
 #include <cassert>
 
+#ifndef _MSC_VER
+  #include <unistd.h> // for sysconf(...)
+#endif
+
 NS_ROOT
 NS_BEGIN(mmap_utils)
 
@@ -59,6 +64,23 @@ int flush(int fd, void* addr, size_t size, int flags) NOEXCEPT {
   return 0;
 }
 
+bool mmap_handle::advise(size_t offset, size_t length, int advice) NOEXCEPT {
+  if (MAP_FAILED == addr_ || offset >= size_) {
+    return false;
+  }
+
+#ifdef _MSC_VER
+  const size_t page_size = 4096; // madvise(...) is a no-op under windows
+#else
+  static const size_t page_size = size_t(::sysconf(_SC_PAGESIZE));
+#endif
+
+  const auto begin = offset - offset % page_size; // 'addr_' is page aligned
+  const auto end = std::min(size_, offset + length);
+
+  return 0 == ::madvise(static_cast<char*>(addr_) + begin, end - begin, advice);
+}
+
 void mmap_handle::close() NOEXCEPT {
   if (addr_ != MAP_FAILED) {
     if (dontneed_) {
@@ -122,6 +122,9 @@ class mmap_handle : private util::noncopyable {
     return 0 == ::madvise(addr_, size_, advice);
   }
 
+  // advises on the pages covering the specified range of the mapped region
+  bool advise(size_t offset, size_t length, int advice) NOEXCEPT;
+
   void dontneed(bool value) NOEXCEPT {
     dontneed_ = value;
   }
@@ -338,5 +338,25 @@ const bytes_ref& maxd64(){
   return data; 
 }
 
+bool is_exact(const bytes_ref& term) {
+  if (term.empty()) {
+    return false;
+  }
+
+  // the leading byte holds the type magic followed by the precision shift
+  switch (term[0]) {
+    case encode_traits<uint32_t>::TYPE_MAGIC:
+#ifndef FLOAT_T_IS_DOUBLE_T
+    case encode_traits<float_t>::TYPE_MAGIC:
+#endif
+      return 1 + sizeof(uint32_t) == term.size();
+    case encode_traits<uint64_t>::TYPE_MAGIC:
+    case encode_traits<double_t>::TYPE_MAGIC:
+      return 1 + sizeof(uint64_t) == term.size();
+    default:
+      return false;
+  }
+}
+
 NS_END // numeric_utils
 NS_END // ROOT
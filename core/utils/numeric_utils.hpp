@@ -93,6 +93,12 @@ IRESEARCH_API const bytes_ref& maxd64();
 IRESEARCH_API const bytes_ref& dinf64();
 IRESEARCH_API const bytes_ref& ndinf64();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @returns true if 'term' is an encoded numeric value of the full precision,
+///          i.e. the most precise term emitted by 'numeric_token_stream'
+////////////////////////////////////////////////////////////////////////////////
+IRESEARCH_API bool is_exact(const bytes_ref& term);
+
 template<typename T>
 struct numeric_traits;
 
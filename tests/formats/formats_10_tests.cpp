@@ -31,12 +31,19 @@
 #include "formats_test_case_base.hpp"
 #include "formats/format_utils.hpp"
 
+#include <set>
+
 class format_10_test_case : public tests::format_test_case_base {
  protected:
   ir::format::ptr get_codec() {
     return ir::formats::get("1_0");
   }
 
+  // version of the postings written by the codec
+  virtual int32_t postings_version() const {
+    return ir::version10::postings_writer::FORMAT_BLOCK_MAX;
+  }
+
   void postings_read_write_single_doc() {
     ir::field_meta field;
 
@@ -46,7 +53,7 @@ class format_10_test_case : public tests::format_test_case_base {
     // docs & attributes for term0
     std::vector<ir::doc_id_t> docs1{ 6 };
 
-    ir::version10::postings_writer writer(false);
+    ir::version10::postings_writer writer(false, postings_version());
     irs::postings_writer::state meta0, meta1;
 
     // write postings
@@ -194,7 +201,7 @@ class format_10_test_case : public tests::format_test_case_base {
     // docs & attributes for term1
     std::vector<ir::doc_id_t> docs1{ 2, 7, 9, 19 };
 
-    ir::version10::postings_writer writer(false);
+    ir::version10::postings_writer writer(false, postings_version());
     irs::postings_writer::state meta0, meta1; // must be destroyed before writer
 
     // write postings
@@ -352,7 +359,7 @@ class format_10_test_case : public tests::format_test_case_base {
 
     // attributes for term
     irs::attribute_store attrs;
-    ir::version10::postings_writer writer(false);
+    ir::version10::postings_writer writer(false, postings_version());
     irs::postings_writer::state term_meta; // must be destroyed before the writer
 
     // write postings for field
@@ -436,12 +443,16 @@ class format_10_test_case : public tests::format_test_case_base {
         {
           auto& typed_meta = dynamic_cast<irs::version10::term_meta&>(*term_meta);
           ASSERT_EQ(typed_meta.docs_count, read_meta.docs_count);
-          ASSERT_EQ(typed_meta.doc_start, read_meta.doc_start);
-          ASSERT_EQ(typed_meta.pos_start, read_meta.pos_start);
+          if (read_meta.inlined.empty()) {
+            // file pointers aren't stored for inlined postings
+            ASSERT_EQ(typed_meta.doc_start, read_meta.doc_start);
+            ASSERT_EQ(typed_meta.pos_start, read_meta.pos_start);
+            ASSERT_EQ(typed_meta.pay_start, read_meta.pay_start);
+          }
           ASSERT_EQ(typed_meta.pos_end, read_meta.pos_end);
-          ASSERT_EQ(typed_meta.pay_start, read_meta.pay_start);
           ASSERT_EQ(typed_meta.e_single_doc, read_meta.e_single_doc);
           ASSERT_EQ(typed_meta.e_skip_start, read_meta.e_skip_start);
+          ASSERT_EQ(typed_meta.inlined, read_meta.inlined);
         }
 
         // seek for every document 127th document in a block
@@ -564,6 +575,305 @@ class format_10_test_case : public tests::format_test_case_base {
     }
   }
 
+  void postings_dense() {
+    ir::field_meta field; // frequency-less field
+
+    // every 3rd document is dense enough, every 5th is not
+    std::vector<ir::doc_id_t> dense_docs, sparse_docs;
+    for (ir::doc_id_t i = 3; i < 10000; i += 3) {
+      dense_docs.push_back(i);
+    }
+    for (ir::doc_id_t i = 5; i < 10000; i += 5) {
+      sparse_docs.push_back(i);
+    }
+
+    ir::version10::postings_writer writer(false, postings_version());
+    irs::postings_writer::state dense_meta; // must be destroyed before the writer
+    irs::postings_writer::state sparse_meta; // must be destroyed before the writer
+
+    {
+      ir::flush_state state;
+      state.dir = &dir();
+      state.doc_count = 10000;
+      state.fields_count = 1;
+      state.name = "segment_name";
+      state.ver = IRESEARCH_VERSION;
+      state.features = &field.features;
+
+      auto out = dir().create("attributes");
+      ASSERT_FALSE(!out);
+
+      writer.prepare(*out, state);
+      writer.begin_field(field.features);
+      {
+        postings it(dense_docs.begin(), dense_docs.end(), field.features);
+        dense_meta = writer.write(it);
+        writer.encode(*out, *dense_meta);
+      }
+      {
+        postings it(sparse_docs.begin(), sparse_docs.end(), field.features);
+        sparse_meta = writer.write(it);
+        writer.encode(*out, *sparse_meta);
+      }
+      writer.end();
+    }
+
+    ASSERT_TRUE(dynamic_cast<irs::version10::term_meta&>(*dense_meta).dense);
+    ASSERT_FALSE(dynamic_cast<irs::version10::term_meta&>(*sparse_meta).dense);
+
+    ir::segment_meta meta;
+    meta.name = "segment_name";
+
+    ir::reader_state state;
+    state.dir = &dir();
+    state.meta = &meta;
+
+    auto in = dir().open("attributes", irs::IOAdvice::NORMAL);
+    ASSERT_FALSE(!in);
+
+    ir::version10::postings_reader reader;
+    reader.prepare(*in, state, field.features);
+
+    irs::version10::term_meta read_meta;
+    irs::attribute_view read_attrs;
+    read_attrs.emplace(read_meta);
+
+    // dense term
+    {
+      reader.decode(*in, field.features, read_attrs, read_meta);
+      ASSERT_TRUE(read_meta.dense);
+      ASSERT_EQ(dense_docs.size(), read_meta.docs_count);
+
+      auto it = reader.iterator(field.features, read_attrs, field.features);
+      auto& bits = it->attributes().get<irs::doc_bitset>();
+      ASSERT_TRUE(bool(bits));
+
+      irs::bitset expected_bits(10000);
+      for (auto doc : dense_docs) {
+        expected_bits.set(doc);
+      }
+
+      irs::bitset actual_bits(10000);
+      actual_bits.unite(bits->offset, bits->begin, bits->end);
+      ASSERT_TRUE(std::equal(expected_bits.begin(), expected_bits.end(), actual_bits.begin()));
+
+      for (auto doc : dense_docs) {
+        ASSERT_TRUE(it->next());
+        ASSERT_EQ(doc, it->value());
+      }
+      ASSERT_FALSE(it->next());
+      ASSERT_TRUE(ir::type_limits<ir::type_t::doc_id_t>::eof(it->value()));
+
+      it = reader.iterator(field.features, read_attrs, field.features);
+      ASSERT_EQ(3, it->seek(1));
+      ASSERT_EQ(300, it->seek(299));
+      ASSERT_EQ(300, it->seek(300));
+      ASSERT_EQ(303, it->seek(301));
+      ASSERT_TRUE(ir::type_limits<ir::type_t::doc_id_t>::eof(it->seek(10000)));
+    }
+
+    // sparse term
+    {
+      reader.decode(*in, field.features, read_attrs, read_meta);
+      ASSERT_FALSE(read_meta.dense);
+      ASSERT_EQ(sparse_docs.size(), read_meta.docs_count);
+
+      auto it = reader.iterator(field.features, read_attrs, field.features);
+      ASSERT_FALSE(it->attributes().get<irs::doc_bitset>());
+
+      for (auto doc : sparse_docs) {
+        ASSERT_TRUE(it->next());
+        ASSERT_EQ(doc, it->value());
+      }
+      ASSERT_FALSE(it->next());
+    }
+  }
+
+  void postings_block_max() {
+    // postings with frequencies varying both within and across blocks
+    class freq_postings : public ir::doc_iterator {
+     public:
+      explicit freq_postings(const std::vector<ir::doc_id_t>& docs)
+        : next_(docs.begin()), end_(docs.end()) {
+        attrs_.emplace(freq_);
+      }
+
+      static uint64_t frequency(ir::doc_id_t doc) {
+        return 1 + (doc * 7919) % (1 + (doc / 256) % 64);
+      }
+
+      virtual bool next() override {
+        if (next_ == end_) {
+          doc_ = ir::type_limits<ir::type_t::doc_id_t>::eof();
+          return false;
+        }
+
+        doc_ = *next_++;
+        freq_.value = frequency(doc_);
+        return true;
+      }
+
+      virtual ir::doc_id_t value() const override { return doc_; }
+
+      virtual ir::doc_id_t seek(ir::doc_id_t target) override {
+        ir::seek(*this, target);
+        return value();
+      }
+
+      virtual const irs::attribute_view& attributes() const NOEXCEPT override {
+        return attrs_;
+      }
+
+     private:
+      irs::attribute_view attrs_;
+      std::vector<ir::doc_id_t>::const_iterator next_;
+      std::vector<ir::doc_id_t>::const_iterator end_;
+      irs::frequency freq_;
+      ir::doc_id_t doc_{ ir::type_limits<ir::type_t::doc_id_t>::invalid() };
+    }; // freq_postings
+
+    ir::field_meta field;
+    field.features = { ir::frequency::type() };
+
+    // long enough to have multiple skip-list levels, last block is partial
+    std::vector<ir::doc_id_t> docs;
+    for (ir::doc_id_t i = 2; docs.size() < 10000; i += 2) {
+      docs.push_back(i);
+    }
+
+    const size_t block_size = ir::version10::postings_writer::BLOCK_SIZE;
+
+    // true maxima of every block and of the whole posting list
+    std::vector<uint64_t> block_max((docs.size() + block_size - 1) / block_size);
+    uint64_t total_freq = 0;
+    for (size_t i = 0; i < docs.size(); ++i) {
+      const auto freq = freq_postings::frequency(docs[i]);
+      block_max[i / block_size] = std::max(block_max[i / block_size], freq);
+      total_freq += freq;
+    }
+    const auto term_max = *std::max_element(block_max.begin(), block_max.end());
+    ASSERT_LT(1, std::set<uint64_t>(block_max.begin(), block_max.end()).size());
+
+    ir::version10::postings_writer writer(false, postings_version());
+    irs::postings_writer::state term_meta; // must be destroyed before the writer
+
+    {
+      ir::flush_state state;
+      state.dir = &dir();
+      state.doc_count = 20001;
+      state.fields_count = 1;
+      state.name = "segment_name";
+      state.ver = IRESEARCH_VERSION;
+      state.features = &field.features;
+
+      auto out = dir().create("attributes");
+      ASSERT_FALSE(!out);
+
+      writer.prepare(*out, state);
+      writer.begin_field(field.features);
+      freq_postings it(docs);
+      term_meta = writer.write(it);
+      writer.encode(*out, *term_meta);
+      writer.end();
+    }
+
+    ir::segment_meta meta;
+    meta.name = "segment_name";
+
+    ir::reader_state state;
+    state.dir = &dir();
+    state.meta = &meta;
+
+    auto in = dir().open("attributes", irs::IOAdvice::NORMAL);
+    ASSERT_FALSE(!in);
+
+    ir::version10::postings_reader reader;
+    reader.prepare(*in, state, field.features);
+
+    irs::frequency freq; // cumulative term frequency
+    freq.value = total_freq;
+    irs::version10::term_meta read_meta;
+    irs::attribute_view read_attrs;
+    read_attrs.emplace(freq);
+    read_attrs.emplace(read_meta);
+    reader.decode(*in, field.features, read_attrs, read_meta);
+    ASSERT_EQ(docs.size(), read_meta.docs_count);
+
+    for (size_t step : { 1, 7, 127, 300, 2500 }) {
+      auto it = reader.iterator(field.features, read_attrs, field.features);
+      auto& max_freq = it->attributes().get<irs::max_frequency>();
+      ASSERT_TRUE(bool(max_freq));
+
+      for (size_t i = 0; i < docs.size(); i += step) {
+        SCOPED_TRACE(::testing::Message("step: ") << step << ", doc: " << i);
+        const auto target = docs[i];
+        uint64_t max = 0;
+        const auto last = max_freq->seek(target, max);
+
+        // blocks except for the trailing partial one are covered by skip-list
+        if (i / block_size < docs.size() / block_size) {
+          ASSERT_EQ(docs[(i / block_size + 1) * block_size - 1], last);
+          ASSERT_EQ(block_max[i / block_size], max);
+        } else {
+          ASSERT_TRUE(ir::type_limits<ir::type_t::doc_id_t>::eof(last));
+          ASSERT_EQ(term_max, max); // bound of the whole posting list
+        }
+
+        ASSERT_EQ(target, it->seek(target));
+      }
+    }
+  }
+
+  void postings_inline() {
+    const std::vector<std::pair<std::vector<ir::doc_id_t>, bool>> cases {
+      { { 5 }, true },
+      { { 5, 9 }, true },
+      { { 5, 9, 11 }, false },
+    };
+
+    for (auto& entry : cases) {
+      auto& docs = entry.first;
+
+      // singletons without positions store nothing but the document itself
+      for (auto& features : std::vector<ir::flags>{
+             {}, { ir::frequency::type() },
+             { ir::frequency::type(), ir::position::type() },
+             { ir::frequency::type(), ir::position::type(), ir::offset::type(), ir::payload::type() } }) {
+        ir::version10::postings_writer writer(false, postings_version());
+        irs::postings_writer::state term_meta; // must be destroyed before the writer
+
+        ir::flush_state state;
+        state.dir = &dir();
+        state.doc_count = 100;
+        state.fields_count = 1;
+        state.name = "segment_name";
+        state.ver = IRESEARCH_VERSION;
+        state.features = &features;
+
+        auto out = dir().create("attributes");
+        ASSERT_FALSE(!out);
+
+        writer.prepare(*out, state);
+        writer.begin_field(features);
+        postings it(docs.begin(), docs.end(), features);
+        term_meta = writer.write(it);
+        writer.end();
+
+        const bool expected = entry.second
+          && (docs.size() > 1 || features.check<ir::position>());
+        auto& typed_meta = dynamic_cast<irs::version10::term_meta&>(*term_meta);
+        ASSERT_EQ(expected, !typed_meta.inlined.empty());
+      }
+
+      postings_seek(docs, {});
+      postings_seek(docs, { ir::frequency::type() });
+      postings_seek(docs, { ir::frequency::type(), ir::position::type() });
+      postings_seek(docs, { ir::frequency::type(), ir::position::type(), ir::offset::type() });
+      postings_seek(docs, { ir::frequency::type(), ir::position::type(), ir::payload::type() });
+      postings_seek(docs, { ir::frequency::type(), ir::position::type(), ir::offset::type(), ir::payload::type() });
+    }
+  }
+
   void postings_seek() {
     // bug: ires336
     {
@@ -747,6 +1057,18 @@ TEST_F(memory_format_10_test_case, postings_seek) {
   postings_seek();
 }
 
+TEST_F(memory_format_10_test_case, postings_dense) {
+  postings_dense();
+}
+
+TEST_F(memory_format_10_test_case, postings_block_max) {
+  postings_block_max();
+}
+
+TEST_F(memory_format_10_test_case, postings_inline) {
+  postings_inline();
+}
+
 TEST_F(memory_format_10_test_case, segment_meta_rw) {
   segment_meta_read_write();
 }
@@ -800,6 +1122,10 @@ TEST_F(fs_format_10_test_case, postings_seek) {
   postings_seek();
 }
 
+TEST_F(fs_format_10_test_case, postings_block_max) {
+  postings_block_max();
+}
+
 TEST_F(fs_format_10_test_case, postings_rw) {
   postings_read_write();
   postings_read_write_single_doc();
@@ -826,3 +1152,38 @@ TEST_F(fs_format_10_test_case, columns_meta_rw) {
 TEST_F(fs_format_10_test_case, document_mask_rw) {
   document_mask_read_write();
 }
+
+// ----------------------------------------------------------------------------
+// --SECTION--                      memory_directory + iresearch_format_10_pfor
+// ----------------------------------------------------------------------------
+
+class memory_format_10_pfor_test_case : public memory_format_10_test_case {
+ protected:
+  virtual ir::format::ptr get_codec() override {
+    return ir::formats::get("1_0_pfor");
+  }
+
+  virtual int32_t postings_version() const override {
+    return ir::version10::postings_writer::FORMAT_PFOR;
+  }
+};
+
+TEST_F(memory_format_10_pfor_test_case, test_load) {
+  auto format = iresearch::formats::get("1_0_pfor");
+
+  ASSERT_NE(nullptr, format);
+  ASSERT_NE(iresearch::formats::get("1_0"), format);
+}
+
+TEST_F(memory_format_10_pfor_test_case, fields_rw) {
+  fields_read_write();
+}
+
+TEST_F(memory_format_10_pfor_test_case, postings_rw) {
+  postings_read_write_single_doc();
+  postings_read_write();
+}
+
+TEST_F(memory_format_10_pfor_test_case, postings_seek) {
+  postings_seek();
+}
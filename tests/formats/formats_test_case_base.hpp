@@ -36,6 +36,8 @@
 #include "store/memory_directory.hpp"
 #include "utils/version_utils.hpp"
 
+#include <thread>
+
 namespace ir = iresearch;
 
 // ----------------------------------------------------------------------------
@@ -541,6 +543,7 @@ class format_test_case_base : public index_test_base {
     ir::field_meta field;
     field.name = "field";
     field.norm = 5;
+    field.features.add<irs::term_filter>(); // request a term filter
 
     // write fields
     {
@@ -561,6 +564,34 @@ class format_test_case_base : public index_test_base {
       writer->end();
     }
 
+    // read field concurrently, term index is loaded on first access
+    {
+      ir::segment_meta meta;
+      meta.name = "segment_name";
+
+      irs::document_mask docs_mask;
+      auto reader = codec()->get_field_reader();
+      ASSERT_TRUE(reader->prepare(dir(), meta, docs_mask));
+      auto term_reader = reader->field(field.name);
+      ASSERT_NE(nullptr, term_reader);
+
+      std::vector<std::thread> threads;
+      std::atomic<size_t> found(0);
+      for (size_t i = 0; i < 8; ++i) {
+        threads.emplace_back([&sorted_terms, term_reader, &found]() {
+          for (auto& expected_term : sorted_terms) {
+            auto term = term_reader->iterator();
+            found += size_t(term->seek(expected_term));
+          }
+        });
+      }
+
+      for (auto& thread : threads) {
+        thread.join();
+      }
+      ASSERT_EQ(8*sorted_terms.size(), found);
+    }
+
     // read field
     {
       ir::segment_meta meta;
@@ -604,6 +635,25 @@ class format_test_case_base : public index_test_base {
          }
        }
 
+       // check term filter: no false negatives, few false positives
+       {
+         for (auto& expected_term : sorted_terms) {
+           ASSERT_TRUE(term_reader->may_contain(expected_term));
+         }
+
+         size_t absent = 0, false_positives = 0;
+         for (size_t i = 0; i < 1000; ++i) {
+           const std::string str = "absent_term_" + std::to_string(i);
+           const auto term = ir::ref_cast<ir::byte_type>(ir::string_ref(str));
+
+           if (sorted_terms.end() == sorted_terms.find(term)) {
+             ++absent;
+             false_positives += term_reader->may_contain(term);
+           }
+         }
+         ASSERT_LT(false_positives, absent / 10);
+       }
+
        // check sorted terms using "seek to cookie"
        {
          auto expected_sorted_term = sorted_terms.begin();
@@ -773,6 +823,43 @@ class format_test_case_base : public index_test_base {
          }
        }
     }
+
+    // fields without 'term_filter' feature have no term filter
+    {
+      ir::field_meta unfiltered;
+      unfiltered.name = "field";
+
+      {
+        ir::flush_state state;
+        state.dir = &dir();
+        state.doc_count = 100;
+        state.fields_count = 1;
+        state.name = "segment_name_unfiltered";
+        state.ver = IRESEARCH_VERSION;
+        state.features = &unfiltered.features;
+
+        terms<sorted_terms_t::iterator> terms(sorted_terms.begin(), sorted_terms.end());
+
+        auto writer = codec()->get_field_writer(false);
+        writer->prepare(state);
+        writer->write(unfiltered.name, unfiltered.norm, unfiltered.features, terms);
+        writer->end();
+      }
+
+      ir::segment_meta meta;
+      meta.name = "segment_name_unfiltered";
+
+      irs::document_mask docs_mask;
+      auto reader = codec()->get_field_reader();
+      ASSERT_TRUE(reader->prepare(dir(), meta, docs_mask));
+      auto term_reader = reader->field(unfiltered.name);
+      ASSERT_NE(nullptr, term_reader);
+
+      for (size_t i = 0; i < 100; ++i) {
+        const std::string str = "absent_term_" + std::to_string(i);
+        ASSERT_TRUE(term_reader->may_contain(ir::ref_cast<ir::byte_type>(ir::string_ref(str))));
+      }
+    }
   }
 
   void segment_meta_read_write() {
@@ -805,6 +892,29 @@ class format_test_case_base : public index_test_base {
       ASSERT_EQ(meta.docs_count, read_meta.docs_count);
       ASSERT_EQ(meta.version, read_meta.version);
       ASSERT_EQ(meta.files, read_meta.files);
+      ASSERT_TRUE(read_meta.sort.empty());
+    }
+
+    // write sorted segment meta
+    meta.version = 101;
+    meta.sort = "sort_column";
+
+    {
+      auto writer = codec()->get_segment_meta_writer();
+      writer->write(dir(), meta);
+    }
+
+    // read sorted segment meta
+    {
+      ir::segment_meta read_meta;
+      read_meta.name = meta.name;
+      read_meta.version = 101;
+
+      auto reader = codec()->get_segment_meta_reader();
+      reader->read(dir(), read_meta);
+      ASSERT_EQ(meta.docs_count, read_meta.docs_count);
+      ASSERT_EQ(meta.files, read_meta.files);
+      ASSERT_EQ(meta.sort, read_meta.sort);
     }
   }
 
@@ -1378,6 +1488,36 @@ class format_test_case_base : public index_test_base {
       ASSERT_TRUE(writer->flush());
     }
 
+    // access columns of segment _1 concurrently, columns are loaded on demand
+    {
+      auto reader = codec()->get_columnstore_reader();
+      ASSERT_TRUE(reader->prepare(dir(), meta0));
+      ASSERT_EQ(6, reader->size());
+
+      std::vector<const irs::columnstore_reader::column_reader*> columns[8];
+      std::vector<std::thread> threads;
+      for (auto& thread_columns : columns) {
+        threads.emplace_back([&reader, &thread_columns]() {
+          for (irs::field_id id = 0; id < 6; ++id) {
+            thread_columns.push_back(reader->column(id));
+          }
+        });
+      }
+
+      for (auto& thread : threads) {
+        thread.join();
+      }
+
+      for (auto& thread_columns : columns) {
+        ASSERT_EQ(columns[0], thread_columns); // same instance for each thread
+      }
+
+      for (irs::field_id id = 0; id < 6; ++id) {
+        ASSERT_NE(nullptr, columns[0][id]);
+        ASSERT_EQ(columns[0][id], reader->column(id));
+      }
+    }
+
     // read columns values from segment _1
     {
       auto reader = codec()->get_columnstore_reader();
@@ -23,6 +23,8 @@
 
 #include "tests_shared.hpp"
 #include "formats/formats.hpp"
+#include "formats/format_utils.hpp"
+#include "store/memory_directory.hpp"
 
 TEST(formats_tests, duplicate_register) {
   struct dummy_format: public irs::format {
@@ -38,3 +40,75 @@ TEST(formats_tests, duplicate_register) {
   irs::format_registrar duplicate(dummy_format::type(), &dummy_format::make);
   ASSERT_TRUE(!duplicate);
 }
+
+TEST(formats_tests, footer_checksum) {
+  irs::memory_directory dir;
+  const irs::string_ref format = "footer_checksum";
+  const irs::bytes_ref payload = irs::ref_cast<irs::byte_type>(irs::string_ref("payload"));
+
+  // current files
+  {
+    auto out = dir.create("crc32c");
+    ASSERT_FALSE(!out);
+    irs::format_utils::write_header(*out, format, 0);
+    out->write_bytes(payload.c_str(), payload.size());
+    irs::format_utils::write_footer(*out);
+  }
+
+  // files written before CRC32C was introduced
+  {
+    irs::memory_output mem_out;
+    irs::format_utils::write_header(mem_out.stream, format, 0);
+    mem_out.stream.write_bytes(payload.c_str(), payload.size());
+    mem_out.stream.write_int(irs::format_utils::FOOTER_MAGIC);
+    mem_out.stream.write_int(irs::format_utils::FOOTER_CRC32);
+    mem_out.stream.flush();
+
+    irs::bstring data(mem_out.file.length(), 0);
+    irs::memory_index_input mem_in(mem_out.file);
+    mem_in.read_bytes(&data[0], data.size());
+
+    boost::crc_32_type crc;
+    crc.process_bytes(data.c_str(), data.size());
+
+    auto out = dir.create("crc32");
+    ASSERT_FALSE(!out);
+    out->write_bytes(data.c_str(), data.size());
+    out->write_long(crc.checksum());
+  }
+
+  for (auto& entry: {
+         std::make_pair("crc32c", irs::format_utils::FOOTER_CRC32C),
+         std::make_pair("crc32", irs::format_utils::FOOTER_CRC32) }) {
+    auto in = dir.open(entry.first, irs::IOAdvice::NORMAL);
+    ASSERT_FALSE(!in);
+    ASSERT_NO_THROW(irs::format_utils::check_checksum(*in));
+
+    const irs::format_utils::footer_checksum crc(*in);
+    ASSERT_EQ(entry.second, crc.type());
+    ASSERT_EQ(0, in->file_pointer());
+
+    irs::checksum_index_input<irs::format_utils::footer_checksum> check_in(std::move(in), crc);
+    ASSERT_EQ(0, irs::format_utils::check_header(check_in, format, 0, 0));
+    check_in.seek(check_in.length() - irs::format_utils::FOOTER_LEN);
+    ASSERT_NO_THROW(irs::format_utils::check_footer(check_in));
+  }
+
+  // corrupted file
+  {
+    auto in = dir.open("crc32c", irs::IOAdvice::NORMAL);
+    ASSERT_FALSE(!in);
+    irs::bstring data(in->length(), 0);
+    in->read_bytes(&data[0], data.size());
+    data[data.size() - irs::format_utils::FOOTER_LEN - 1] ^= 1; // flip a bit of the payload
+
+    auto out = dir.create("corrupted");
+    ASSERT_FALSE(!out);
+    out->write_bytes(data.c_str(), data.size());
+    out.reset();
+
+    in = dir.open("corrupted", irs::IOAdvice::NORMAL);
+    ASSERT_FALSE(!in);
+    ASSERT_THROW(irs::format_utils::check_checksum(*in), irs::index_error);
+  }
+}
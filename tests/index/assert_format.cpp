@@ -27,6 +27,7 @@
 #include "analysis/token_attributes.hpp"
 #include "analysis/token_stream.hpp"
 
+#include "formats/formats_10.hpp"
 #include "index/field_meta.hpp"
 #include "index/directory_reader.hpp"
 
@@ -290,7 +291,7 @@ void document_mask_writer::begin(uint32_t count) {
 }
 
 void document_mask_writer::write(const iresearch::doc_id_t& doc_id) {
-  EXPECT_EQ(true, data_.doc_mask().find(doc_id) != data_.doc_mask().end());
+  EXPECT_TRUE(data_.doc_mask().contains(doc_id));
 }
 
 void document_mask_writer::end() { }
@@ -364,7 +365,8 @@ class pos_iterator;
 class doc_iterator : public iresearch::doc_iterator {
  public:
    doc_iterator(const iresearch::flags& features,
-                      const tests::term& data );
+                      const tests::term& data,
+                      const iresearch::flags& field_features);
 
   iresearch::doc_id_t value() const override {
     return doc_.value;
@@ -411,6 +413,9 @@ class doc_iterator : public iresearch::doc_iterator {
   irs::attribute_view attrs_;
   irs::document doc_;
   irs::frequency freq_;
+  irs::max_frequency max_freq_;
+  irs::doc_bitset bits_;
+  irs::bitset words_; // backs 'bits_'
   irs::position pos_;
   const irs::flags& features_;
   const tests::term& data_;
@@ -467,7 +472,10 @@ class pos_iterator : public iresearch::position::impl {
   const doc_iterator& owner_;
 };
 
-doc_iterator::doc_iterator(const iresearch::flags& features, const tests::term& data)
+doc_iterator::doc_iterator(
+    const iresearch::flags& features,
+    const tests::term& data,
+    const iresearch::flags& field_features)
   : features_( features ),
     data_( data ) {
   next_ = data_.postings.begin();
@@ -476,6 +484,36 @@ doc_iterator::doc_iterator(const iresearch::flags& features, const tests::term&
 
   if (features.check<iresearch::frequency>()) {
     attrs_.emplace(freq_);
+
+    // a single block spanning the whole posting list
+    for (auto& posting : data_.postings) {
+      max_freq_.value = std::max(max_freq_.value, uint64_t(posting.size()));
+    }
+
+    max_freq_.seek_ = [this](irs::doc_id_t, uint64_t& max) {
+      max = max_freq_.value;
+      return irs::type_limits<irs::type_t::doc_id_t>::eof();
+    };
+    attrs_.emplace(max_freq_);
+  } else if (!field_features.check<iresearch::frequency>()
+             && data_.postings.size() >= irs::version10::postings_writer::BLOCK_SIZE) {
+    // frequency-less postings dense enough are stored as a bitset
+    const auto first = irs::bitset::word(data_.postings.begin()->id());
+    const auto last = irs::bitset::word(data_.postings.rbegin()->id());
+
+    if (data_.postings.size()*irs::version10::postings_writer::DENSE_RATIO
+          >= irs::bitset::bit_offset(last - first + 1)) {
+      words_.reset(irs::bitset::bit_offset(last + 1));
+
+      for (auto& posting : data_.postings) {
+        words_.set(posting.id());
+      }
+
+      bits_.offset = first;
+      bits_.begin = words_.begin() + first;
+      bits_.end = words_.end();
+      attrs_.emplace(bits_);
+    }
   }
 
   if (features.check< iresearch::position >()) {
@@ -549,7 +587,7 @@ class term_iterator : public iresearch::seek_term_iterator {
   }
 
   virtual doc_iterator::ptr postings(const iresearch::flags& features) const override {
-    return doc_iterator::make< detail::doc_iterator >( features, *prev_ );
+    return doc_iterator::make< detail::doc_iterator >( features, *prev_, data_.features );
   }
 
   virtual bool seek(
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index/document_mask.hpp"
+
+#include <set>
+
+TEST(document_mask_tests, ctor) {
+  irs::document_mask mask;
+  ASSERT_TRUE(mask.empty());
+  ASSERT_EQ(0, mask.size());
+  ASSERT_FALSE(mask.contains(0));
+  ASSERT_FALSE(mask.contains(irs::type_limits<irs::type_t::doc_id_t>::eof()));
+  ASSERT_EQ(mask.end(), mask.begin());
+  ASSERT_EQ(42, mask.skip(42));
+}
+
+TEST(document_mask_tests, insert) {
+  const std::set<irs::doc_id_t> expected{ 1, 4, 5, 63, 64, 65, 127, 128, 1000, 100000 };
+  irs::document_mask mask;
+
+  for (auto doc : expected) {
+    ASSERT_TRUE(mask.insert(doc));
+    ASSERT_FALSE(mask.insert(doc)); // already masked
+  }
+
+  ASSERT_FALSE(mask.empty());
+  ASSERT_EQ(expected.size(), mask.size());
+
+  for (irs::doc_id_t doc = 0; doc < 100010; ++doc) {
+    ASSERT_EQ(expected.end() != expected.find(doc), mask.contains(doc));
+  }
+
+  // iteration in ascending order
+  ASSERT_TRUE(std::equal(expected.begin(), expected.end(), mask.begin()));
+  ASSERT_EQ(expected.size(), std::distance(mask.begin(), mask.end()));
+
+  // move
+  irs::document_mask moved(std::move(mask));
+  ASSERT_TRUE(mask.empty());
+  ASSERT_EQ(expected.size(), moved.size());
+  ASSERT_TRUE(moved.contains(100000));
+
+  mask = std::move(moved);
+  ASSERT_TRUE(moved.empty());
+  ASSERT_EQ(expected.size(), mask.size());
+
+  // clear
+  mask.clear();
+  ASSERT_TRUE(mask.empty());
+  ASSERT_EQ(0, mask.size());
+  ASSERT_FALSE(mask.contains(100000));
+  ASSERT_EQ(mask.end(), mask.begin());
+}
+
+TEST(document_mask_tests, skip) {
+  irs::document_mask mask;
+
+  // mask a run crossing several words
+  for (irs::doc_id_t doc = 10; doc < 300; ++doc) {
+    mask.insert(doc);
+  }
+  mask.insert(301);
+
+  ASSERT_EQ(9, mask.skip(9));
+  ASSERT_EQ(300, mask.skip(10));
+  ASSERT_EQ(300, mask.skip(64));
+  ASSERT_EQ(300, mask.skip(299));
+  ASSERT_EQ(300, mask.skip(300));
+  ASSERT_EQ(302, mask.skip(301));
+  ASSERT_EQ(100000, mask.skip(100000));
+
+  // all bits of the bitmap are masked
+  irs::document_mask full;
+  for (irs::doc_id_t doc = 0; doc < 128; ++doc) {
+    full.insert(doc);
+  }
+  ASSERT_LE(128, full.skip(0));
+  ASSERT_FALSE(full.contains(full.skip(0)));
+}
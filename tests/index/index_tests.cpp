@@ -27,8 +27,11 @@
 #include "document/field.hpp"
 #include "iql/query_builder.hpp"
 #include "formats/formats_10.hpp"
+#include "search/boolean_filter.hpp"
 #include "search/filter.hpp"
+#include "search/score.hpp"
 #include "search/term_filter.hpp"
+#include "store/async_directory.hpp"
 #include "store/fs_directory.hpp"
 #include "store/mmap_directory.hpp"
 #include "store/memory_directory.hpp"
@@ -39,6 +42,7 @@
 
 #include "index_tests.hpp"
 
+#include <map>
 #include <thread>
 
 namespace ir = iresearch;
@@ -277,6 +281,96 @@ void payloaded_json_field_factory(
   }
 }
 
+void insert_skewed_terms(
+    irs::index_writer& writer,
+    const std::vector<std::string>& terms,
+    size_t count,
+    std::mt19937& rng) {
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_TRUE(writer.insert([&terms, &rng](irs::index_writer::document& doc) {
+      for (size_t t = 0; t < terms.size(); ++t) {
+        if (rng() % (t + 2)) {
+          continue;
+        }
+
+        templates::string_field field("field", terms[t]);
+
+        for (auto freq = 1 + rng() % (2*t + 1); freq; --freq) {
+          doc.insert(irs::action::index, field);
+        }
+      }
+      return false;
+    }));
+  }
+}
+
+void assert_top_k_pruning(
+    const irs::index_reader& reader,
+    const irs::sort::ptr& scorer,
+    const std::vector<std::string>& terms) {
+  irs::Or filter;
+  for (auto& term : terms) {
+    filter.add<irs::by_term>().field("field").term(term);
+  }
+
+  irs::order order;
+  order.add(true, scorer);
+  auto prepared_order = order.prepare();
+  auto prepared_filter = filter.prepare(reader, prepared_order);
+
+  auto comparer = [&prepared_order](const irs::bstring& lhs, const irs::bstring& rhs)->bool {
+    return prepared_order.less(lhs.c_str(), rhs.c_str());
+  };
+  typedef std::multimap<irs::bstring, irs::doc_id_t, decltype(comparer)> top_k_t;
+
+  for (auto& segment : reader) {
+    auto collect = [&](size_t k, bool prune, top_k_t& sorted)->size_t {
+      auto docs = prepared_filter->execute(segment, prepared_order);
+      auto& score = docs->attributes().get<irs::score>();
+      auto& threshold = docs->attributes().get<irs::score_threshold>();
+      EXPECT_TRUE(bool(score));
+      EXPECT_TRUE(bool(threshold));
+
+      size_t count = 0;
+
+      while (docs->next()) {
+        ++count;
+        score->evaluate();
+        sorted.emplace(score->value(), docs->value());
+
+        if (sorted.size() > k) {
+          sorted.erase(--sorted.end());
+        }
+
+        if (prune && sorted.size() == k) {
+          auto& worst = (--sorted.end())->first;
+          threshold->reset(worst.c_str(), worst.size());
+        }
+      }
+
+      return count;
+    };
+
+    for (size_t k : { 1, 10, 100 }) {
+      top_k_t expected(comparer);
+      const auto expected_count = collect(k, false, expected);
+
+      top_k_t actual(comparer);
+      const auto actual_count = collect(k, true, actual);
+
+      ASSERT_EQ(k, expected.size());
+      ASSERT_EQ(expected.size(), actual.size());
+      ASSERT_LT(actual_count, expected_count);
+
+      for (auto expected_it = expected.begin(), actual_it = actual.begin();
+           expected_it != expected.end(); ++expected_it, ++actual_it) {
+        ASSERT_EQ(expected_it->first, actual_it->first);
+        ASSERT_EQ(expected_it->second, actual_it->second);
+      }
+    }
+  }
+}
+
 const irs::columnstore_iterator::value_type INVALID{
   irs::type_limits<irs::type_t::doc_id_t>::invalid(),
   irs::bytes_ref::nil
@@ -7596,6 +7690,23 @@ protected:
   }
 }; // fs_test_case_base
 
+class async_test_case_base : public index_test_case_base {
+protected:
+  virtual void SetUp() override {
+    index_test_case_base::SetUp();
+    MSVC_ONLY(_setmaxstdio(2048)); // workaround for error: EMFILE - Too many open files
+  }
+
+  virtual ir::directory* get_directory() override {
+    const fs::path dir = fs::path( test_dir() ).append( "index" );
+    return new iresearch::async_directory(dir.string());
+  }
+
+  virtual ir::format::ptr get_codec() override {
+    return ir::formats::get("1_0");
+  }
+}; // async_test_case_base
+
 namespace cases {
 
 template<typename Base>
@@ -7835,6 +7946,375 @@ TEST_F(memory_index_test, concurrent_add_remove_mt) {
   }
 }
 
+TEST_F(memory_index_test, concurrent_add_remove_commit_mt) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    [] (tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+    if (data.is_string()) {
+      doc.insert(std::make_shared<tests::templates::string_field>(
+        ir::string_ref(name),
+        data.str
+      ));
+    }
+  });
+  std::vector<const tests::document*> docs;
+
+  for (const tests::document* doc; (doc = gen.next()) != nullptr; docs.emplace_back(doc)) {}
+
+  const size_t thread_count = 4;
+  auto query_doc1 = iresearch::iql::query_builder().build("name==A", std::locale::classic());
+  auto writer = open_writer();
+
+  // every thread fills its own segment writer, segments are flushed concurrently
+  {
+    std::mutex mutex;
+    std::vector<std::thread> threads;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      for (size_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back([&writer, &docs, &mutex]() {
+          {
+            // wait for all threads to be started
+            std::lock_guard<std::mutex> lock(mutex);
+          }
+
+          for (auto* doc : docs) {
+            ASSERT_TRUE(insert(*writer,
+              doc->indexed.begin(), doc->indexed.end(),
+              doc->stored.begin(), doc->stored.end()
+            ));
+          }
+        });
+      }
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  writer->remove(std::move(query_doc1.filter));
+  writer->commit();
+
+  auto reader = iresearch::directory_reader::open(dir(), codec());
+  ASSERT_LE(1, reader.size());
+  ASSERT_GE(thread_count, reader.size());
+  ASSERT_EQ(thread_count*docs.size(), reader.docs_count());
+  ASSERT_EQ(thread_count*(docs.size() - 1), reader.live_docs_count());
+
+}
+
+TEST_F(memory_index_test, segment_memory_max) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    [] (tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+    if (data.is_string()) {
+      doc.insert(std::make_shared<tests::templates::string_field>(
+        ir::string_ref(name),
+        data.str
+      ));
+    }
+  });
+
+  tests::document const* doc1 = gen.next();
+  tests::document const* doc2 = gen.next();
+  tests::document const* doc3 = gen.next();
+  tests::document const* doc4 = gen.next();
+  auto query_doc1 = iresearch::iql::query_builder().build("name==A", std::locale::classic());
+  auto query_doc3 = iresearch::iql::query_builder().build("name==C", std::locale::classic());
+  auto writer = open_writer();
+
+  ASSERT_EQ(0, writer->segment_memory_max());
+  writer->segment_memory_max(1); // every document exceeds the limit
+  ASSERT_EQ(1, writer->segment_memory_max());
+
+  ASSERT_TRUE(insert(*writer,
+    doc1->indexed.begin(), doc1->indexed.end(),
+    doc1->stored.begin(), doc1->stored.end()
+  ));
+  ASSERT_TRUE(insert(*writer,
+    doc2->indexed.begin(), doc2->indexed.end(),
+    doc2->stored.begin(), doc2->stored.end()
+  ));
+  ASSERT_TRUE(update(*writer,
+    *(query_doc1.filter.get()),
+    doc3->indexed.begin(), doc3->indexed.end(),
+    doc3->stored.begin(), doc3->stored.end()
+  ));
+  writer->segment_memory_max(0); // buffer the last document
+  ASSERT_TRUE(insert(*writer,
+    doc4->indexed.begin(), doc4->indexed.end(),
+    doc4->stored.begin(), doc4->stored.end()
+  ));
+
+  // flushed segments are not visible until commit
+  ASSERT_THROW(iresearch::directory_reader::open(dir(), codec()), iresearch::index_not_found);
+
+  writer->commit();
+
+  // doc1 is replaced by doc3 across flushed segments
+  {
+    auto reader = iresearch::directory_reader::open(dir(), codec());
+    ASSERT_EQ(3, reader.size());
+    ASSERT_EQ(3, reader.docs_count());
+    ASSERT_EQ(3, reader.live_docs_count());
+
+    std::unordered_set<std::string> expected = { "B", "C", "D" };
+
+    for (auto& segment : reader) {
+      const auto* column = segment.column_reader("name");
+      ASSERT_NE(nullptr, column);
+      auto values = column->values();
+      irs::bytes_ref actual_value;
+
+      for (auto docs = segment.docs_iterator(); docs->next();) {
+        ASSERT_TRUE(values(docs->value(), actual_value));
+        ASSERT_EQ(1, expected.erase(irs::to_string<irs::string_ref>(actual_value.c_str())));
+      }
+    }
+
+    ASSERT_TRUE(expected.empty());
+  }
+
+  // removal applies to documents of a segment flushed before commit
+  writer->segment_memory_max(1);
+  ASSERT_TRUE(insert(*writer,
+    doc1->indexed.begin(), doc1->indexed.end(),
+    doc1->stored.begin(), doc1->stored.end()
+  ));
+  writer->remove(std::move(query_doc3.filter));
+  writer->commit();
+
+  {
+    auto reader = iresearch::directory_reader::open(dir(), codec());
+    ASSERT_EQ(3, reader.size());
+    ASSERT_EQ(3, reader.live_docs_count());
+  }
+}
+
+TEST_F(memory_index_test, nrt_reader) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    [] (tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+    if (data.is_string()) {
+      doc.insert(std::make_shared<tests::templates::string_field>(
+        ir::string_ref(name),
+        data.str
+      ));
+    }
+  });
+
+  tests::document const* doc1 = gen.next();
+  tests::document const* doc2 = gen.next();
+  tests::document const* doc3 = gen.next();
+  tests::document const* doc4 = gen.next();
+  auto query_doc1 = iresearch::iql::query_builder().build("name==A", std::locale::classic());
+  auto writer = open_writer();
+
+  ASSERT_TRUE(insert(*writer,
+    doc1->indexed.begin(), doc1->indexed.end(),
+    doc1->stored.begin(), doc1->stored.end()
+  ));
+  ASSERT_TRUE(insert(*writer,
+    doc2->indexed.begin(), doc2->indexed.end(),
+    doc2->stored.begin(), doc2->stored.end()
+  ));
+
+  // flushed documents are visible without commit
+  auto reader = writer->reader();
+  ASSERT_EQ(1, reader.size());
+  ASSERT_EQ(2, reader.docs_count());
+  ASSERT_EQ(2, reader.live_docs_count());
+  ASSERT_EQ(0, writer->buffered_docs());
+  ASSERT_THROW(iresearch::directory_reader::open(dir(), codec()), iresearch::index_not_found);
+
+  // pending removals are applied to the flushed segments
+  writer->remove(std::move(query_doc1.filter));
+  ASSERT_TRUE(insert(*writer,
+    doc3->indexed.begin(), doc3->indexed.end(),
+    doc3->stored.begin(), doc3->stored.end()
+  ));
+
+  reader = writer->reader();
+  ASSERT_EQ(2, reader.size());
+  ASSERT_EQ(3, reader.docs_count());
+  ASSERT_EQ(2, reader.live_docs_count());
+  ASSERT_EQ(1, reader[0].live_docs_count());
+  ASSERT_EQ(1, reader[1].live_docs_count());
+  ASSERT_THROW(iresearch::directory_reader::open(dir(), codec()), iresearch::index_not_found);
+
+  // nothing changed
+  reader = writer->reader();
+  ASSERT_EQ(2, reader.size());
+  ASSERT_EQ(2, reader.live_docs_count());
+
+  // flushed segments get into the next commit
+  writer->commit();
+
+  {
+    auto committed = iresearch::directory_reader::open(dir(), codec());
+    ASSERT_EQ(2, committed.size());
+    ASSERT_EQ(3, committed.docs_count());
+    ASSERT_EQ(2, committed.live_docs_count());
+  }
+
+  // flushed segments are discarded by rollback
+  ASSERT_TRUE(insert(*writer,
+    doc4->indexed.begin(), doc4->indexed.end(),
+    doc4->stored.begin(), doc4->stored.end()
+  ));
+  reader = writer->reader();
+  ASSERT_EQ(3, reader.size());
+  ASSERT_EQ(3, reader.live_docs_count());
+  writer->rollback();
+  writer->commit();
+
+  {
+    auto committed = iresearch::directory_reader::open(dir(), codec());
+    ASSERT_EQ(2, committed.size());
+    ASSERT_EQ(2, committed.live_docs_count());
+  }
+
+  // reader over the state flushed by begin()
+  ASSERT_TRUE(insert(*writer,
+    doc4->indexed.begin(), doc4->indexed.end(),
+    doc4->stored.begin(), doc4->stored.end()
+  ));
+  ASSERT_TRUE(writer->begin());
+  reader = writer->reader();
+  ASSERT_EQ(3, reader.size());
+  ASSERT_EQ(3, reader.live_docs_count());
+  writer->commit();
+
+  {
+    auto committed = iresearch::directory_reader::open(dir(), codec());
+    ASSERT_EQ(3, committed.size());
+    ASSERT_EQ(3, committed.live_docs_count());
+  }
+}
+
+TEST_F(memory_index_test, insert_batch) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    [] (tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+    if (data.is_string()) {
+      doc.insert(std::make_shared<tests::templates::string_field>(
+        ir::string_ref(name),
+        data.str
+      ));
+    }
+  });
+  std::vector<const tests::document*> docs;
+
+  for (const tests::document* doc; (doc = gen.next()) != nullptr; docs.emplace_back(doc)) {}
+  ASSERT_LT(3, docs.size());
+
+  auto writer = open_writer();
+  auto inserter = [&docs](irs::index_writer::document& doc, const tests::document* src) {
+    doc.insert(irs::action::index, src->indexed.begin(), src->indexed.end());
+    doc.insert(irs::action::store, src->stored.begin(), src->stored.end());
+    return src != docs[1]; // roll back the 2nd document
+  };
+
+  ASSERT_EQ(docs.size() - 1, writer->insert(docs.begin(), docs.end(), inserter));
+  ASSERT_EQ(docs.size(), writer->buffered_docs());
+
+  // failure of a document doesn't affect the preceding ones
+  auto thrower = [&docs](irs::index_writer::document& doc, const tests::document* src)->bool {
+    if (src == docs[2]) {
+      throw irs::illegal_state();
+    }
+
+    doc.insert(irs::action::index, src->indexed.begin(), src->indexed.end());
+    doc.insert(irs::action::store, src->stored.begin(), src->stored.end());
+    return true;
+  };
+
+  ASSERT_THROW(writer->insert(docs.begin(), docs.end(), thrower), irs::illegal_state);
+
+  // empty batch
+  ASSERT_EQ(0, writer->insert(docs.end(), docs.end(), inserter));
+
+  writer->commit();
+
+  auto reader = iresearch::directory_reader::open(dir(), codec());
+  ASSERT_EQ(docs.size() + 3, reader.docs_count()); // rolled back documents are masked
+  ASSERT_EQ(docs.size() - 1 + 2, reader.live_docs_count());
+}
+
+TEST_F(memory_index_test, keyed_update_remove) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    [] (tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+    if (data.is_string()) {
+      doc.insert(std::make_shared<tests::templates::string_field>(
+        ir::string_ref(name),
+        data.str
+      ));
+    }
+  });
+  std::vector<const tests::document*> docs;
+
+  for (const tests::document* doc; (doc = gen.next()) != nullptr && docs.size() < 7; docs.emplace_back(doc)) {}
+  ASSERT_EQ(7, docs.size()); // A..G
+
+  auto key = [](const irs::string_ref& value) {
+    return irs::ref_cast<irs::byte_type>(value);
+  };
+  auto inserter = [](const tests::document& doc) {
+    return [&doc](irs::index_writer::document& builder) {
+      builder.insert(irs::action::index, doc.indexed.begin(), doc.indexed.end());
+      builder.insert(irs::action::store, doc.stored.begin(), doc.stored.end());
+      return false;
+    };
+  };
+  auto live_names = [this]() {
+    auto reader = iresearch::directory_reader::open(dir(), codec());
+    std::set<std::string> names;
+
+    for (auto& segment : reader) {
+      const auto* column = segment.column_reader("name");
+      EXPECT_NE(nullptr, column);
+      auto values = column->values();
+      irs::bytes_ref value;
+
+      for (auto it = segment.docs_iterator(); it->next();) {
+        EXPECT_TRUE(values(it->value(), value));
+        names.emplace(irs::to_string<std::string>(value.c_str()));
+      }
+    }
+
+    return names;
+  };
+
+  auto writer = open_writer();
+
+  for (size_t i = 0; i < 4; ++i) {
+    ASSERT_TRUE(writer->insert(inserter(*docs[i])));
+  }
+
+  writer->commit();
+  ASSERT_EQ((std::set<std::string>{ "A", "B", "C", "D" }), live_names());
+
+  ASSERT_TRUE(writer->update("name", key("A"), inserter(*docs[4]))); // A -> E
+  writer->remove("name", key("B"));
+  ASSERT_TRUE(writer->update("name", key("X"), inserter(*docs[5]))); // no such key, F is dropped
+  ASSERT_TRUE(writer->insert(inserter(*docs[6])));
+  writer->remove("name", key("G")); // removes a document buffered before the request
+  writer->commit();
+  ASSERT_EQ((std::set<std::string>{ "C", "D", "E" }), live_names());
+
+  // keyed and filter based requests are applied in order they were issued
+  auto query_doc3 = iresearch::iql::query_builder().build("name==C", std::locale::classic());
+  ASSERT_TRUE(writer->update("name", key("D"), inserter(*docs[0]))); // D -> A
+  writer->remove(std::move(query_doc3.filter));
+  ASSERT_TRUE(writer->update("name", key("A"), inserter(*docs[1]))); // A -> B
+  writer->commit();
+  ASSERT_EQ((std::set<std::string>{ "B", "E" }), live_names());
+}
+
 TEST_F(memory_index_test, doc_removal) {
   tests::json_doc_generator gen(
     resource("simple_sequential.json"),
@@ -10586,6 +11066,93 @@ TEST_F(memory_index_test, segment_consolidate) {
   }
 }
 
+TEST_F(memory_index_test, segment_consolidate_async) {
+  tests::json_doc_generator gen(
+    resource("simple_sequential.json"),
+    [] (tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+      if (data.is_string()) {
+        doc.insert(std::make_shared<tests::templates::string_field>(
+          ir::string_ref(name),
+          data.str
+        ));
+      }
+  });
+
+  irs::bytes_ref actual_value;
+
+  tests::document const* doc1 = gen.next();
+  tests::document const* doc2 = gen.next();
+  tests::document const* doc3 = gen.next();
+  tests::document const* doc4 = gen.next();
+
+  auto always_merge = [](const iresearch::directory& dir, const iresearch::index_meta& meta)->iresearch::index_writer::consolidation_acceptor_t {
+    return [](const iresearch::segment_meta& meta)->bool { return true; };
+  };
+
+  // removals happened during the merge are applied to the merged segment
+  {
+    auto query_doc2 = iresearch::iql::query_builder().build("name==B", std::locale::classic());
+    auto query_doc3 = iresearch::iql::query_builder().build("name==C", std::locale::classic());
+    auto writer = open_writer();
+
+    ASSERT_TRUE(insert(*writer,
+      doc1->indexed.begin(), doc1->indexed.end(),
+      doc1->stored.begin(), doc1->stored.end()
+    ));
+    ASSERT_TRUE(insert(*writer,
+      doc2->indexed.begin(), doc2->indexed.end(),
+      doc2->stored.begin(), doc2->stored.end()
+    ));
+    writer->commit();
+    ASSERT_TRUE(insert(*writer,
+      doc3->indexed.begin(), doc3->indexed.end(),
+      doc3->stored.begin(), doc3->stored.end()
+    ));
+    ASSERT_TRUE(insert(*writer,
+      doc4->indexed.begin(), doc4->indexed.end(),
+      doc4->stored.begin(), doc4->stored.end()
+    ));
+    writer->commit();
+
+    writer->consolidation_threads(0); // suspend background merges
+    ASSERT_TRUE(writer->consolidate_async(always_merge));
+    ASSERT_FALSE(writer->consolidate_async(always_merge)); // segments are being merged already
+
+    // commit isn't blocked by the scheduled merge
+    writer->remove(std::move(query_doc2.filter));
+    writer->commit();
+
+    {
+      auto reader = iresearch::directory_reader::open(dir(), codec());
+      ASSERT_EQ(2, reader.size());
+      ASSERT_EQ(3, reader.live_docs_count());
+    }
+
+    writer->remove(std::move(query_doc3.filter)); // not yet committed removal
+    writer->consolidation_threads(1); // resume background merges
+    writer->wait_for_consolidation();
+    writer->commit();
+
+    auto reader = iresearch::directory_reader::open(dir(), codec());
+    ASSERT_EQ(1, reader.size());
+    auto& segment = reader[0]; // assume 0 is id of first/only segment
+    ASSERT_EQ(4, segment.docs_count()); // total count of documents
+    ASSERT_EQ(2, segment.live_docs_count()); // total count of live documents
+
+    const auto* column = segment.column_reader("name");
+    ASSERT_NE(nullptr, column);
+    auto values = column->values();
+    auto docsItr = segment.docs_iterator();
+    ASSERT_TRUE(docsItr->next());
+    ASSERT_TRUE(values(docsItr->value(), actual_value));
+    ASSERT_EQ("A", irs::to_string<irs::string_ref>(actual_value.c_str())); // 'name' value in doc1
+    ASSERT_TRUE(docsItr->next());
+    ASSERT_TRUE(values(docsItr->value(), actual_value));
+    ASSERT_EQ("D", irs::to_string<irs::string_ref>(actual_value.c_str())); // 'name' value in doc4
+    ASSERT_FALSE(docsItr->next());
+  }
+}
+
 TEST_F(memory_index_test, segment_consolidate_policy) {
   tests::json_doc_generator gen(
     resource("simple_sequential.json"),
@@ -11274,6 +11841,43 @@ TEST_F(fs_index_test, profile_bulk_index_multithread_update_batched_mt) {
   profile_bulk_index(16, 0, 5, 10000); // 5 does not divide evenly into 16
 }
 
+// ----------------------------------------------------------------------------
+// --SECTION--                            async_directory + iresearch_format_10
+// ----------------------------------------------------------------------------
+
+class async_index_test
+  : public tests::cases::tfidf<tests::async_test_case_base>{
+}; // async_index_test
+
+TEST_F(async_index_test, read_write_doc_attributes) {
+  read_write_doc_attributes_sparse_variable_length();
+  read_write_doc_attributes_sparse_mask();
+  read_write_doc_attributes_dense_variable_length();
+  read_write_doc_attributes_dense_fixed_length();
+  read_write_doc_attributes_dense_mask();
+  read_write_doc_attributes_big();
+  read_write_doc_attributes();
+  read_empty_doc_attributes();
+}
+
+TEST_F(async_index_test, concurrent_read_column_mt) {
+  concurrent_read_single_column_smoke();
+  concurrent_read_multiple_columns();
+}
+
+TEST_F(async_index_test, concurrent_read_index_mt) {
+  concurrent_read_index();
+}
+
+TEST_F(async_index_test, europarl_docs) {
+  {
+    tests::templates::europarl_doc_template doc;
+    tests::delim_doc_generator gen(resource("europarl.subset.txt"), doc);
+    add_segment(gen);
+  }
+  assert_index();
+}
+
 // ----------------------------------------------------------------------------
 // --SECTION--                             mmap_directory + iresearch_format_10
 // ----------------------------------------------------------------------------
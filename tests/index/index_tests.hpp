@@ -45,6 +45,9 @@
 #include "utils/locale_utils.hpp"
 #include "utils/timer_utils.hpp"
 #include "document/field.hpp"
+#include "search/sort.hpp"
+
+#include <random>
 
 NS_ROOT
 
@@ -370,6 +373,26 @@ void payloaded_json_field_factory(
   const json_doc_generator::json_value& data
 );
 
+// inserts 'count' documents where term 'i' of the field 'field' is present
+// in ~1/(i+2) of the documents, the rarer the term the greater its maximum
+// frequency, so that the documents are worth pruning while collecting top-k
+void insert_skewed_terms(
+  irs::index_writer& writer,
+  const std::vector<std::string>& terms,
+  size_t count,
+  std::mt19937& rng
+);
+
+// collects top-k documents of a disjunction over 'terms' of the field 'field'
+// scored by 'scorer' (greater scores first) with and without raising the
+// 'score_threshold', asserts that the same documents with the same scores are
+// collected either way while some documents are skipped with the threshold
+void assert_top_k_pruning(
+  const irs::index_reader& reader,
+  const irs::sort::ptr& scorer,
+  const std::vector<std::string>& terms
+);
+
 NS_END // tests
 
 #endif // IRESEARCH_INDEX_TESTS_H
@@ -27,6 +27,8 @@
 #include "store/memory_directory.hpp"
 #include "utils/type_limits.hpp"
 #include "index/merge_writer.hpp"
+#include "search/term_filter.hpp"
+#include "utils/async_utils.hpp"
 
 namespace tests {
   class merge_writer_tests: public ::testing::Test {
@@ -94,6 +96,42 @@ namespace tests {
 
     ASSERT_TRUE(expected_terms.empty());
   }
+
+  // asserts both directories contain the same files with the same content
+  void assert_equal_files(
+      const iresearch::directory& expected_dir,
+      const iresearch::directory& actual_dir) {
+    std::vector<std::string> expected_files;
+    expected_dir.visit([&expected_files](std::string& name)->bool {
+      expected_files.emplace_back(name);
+      return true;
+    });
+    ASSERT_FALSE(expected_files.empty());
+
+    std::vector<std::string> actual_files;
+    actual_dir.visit([&actual_files](std::string& name)->bool {
+      actual_files.emplace_back(name);
+      return true;
+    });
+
+    std::sort(expected_files.begin(), expected_files.end());
+    std::sort(actual_files.begin(), actual_files.end());
+    ASSERT_EQ(expected_files, actual_files);
+
+    for (auto& file : expected_files) {
+      auto expected_in = expected_dir.open(file, irs::IOAdvice::NORMAL);
+      auto actual_in = actual_dir.open(file, irs::IOAdvice::NORMAL);
+      ASSERT_NE(nullptr, expected_in);
+      ASSERT_NE(nullptr, actual_in);
+      ASSERT_EQ(expected_in->length(), actual_in->length());
+
+      std::vector<irs::byte_type> expected(expected_in->length());
+      std::vector<irs::byte_type> actual(actual_in->length());
+      expected_in->read_bytes(expected.data(), expected.size());
+      actual_in->read_bytes(actual.data(), actual.size());
+      ASSERT_EQ(expected, actual) << file;
+    }
+  }
 }
 
 using namespace tests;
@@ -2208,6 +2246,329 @@ TEST_F(merge_writer_tests, test_merge_writer_field_features) {
   }
 }
 
+TEST_F(merge_writer_tests, test_merge_writer_concurrent) {
+  tests::json_doc_generator gen(
+    test_base::resource("simple_sequential.json"),
+    [](tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+      static irs::flags extra_features = { irs::norm::type() };
+
+      if (data.is_string()) {
+        doc.insert(std::make_shared<tests::templates::string_field>(name, data.str, extra_features));
+      } else if (data.is_number()) {
+        doc.insert(std::make_shared<tests::templates::string_field>(name, std::to_string(data.as_number<uint64_t>())));
+      }
+  });
+
+  iresearch::version10::format codec;
+  iresearch::format::ptr codec_ptr(&codec, [](iresearch::format*)->void{});
+  iresearch::memory_directory dir;
+
+  // populate directory
+  {
+    auto writer = iresearch::index_writer::make(dir, codec_ptr, iresearch::OM_CREATE);
+    const tests::document* doc;
+
+    for (size_t i = 0; (doc = gen.next()); ++i) {
+      ASSERT_TRUE(insert(*writer,
+        doc->indexed.begin(), doc->indexed.end(),
+        doc->stored.begin(), doc->stored.end()
+      ));
+
+      if (i % 11 == 10) {
+        writer->commit(); // create multiple segments
+      }
+    }
+
+    writer->commit();
+
+    irs::by_term filter;
+    filter.field("name").term("C");
+    writer->remove(filter);
+    writer->commit();
+    writer->close();
+  }
+
+  auto reader = iresearch::directory_reader::open(dir, codec_ptr);
+  ASSERT_LT(1, reader.size());
+
+  auto merge = [&reader, &codec_ptr](
+      irs::directory& dir, irs::async_utils::thread_pool* pool) {
+    irs::merge_writer writer(dir, "merged", pool);
+
+    for (auto& segment : reader) {
+      writer.add(segment);
+    }
+
+    std::string filename;
+    iresearch::segment_meta meta;
+
+    meta.name = "merged";
+    meta.codec = codec_ptr;
+    ASSERT_TRUE(writer.flush(filename, meta));
+    ASSERT_EQ(reader.live_docs_count(), meta.docs_count);
+  };
+
+  // merge sequentially
+  iresearch::memory_directory expected_dir;
+  merge(expected_dir, nullptr);
+
+  // merge using a thread pool
+  irs::async_utils::thread_pool pool(1, 1);
+  iresearch::memory_directory actual_dir;
+  merge(actual_dir, &pool);
+  pool.stop();
+
+  // merged segments must be byte-identical
+  assert_equal_files(expected_dir, actual_dir);
+}
+
+TEST_F(merge_writer_tests, test_index_writer_merge_threads) {
+  tests::json_doc_generator gen(
+    test_base::resource("simple_sequential.json"),
+    [](tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+      static irs::flags extra_features = { irs::norm::type() };
+
+      if (data.is_string()) {
+        doc.insert(std::make_shared<tests::templates::string_field>(name, data.str, extra_features));
+      } else if (data.is_number()) {
+        doc.insert(std::make_shared<tests::templates::string_field>(name, std::to_string(data.as_number<uint64_t>())));
+      }
+  });
+
+  std::vector<const tests::document*> docs;
+
+  for (const tests::document* doc; (doc = gen.next());) {
+    docs.emplace_back(doc);
+  }
+
+  iresearch::version10::format codec;
+  iresearch::format::ptr codec_ptr(&codec, [](iresearch::format*)->void{});
+
+  auto always_merge = [](const irs::directory&, const irs::index_meta&)->irs::index_writer::consolidation_acceptor_t {
+    return [](const irs::segment_meta&)->bool { return true; };
+  };
+
+  // populate an index and consolidate all of its segments
+  auto consolidate = [&docs, &codec_ptr, &always_merge](
+      irs::directory& dir, size_t merge_threads) {
+    auto writer = iresearch::index_writer::make(dir, codec_ptr, iresearch::OM_CREATE);
+    writer->merge_threads(merge_threads);
+
+    for (size_t i = 0; i < docs.size(); ++i) {
+      ASSERT_TRUE(insert(*writer,
+        docs[i]->indexed.begin(), docs[i]->indexed.end(),
+        docs[i]->stored.begin(), docs[i]->stored.end()
+      ));
+
+      if (i % 11 == 10) {
+        writer->commit(); // create multiple segments
+      }
+    }
+
+    writer->commit();
+
+    irs::by_term filter;
+    filter.field("name").term("C");
+    writer->remove(filter);
+    writer->consolidate(always_merge, false);
+    writer->commit();
+    writer->close();
+
+    auto reader = iresearch::directory_reader::open(dir, codec_ptr);
+    ASSERT_EQ(1, reader.size());
+    ASSERT_EQ(docs.size() - 1, reader.live_docs_count());
+  };
+
+  // merge sequentially
+  iresearch::memory_directory expected_dir;
+  consolidate(expected_dir, 0);
+
+  // merge using the merge pool of the writer
+  iresearch::memory_directory actual_dir;
+  consolidate(actual_dir, 2);
+
+  // merged segments must be byte-identical
+  assert_equal_files(expected_dir, actual_dir);
+}
+
+TEST_F(merge_writer_tests, test_merge_writer_reorder) {
+  tests::json_doc_generator gen(
+    test_base::resource("simple_sequential.json"),
+    [](tests::document& doc, const std::string& name, const tests::json_doc_generator::json_value& data) {
+      static irs::flags extra_features = { irs::norm::type() };
+
+      if (data.is_string()) {
+        doc.insert(std::make_shared<tests::templates::string_field>(name, data.str, extra_features));
+      } else if (data.is_number()) {
+        doc.insert(std::make_shared<tests::templates::string_field>(name, std::to_string(data.as_number<uint64_t>())));
+      }
+  });
+
+  iresearch::version10::format codec;
+  iresearch::format::ptr codec_ptr(&codec, [](iresearch::format*)->void{});
+  iresearch::memory_directory dir;
+
+  // populate directory
+  {
+    auto writer = iresearch::index_writer::make(dir, codec_ptr, iresearch::OM_CREATE);
+    const tests::document* doc;
+
+    for (size_t i = 0; (doc = gen.next()); ++i) {
+      ASSERT_TRUE(insert(*writer,
+        doc->indexed.begin(), doc->indexed.end(),
+        doc->stored.begin(), doc->stored.end()
+      ));
+
+      if (i % 7 == 6) {
+        writer->commit(); // create multiple segments
+      }
+    }
+
+    writer->commit();
+
+    irs::by_term filter;
+    filter.field("name").term("C");
+    writer->remove(filter);
+    writer->commit();
+    writer->close();
+  }
+
+  auto reader = iresearch::directory_reader::open(dir, codec_ptr);
+  ASSERT_LT(1, reader.size());
+
+  // reads stored value of a field of a document
+  auto stored = [](const irs::sub_reader& segment, const irs::string_ref& field, irs::doc_id_t doc) {
+    auto* column = segment.column_reader(field);
+    irs::bytes_ref value;
+
+    if (!column || !column->values()(doc, value)) {
+      return std::string();
+    }
+
+    irs::bytes_ref_input in(value);
+    return irs::read_string<std::string>(in);
+  };
+
+  auto merge = [&reader, &codec_ptr](
+      irs::directory& dir,
+      const std::function<void(irs::merge_writer&)>& reorder) {
+    irs::merge_writer writer(dir, "merged");
+
+    for (auto& segment : reader) {
+      writer.add(segment);
+    }
+
+    reorder(writer);
+
+    std::string filename;
+    iresearch::segment_meta meta;
+
+    meta.name = "merged";
+    meta.codec = codec_ptr;
+    EXPECT_TRUE(writer.flush(filename, meta));
+    EXPECT_EQ(reader.live_docs_count(), meta.docs_count);
+
+    return irs::segment_reader::open(dir, meta);
+  };
+
+  // postings, norms and stored values of the merged segment must be consistent
+  auto validate = [&reader, &stored](const irs::sub_reader& segment) {
+    ASSERT_EQ(reader.live_docs_count(), segment.docs_count());
+    ASSERT_EQ(segment.docs_count(), segment.live_docs_count());
+
+    for (auto fields = segment.fields(); fields->next();) {
+      auto& terms = fields->value();
+      auto& field = terms.meta();
+
+      if (irs::type_limits<irs::type_t::field_id_t>::valid(field.norm)) {
+        size_t norms_count = 0;
+        auto* norms = segment.column_reader(field.norm);
+        ASSERT_NE(nullptr, norms);
+        ASSERT_TRUE(norms->visit([&norms_count](irs::doc_id_t, const irs::bytes_ref&) {
+          ++norms_count;
+          return true;
+        }));
+        ASSERT_EQ(terms.docs_count(), norms_count);
+      }
+
+      for (auto term = terms.iterator(); term->next();) {
+        const auto value = irs::ref_cast<char>(term->value());
+        auto docs = term->postings(field.features);
+        auto& freq = docs->attributes().get<irs::frequency>();
+        auto& pos = docs->attributes().get<irs::position>();
+        irs::doc_id_t prev = irs::type_limits<irs::type_t::doc_id_t>::invalid();
+
+        ASSERT_TRUE(freq);
+        ASSERT_TRUE(pos);
+
+        while (docs->next()) {
+          ASSERT_LT(prev, docs->value());
+          prev = docs->value();
+          ASSERT_EQ(std::string(value), stored(segment, field.name, prev));
+          ASSERT_EQ(1, freq->value);
+          ASSERT_TRUE(pos->next());
+          ASSERT_EQ(irs::type_limits<irs::type_t::pos_t>::min(), pos->value());
+          ASSERT_FALSE(pos->next());
+        }
+      }
+    }
+
+    // every live document is preserved
+    std::multiset<std::string> expected_names;
+    std::multiset<std::string> actual_names;
+
+    for (auto& source : reader) {
+      for (auto docs = source.docs_iterator(); docs->next();) {
+        expected_names.emplace(stored(source, "name", docs->value()));
+      }
+    }
+
+    for (auto docs = segment.docs_iterator(); docs->next();) {
+      actual_names.emplace(stored(segment, "name", docs->value()));
+    }
+
+    ASSERT_EQ(expected_names, actual_names);
+    ASSERT_EQ(0, actual_names.count("C"));
+  };
+
+  // order by descending 'name'
+  {
+    irs::memory_directory merged_dir;
+    auto segment = merge(merged_dir, [](irs::merge_writer& writer) {
+      writer.reorder([](const irs::sub_reader& segment, irs::doc_id_t doc, irs::bstring& key) {
+        irs::bytes_ref value;
+        ASSERT_TRUE(segment.column_reader("name")->values()(doc, value));
+
+        for (auto c : value) {
+          key.push_back(irs::byte_type(0xFF - c));
+        }
+      });
+    });
+    validate(segment);
+
+    std::string prev;
+
+    for (auto docs = segment.docs_iterator(); docs->next();) {
+      const auto name = stored(segment, "name", docs->value());
+
+      if (!prev.empty()) {
+        ASSERT_GT(prev, name);
+      }
+
+      prev = name;
+    }
+  }
+
+  // order by graph bisection
+  {
+    irs::memory_directory merged_dir;
+    auto segment = merge(merged_dir, [](irs::merge_writer& writer) {
+      writer.reorder("duplicated");
+    });
+    validate(segment);
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -26,6 +26,8 @@
 #include "utils/bitset.hpp"
 #include "utils/singleton.hpp"
 #include "search/bitset_doc_iterator.hpp"
+#include "search/conjunction.hpp"
+#include "search/disjunction.hpp"
 
 NS_LOCAL
 
@@ -850,6 +852,62 @@ TEST(bitset_iterator_test, seek_next) {
   }
 }
 
+TEST(bitset_iterator_test, combine) {
+  irs::bitset lhs(200), rhs(200), mid(200);
+
+  for (size_t i = 1; i < 200; i += 2) {
+    lhs.set(i);
+  }
+
+  for (size_t i = 65; i < 130; i += 3) {
+    rhs.set(i);
+  }
+
+  for (size_t i = 7; i < 200; i += 7) {
+    mid.set(i);
+  }
+
+  auto make_itrs = [&]() {
+    std::vector<irs::score_iterator_adapter> itrs;
+    itrs.emplace_back(irs::doc_iterator::make<irs::bitset_doc_iterator>(lhs));
+    itrs.emplace_back(irs::doc_iterator::make<irs::bitset_doc_iterator>(rhs));
+    itrs.emplace_back(irs::doc_iterator::make<irs::bitset_doc_iterator>(mid));
+    return itrs;
+  };
+
+  // unscored conjunction is evaluated word-wise
+  {
+    irs::conjunction it(make_itrs());
+    ASSERT_EQ(1, it.size());
+
+    for (size_t i = 0; i < 200; ++i) {
+      if (lhs.test(i) && rhs.test(i) && mid.test(i)) {
+        ASSERT_TRUE(it.next());
+        ASSERT_EQ(i, it.value());
+      }
+    }
+    ASSERT_FALSE(it.next());
+    ASSERT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(it.value()));
+  }
+
+  // unscored disjunction is evaluated word-wise
+  {
+    irs::disjunction it(make_itrs());
+    size_t count = 0;
+
+    for (size_t i = 1; i < 200; ++i) {
+      if (lhs.test(i) || rhs.test(i) || mid.test(i)) {
+        ASSERT_TRUE(it.next());
+        ASSERT_EQ(i, it.value());
+        ++count;
+      }
+    }
+    ASSERT_EQ(count, irs::cost::extract(it.attributes()));
+    ASSERT_FALSE(it.next());
+    ASSERT_TRUE(irs::type_limits<irs::type_t::doc_id_t>::eof(it.value()));
+  }
+}
+
 #endif
 
 // -----------------------------------------------------------------------------
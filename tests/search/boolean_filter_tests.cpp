@@ -3742,6 +3742,104 @@ protected:
     }
   }
 
+  // postings of frequency-less dense terms are combined word-wise, filtering
+  // iterators (exclusion, deleted documents) must not be taken as a bitset
+  void not_dense() {
+    struct {
+      const irs::string_ref& name() const {
+        return name_;
+      }
+
+      float_t boost() const {
+        return 1.f;
+      }
+
+      const irs::flags& features() const {
+        return irs::flags::empty_instance();
+      }
+
+      irs::token_stream& get_tokens() const {
+        stream_.reset("1");
+        return stream_;
+      }
+
+      irs::string_ref name_;
+      mutable irs::string_token_stream stream_;
+    } field;
+
+    const size_t count = 1024;
+
+    {
+      auto writer = open_writer();
+
+      for (size_t i = 0; i < count; ++i) {
+        ASSERT_TRUE(writer->insert([&field, i](irs::index_writer::document& doc) {
+          for (auto& entry : { std::make_pair("x", 1), std::make_pair("y", 2),
+                               std::make_pair("z", 3), std::make_pair("w", 5) }) {
+            if (0 == i % entry.second) {
+              field.name_ = entry.first;
+              doc.insert(irs::action::index, field);
+            }
+          }
+          return false;
+        }));
+      }
+
+      writer->commit();
+    }
+
+    // x=1 AND (y=1 AND NOT z=1)
+    iresearch::And root;
+    root.add<iresearch::by_term>().field("x").term("1");
+    auto& nested = root.add<iresearch::And>();
+    nested.add<iresearch::by_term>().field("y").term("1");
+    nested.add<iresearch::Not>().filter<iresearch::by_term>().field("z").term("1");
+
+    {
+      docs_t expected;
+
+      for (size_t i = 0; i < count; ++i) {
+        if (0 == i % 2 && i % 3) {
+          expected.push_back(irs::doc_id_t(irs::type_limits<irs::type_t::doc_id_t>::min() + i));
+        }
+      }
+
+      check_query(root, expected, open_reader());
+    }
+
+    // documents with w=1 are removed
+    {
+      auto writer = open_writer(irs::OPEN_MODE::OM_APPEND);
+      irs::by_term removed;
+      removed.field("w").term("1");
+      writer->remove(removed);
+      writer->commit();
+    }
+
+    // masked postings aren't exposed as a bitset
+    {
+      auto rdr = open_reader();
+      ASSERT_EQ(1, rdr.size());
+      auto& segment = rdr[0];
+      auto* field = segment.field("y");
+      ASSERT_NE(nullptr, field);
+      auto terms = field->iterator();
+      ASSERT_TRUE(terms->next());
+      ASSERT_TRUE(bool(terms->postings(irs::flags::empty_instance())->attributes().get<irs::doc_bitset>()));
+
+      auto docs = segment.mask(terms->postings(irs::flags::empty_instance()));
+      ASSERT_FALSE(docs->attributes().get<irs::doc_bitset>());
+
+      for (size_t i = 0; i < count; ++i) {
+        if (0 == i % 2 && i % 5) {
+          ASSERT_TRUE(docs->next());
+          ASSERT_EQ(irs::type_limits<irs::type_t::doc_id_t>::min() + i, docs->value());
+        }
+      }
+      ASSERT_FALSE(docs->next());
+    }
+  }
+
   void not_sequential() {
     // add segment
     {
@@ -4553,6 +4651,7 @@ TEST_F( memory_boolean_test_case, and) {
 }
 
 TEST_F(memory_boolean_test_case, not) {
+  not_dense();
   not_standalone_sequential();
   not_standalone_sequential_ordered();
   not_sequential();
@@ -4590,6 +4689,7 @@ TEST_F(fs_boolean_filter_test_case, and ) {
 }
 
 TEST_F(fs_boolean_filter_test_case, not) {
+  not_dense();
   not_standalone_sequential();
   not_standalone_sequential_ordered();
   not_sequential();
@@ -0,0 +1,449 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index/index_tests.hpp"
+#include "store/memory_directory.hpp"
+#include "store/store_utils.hpp"
+#include "search/granular_range_filter.hpp"
+#include "search/points_range_filter.hpp"
+
+#include <random>
+#include <set>
+
+NS_BEGIN(tests)
+
+class granular_long_field: public long_field {
+ public:
+  const irs::flags& features() const {
+    static const irs::flags features{ irs::granularity_prefix::type() };
+    return features;
+  }
+};
+
+class granular_double_field: public double_field {
+ public:
+  const irs::flags& features() const {
+    static const irs::flags features{ irs::granularity_prefix::type() };
+    return features;
+  }
+};
+
+class points_range_filter_test: public index_test_base {
+ protected:
+  virtual irs::directory* get_directory() override {
+    return new irs::memory_directory();
+  }
+
+  virtual irs::format::ptr get_codec() override {
+    return irs::formats::get("1_0");
+  }
+
+  // every document except for every 17th one has a stored 'value' within
+  // [-1000, 1000) indexed into 'field', documents of 'number' field have the
+  // same value indexed as a double shifted by 0.5 as well
+  template<typename Field>
+  void populate(
+      irs::index_writer& writer,
+      const std::string& field,
+      size_t segments,
+      size_t docs_per_segment) {
+    std::mt19937 rng(42);
+
+    for (size_t s = 0; s < segments; ++s) {
+      for (size_t i = 0; i < docs_per_segment; ++i) {
+        ASSERT_TRUE(writer.insert([&rng, &field, i](irs::index_writer::document& doc) {
+          if (!(i % 17)) {
+            return false;
+          }
+
+          Field value;
+          value.name(field);
+          value.value(int64_t(rng() % 2000) - 1000);
+          doc.insert(irs::action::index_store, value);
+
+          if ("number" == field) {
+            granular_double_field shifted;
+            shifted.name(field);
+            shifted.value(value.value() + 0.5);
+            doc.insert(irs::action::index, shifted);
+          }
+
+          return false;
+        }));
+      }
+
+      writer.commit(); // one segment per commit
+    }
+  }
+};
+
+typedef std::set<std::pair<size_t, irs::doc_id_t>> docs_t; // segment + doc
+
+// documents of the stored 'field' values satisfying 'pred'
+template<typename Predicate>
+docs_t expected(
+    const irs::index_reader& reader,
+    const std::string& field,
+    Predicate pred) {
+  docs_t docs;
+  size_t i = 0;
+
+  for (auto& segment : reader) {
+    auto* column = segment.column_reader(field);
+
+    if (column) {
+      auto values = column->values();
+      irs::bytes_ref value;
+
+      for (auto it = segment.docs_iterator(); it->next();) {
+        if (values(it->value(), value)) {
+          irs::bytes_ref_input in(value);
+
+          if (pred(irs::read_zvlong(in))) {
+            docs.emplace(i, it->value());
+          }
+        }
+      }
+    }
+
+    ++i;
+  }
+
+  return docs;
+}
+
+docs_t execute(const irs::index_reader& reader, const irs::filter& filter) {
+  auto prepared = filter.prepare(reader);
+  docs_t docs;
+  size_t i = 0;
+
+  for (auto& segment : reader) {
+    irs::doc_id_t prev = 0;
+
+    for (auto it = prepared->execute(segment); it->next();) {
+      EXPECT_LT(prev, it->value()); // ordered without duplicates
+      prev = it->value();
+      docs.emplace(i, it->value());
+    }
+
+    ++i;
+  }
+
+  return docs;
+}
+
+irs::bstring encode(int64_t value) {
+  irs::bstring buf;
+  return irs::numeric_token_stream::value(buf, value);
+}
+
+template<irs::Bound B>
+void bound(irs::by_points_range& filter, int64_t value, bool include) {
+  irs::numeric_token_stream stream;
+  stream.reset(value);
+  filter.term<B>(stream).template include<B>(include);
+}
+
+template<irs::Bound B>
+void bound(irs::by_granular_range& filter, int64_t value, bool include) {
+  irs::numeric_token_stream stream;
+  stream.reset(value);
+  filter.insert<B>(stream).template include<B>(include);
+}
+
+// visitor accepting values within [min, max]
+class range_visitor : public irs::points_visitor {
+ public:
+  range_visitor(int64_t min, int64_t max)
+    : min_(encode(min)), max_(encode(max)) {
+  }
+
+  virtual relation compare(
+      const irs::bytes_ref& min, const irs::bytes_ref& max) override {
+    ++cells;
+
+    if (max < min_ || max_ < min) {
+      return relation::OUTSIDE;
+    }
+
+    return min_ <= min && max <= max_ ? relation::INSIDE : relation::CROSSES;
+  }
+
+  virtual void visit(irs::doc_id_t) override {
+    ++inside;
+  }
+
+  virtual void visit(irs::doc_id_t, const irs::bytes_ref& value) override {
+    EXPECT_LE(last, value); // points are visited in order of their values
+    last = value;
+    ++crossing;
+    matched += size_t(min_ <= value && value <= max_);
+  }
+
+  size_t cells{};
+  size_t inside{};
+  size_t crossing{};
+  size_t matched{};
+  irs::bstring last;
+
+ private:
+  irs::bstring min_;
+  irs::bstring max_;
+};
+
+NS_END
+
+using namespace tests;
+
+TEST(by_points_range_test, ctor) {
+  irs::by_points_range q;
+  ASSERT_EQ(irs::by_points_range::type(), q.type());
+  ASSERT_TRUE(q.field().empty());
+  ASSERT_TRUE(q.term<irs::Bound::MIN>().empty());
+  ASSERT_FALSE(q.include<irs::Bound::MIN>());
+  ASSERT_TRUE(q.term<irs::Bound::MAX>().empty());
+  ASSERT_FALSE(q.include<irs::Bound::MAX>());
+}
+
+TEST(by_points_range_test, equal) {
+  irs::by_points_range q0, q1, q2;
+  q0.field("field");
+  bound<irs::Bound::MIN>(q0, 1, true);
+  bound<irs::Bound::MAX>(q0, 5, false);
+  q1.field("field");
+  bound<irs::Bound::MIN>(q1, 1, true);
+  bound<irs::Bound::MAX>(q1, 5, false);
+  q2.field("field");
+  bound<irs::Bound::MIN>(q2, 1, true);
+  bound<irs::Bound::MAX>(q2, 5, true);
+
+  ASSERT_EQ(q0, q1);
+  ASSERT_EQ(q0.hash(), q1.hash());
+  ASSERT_NE(q0, q2);
+}
+
+TEST_F(points_range_filter_test, intersect) {
+  {
+    auto writer = open_writer();
+    populate<granular_long_field>(*writer, "value", 1, 3000);
+  }
+
+  auto reader = open_reader();
+  ASSERT_EQ(1, reader.size());
+  auto& segment = reader[0];
+  auto* field = segment.field("value");
+  ASSERT_NE(nullptr, field);
+
+  const auto all = expected(reader, "value", [](int64_t) { return true; }).size();
+  const auto some = expected(reader, "value", [](int64_t v) {
+    return v >= -500 && v <= 500;
+  }).size();
+
+  // every point is visited once, blocks within the range aren't compared
+  {
+    range_visitor visitor(-500, 500);
+    ASSERT_TRUE(field->intersect(visitor));
+    ASSERT_EQ(some, visitor.inside + visitor.matched);
+    ASSERT_LT(0, visitor.inside);
+    ASSERT_LT(visitor.crossing + visitor.inside, all);
+  }
+
+  // whole tree is inside
+  {
+    range_visitor visitor(-1000, 1000);
+    ASSERT_TRUE(field->intersect(visitor));
+    ASSERT_EQ(1, visitor.cells);
+    ASSERT_EQ(all, visitor.inside);
+    ASSERT_EQ(0, visitor.crossing);
+  }
+
+  // whole tree is outside
+  {
+    range_visitor visitor(2000, 3000);
+    ASSERT_TRUE(field->intersect(visitor));
+    ASSERT_EQ(1, visitor.cells);
+    ASSERT_EQ(0, visitor.inside + visitor.crossing);
+  }
+}
+
+TEST_F(points_range_filter_test, ranges) {
+  {
+    auto writer = open_writer();
+    populate<granular_long_field>(*writer, "value", 3, 1500);
+  }
+
+  auto reader = open_reader();
+
+  // merged segments get the points index rebuilt
+  for (int merge = 0; merge < 2; ++merge) {
+    for (auto& segment : reader) {
+      auto* field = segment.field("value");
+      ASSERT_NE(nullptr, field);
+      range_visitor visitor(0, 0);
+      ASSERT_TRUE(field->intersect(visitor));
+    }
+
+    for (auto& range : std::vector<std::pair<int64_t, int64_t>>{
+           { -1000, 999 }, { -5, 5 }, { 0, 0 }, { 17, 400 }, { -999, -998 },
+           { 500, 100 }, { 1000, 2000 }
+         }) {
+      for (int incl = 0; incl < 4; ++incl) {
+        const bool min_incl = incl & 1, max_incl = incl & 2;
+        SCOPED_TRACE(::testing::Message("range: ") << range.first << ", " << range.second << ", " << incl);
+
+        auto docs = expected(reader, "value", [&](int64_t v) {
+          return (min_incl ? v >= range.first : v > range.first)
+            && (max_incl ? v <= range.second : v < range.second);
+        });
+
+        irs::by_points_range points;
+        points.field("value");
+        bound<irs::Bound::MIN>(points, range.first, min_incl);
+        bound<irs::Bound::MAX>(points, range.second, max_incl);
+        ASSERT_EQ(docs, execute(reader, points));
+
+        if (range.first > range.second) {
+          continue; // by_granular_range doesn't handle inverted ranges
+        }
+
+        irs::by_granular_range granular;
+        granular.field("value");
+        bound<irs::Bound::MIN>(granular, range.first, min_incl);
+        bound<irs::Bound::MAX>(granular, range.second, max_incl);
+        ASSERT_EQ(docs, execute(reader, granular));
+      }
+    }
+
+    // open ranges
+    {
+      irs::by_points_range points;
+      points.field("value");
+      bound<irs::Bound::MIN>(points, 250, true);
+      ASSERT_EQ(
+        expected(reader, "value", [](int64_t v) { return v >= 250; }),
+        execute(reader, points)
+      );
+    }
+
+    {
+      irs::by_points_range points;
+      points.field("value");
+      bound<irs::Bound::MAX>(points, -250, false);
+      ASSERT_EQ(
+        expected(reader, "value", [](int64_t v) { return v < -250; }),
+        execute(reader, points)
+      );
+    }
+
+    {
+      irs::by_points_range points;
+      points.field("value");
+      ASSERT_EQ(
+        expected(reader, "value", [](int64_t) { return true; }),
+        execute(reader, points)
+      );
+    }
+
+    if (!merge) {
+      irs::index_writer::consolidation_policy_t policy = [](
+          const irs::directory&, const irs::index_meta&) {
+        return [](const irs::segment_meta&)->bool { return true; };
+      };
+
+      auto writer = open_writer(irs::OPEN_MODE::OM_APPEND);
+      writer->consolidate(policy, false);
+      writer->commit();
+      reader = reader.reopen();
+      ASSERT_EQ(1, reader.size());
+    }
+  }
+}
+
+TEST_F(points_range_filter_test, mixed_types) {
+  {
+    auto writer = open_writer();
+    populate<granular_long_field>(*writer, "number", 1, 2000);
+  }
+
+  auto reader = open_reader();
+
+  // open bound doesn't reach values of the other numeric type
+  {
+    irs::by_points_range points;
+    points.field("number");
+    bound<irs::Bound::MIN>(points, 0, true);
+    ASSERT_EQ(
+      expected(reader, "number", [](int64_t v) { return v >= 0; }),
+      execute(reader, points)
+    );
+  }
+
+  {
+    irs::by_points_range points;
+    points.field("number");
+    bound<irs::Bound::MAX>(points, 0, true);
+    ASSERT_EQ(
+      expected(reader, "number", [](int64_t v) { return v <= 0; }),
+      execute(reader, points)
+    );
+  }
+
+  {
+    irs::by_points_range points;
+    irs::numeric_token_stream stream;
+    stream.reset(double_t(-10.));
+    points.field("number").term<irs::Bound::MIN>(stream);
+    stream.reset(double_t(10.));
+    points.term<irs::Bound::MAX>(stream);
+    ASSERT_EQ(
+      expected(reader, "number", [](int64_t v) { return v + 0.5 > -10. && v + 0.5 < 10.; }),
+      execute(reader, points)
+    );
+  }
+}
+
+TEST_F(points_range_filter_test, no_points_index) {
+  {
+    auto writer = open_writer();
+    populate<long_field>(*writer, "value", 2, 1000);
+  }
+
+  auto reader = open_reader();
+
+  for (auto& segment : reader) {
+    auto* field = segment.field("value");
+    ASSERT_NE(nullptr, field);
+    range_visitor visitor(0, 0);
+    ASSERT_FALSE(field->intersect(visitor));
+  }
+
+  // evaluated over the exact terms
+  irs::by_points_range points;
+  points.field("value");
+  bound<irs::Bound::MIN>(points, -300, false);
+  bound<irs::Bound::MAX>(points, 300, true);
+  ASSERT_EQ(
+    expected(reader, "value", [](int64_t v) { return v > -300 && v <= 300; }),
+    execute(reader, points)
+  );
+}
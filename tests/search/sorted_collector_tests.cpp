@@ -0,0 +1,328 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index/index_tests.hpp"
+#include "store/memory_directory.hpp"
+#include "search/sorted_collector.hpp"
+#include "search/term_filter.hpp"
+
+#include <random>
+#include <set>
+
+NS_BEGIN(tests)
+
+class sorted_collector_test: public index_test_base {
+ protected:
+  virtual irs::directory* get_directory() override {
+    return new irs::memory_directory();
+  }
+
+  virtual irs::format::ptr get_codec() override {
+    return irs::formats::get("1_0");
+  }
+
+  // every document has a 'tag' out of "a", "b", "c" and, except for every
+  // 13th one, a random stored 'key', documents tagged "c" are removed
+  void populate(irs::index_writer& writer, size_t segments, size_t docs_per_segment) {
+    std::mt19937 rng(42);
+
+    for (size_t s = 0; s < segments; ++s) {
+      for (size_t i = 0; i < docs_per_segment; ++i) {
+        ASSERT_TRUE(writer.insert([&rng, i](irs::index_writer::document& doc) {
+          templates::string_field tag("tag", std::string(1, char('a' + rng() % 3)));
+          doc.insert(irs::action::index, tag);
+
+          if (i % 13) {
+            char value[16];
+            std::snprintf(value, sizeof value, "%06u", unsigned(rng() % 1000000));
+            templates::string_field key("key", value);
+            doc.insert(irs::action::store, key);
+          }
+
+          return false;
+        }));
+      }
+
+      irs::by_term removed;
+      removed.field("tag").term("c");
+      writer.remove(removed);
+      writer.commit(); // one segment per commit
+    }
+  }
+};
+
+typedef std::pair<irs::bstring, bool> doc_key; // value + has value
+
+// value of the 'key' column of a document
+doc_key key(const irs::sub_reader& segment, irs::doc_id_t doc) {
+  auto* column = segment.column_reader("key");
+  irs::bytes_ref value;
+
+  if (!column || !column->values()(doc, value)) {
+    return doc_key(irs::bstring(), false);
+  }
+
+  return doc_key(irs::bstring(value.c_str(), value.size()), true);
+}
+
+bool key_less(const doc_key& lhs, const doc_key& rhs) {
+  if (lhs.second != rhs.second) {
+    return lhs.second; // documents without a value go last
+  }
+
+  return lhs.first < rhs.first;
+}
+
+std::vector<irs::bstring> collect(
+    const irs::index_reader& reader,
+    const irs::filter::prepared& filter,
+    size_t k,
+    size_t& hits) {
+  irs::sorted_collector collector("key", k);
+  std::vector<irs::bstring> keys;
+
+  collector.collect(reader, filter);
+  collector.visit([&keys](const irs::sorted_collector::entry& entry) {
+    const auto expected = key(*entry.segment, entry.doc);
+    EXPECT_EQ(expected.second, !entry.value.null());
+    EXPECT_EQ(expected.first, irs::bstring(entry.value.c_str(), entry.value.size()));
+    keys.emplace_back(expected.first);
+    return true;
+  });
+  hits = collector.hits();
+
+  return keys;
+}
+
+NS_END
+
+using namespace tests;
+
+TEST_F(sorted_collector_test, sorted_segments) {
+  {
+    auto writer = irs::index_writer::make(dir(), codec(), irs::OM_CREATE, "key");
+    ASSERT_EQ("key", writer->sort());
+    populate(*writer, 3, 500);
+  }
+
+  auto reader = open_reader();
+  ASSERT_EQ(3, reader.size());
+
+  for (auto& segment : reader) {
+    ASSERT_EQ("key", segment.sort());
+    ASSERT_NE(segment.docs_count(), segment.live_docs_count()); // removals applied
+
+    // documents follow the order of keys, removed documents stay removed
+    doc_key prev;
+    size_t count = 0;
+
+    for (auto docs = segment.docs_iterator(); docs->next(); ++count) {
+      auto value = key(segment, docs->value());
+
+      if (count) {
+        ASSERT_FALSE(key_less(value, prev));
+      }
+
+      prev = value;
+    }
+
+    auto* tag = segment.field("tag");
+    ASSERT_NE(nullptr, tag);
+    auto terms = tag->iterator();
+    ASSERT_TRUE(terms->seek(irs::ref_cast<irs::byte_type>(irs::string_ref("c"))));
+    ASSERT_FALSE(segment.mask(terms->postings(irs::flags::empty_instance()))->next());
+  }
+
+  // the first documents in order of keys
+  irs::by_term filter;
+  filter.field("tag").term("a");
+  auto prepared = filter.prepare(reader);
+
+  std::vector<doc_key> expected;
+  size_t expected_hits = 0;
+
+  for (auto& segment : reader) {
+    for (auto docs = prepared->execute(segment); docs->next(); ++expected_hits) {
+      expected.emplace_back(key(segment, docs->value()));
+    }
+  }
+
+  std::stable_sort(expected.begin(), expected.end(), key_less);
+
+  for (size_t k : { 1, 10, 100, 10000 }) {
+    size_t hits;
+    auto actual = collect(reader, *prepared, k, hits);
+
+    ASSERT_EQ(std::min(k, expected.size()), actual.size());
+
+    for (size_t i = 0; i < actual.size(); ++i) {
+      ASSERT_EQ(expected[i].first, actual[i]);
+    }
+
+    // collection of sorted segments stops early
+    ASSERT_LE(hits, std::min(expected_hits, (k + 1) * reader.size()));
+  }
+}
+
+TEST_F(sorted_collector_test, unsorted_segments) {
+  {
+    auto writer = open_writer();
+    populate(*writer, 3, 500);
+  }
+
+  auto reader = open_reader();
+  ASSERT_EQ(3, reader.size());
+
+  for (auto& segment : reader) {
+    ASSERT_TRUE(segment.sort().empty());
+  }
+
+  irs::by_term filter;
+  filter.field("tag").term("a");
+  auto prepared = filter.prepare(reader);
+  size_t expected_hits = 0;
+
+  for (auto& segment : reader) {
+    for (auto docs = prepared->execute(segment); docs->next(); ++expected_hits) { }
+  }
+
+  size_t hits;
+  auto actual = collect(reader, *prepared, 10, hits);
+  ASSERT_EQ(10, actual.size());
+  ASSERT_TRUE(std::is_sorted(actual.begin(), actual.end()));
+  ASSERT_EQ(expected_hits, hits); // every match is examined
+}
+
+TEST_F(sorted_collector_test, sorted_flush_and_merge) {
+  {
+    auto writer = irs::index_writer::make(dir(), codec(), irs::OM_CREATE, "key");
+    writer->segment_memory_max(1); // flush every batch in background
+    populate(*writer, 2, 100);
+
+    // merged segment is sorted as well, regardless of its sources
+    irs::index_writer::consolidation_policy_t policy = [](
+        const irs::directory&, const irs::index_meta&) {
+      return [](const irs::segment_meta&)->bool { return true; };
+    };
+
+    writer->consolidate(policy, false);
+    writer->commit();
+  }
+
+  auto reader = open_reader();
+  ASSERT_EQ(1, reader.size());
+
+  auto& segment = reader[0];
+  ASSERT_EQ("key", segment.sort());
+  ASSERT_EQ(segment.docs_count(), segment.live_docs_count());
+
+  doc_key prev;
+  size_t count = 0;
+
+  for (auto docs = segment.docs_iterator(); docs->next(); ++count) {
+    auto value = key(segment, docs->value());
+
+    if (count) {
+      ASSERT_FALSE(key_less(value, prev));
+    }
+
+    prev = value;
+  }
+
+  // documents tagged "c" have been removed
+  auto* tag = segment.field("tag");
+  ASSERT_NE(nullptr, tag);
+  ASSERT_EQ(count, tag->docs_count());
+  auto terms = tag->iterator();
+  ASSERT_FALSE(terms->seek(irs::ref_cast<irs::byte_type>(irs::string_ref("c"))));
+}
+
+TEST_F(sorted_collector_test, sorted_merge_with_removals) {
+  // keys of the live documents, sorted
+  auto live_keys = [](const irs::index_reader& reader) {
+    std::vector<doc_key> keys;
+
+    for (auto& segment : reader) {
+      for (auto docs = segment.docs_iterator(); docs->next();) {
+        keys.emplace_back(key(segment, docs->value()));
+      }
+    }
+
+    std::sort(keys.begin(), keys.end(), &key_less);
+    return keys;
+  };
+
+  irs::index_writer::consolidation_policy_t policy = [](
+      const irs::directory&, const irs::index_meta&) {
+    return [](const irs::segment_meta&)->bool { return true; };
+  };
+
+  auto writer = irs::index_writer::make(dir(), codec(), irs::OM_CREATE, "key");
+  populate(*writer, 2, 100);
+
+  writer->consolidation_threads(0); // suspend background merges
+  ASSERT_TRUE(writer->consolidate_async(policy));
+
+  // removals made while the merge is pending
+  irs::by_term removed;
+  removed.field("tag").term("b");
+  writer->remove(removed);
+  writer->commit();
+
+  std::vector<doc_key> expected;
+
+  {
+    auto reader = open_reader();
+    ASSERT_EQ(2, reader.size());
+    expected = live_keys(reader);
+  }
+
+  writer->consolidation_threads(1); // resume background merges
+  writer->wait_for_consolidation();
+  writer->commit();
+
+  auto reader = open_reader();
+  ASSERT_EQ(1, reader.size());
+
+  // merged segment is sorted, removals are applied to the reordered documents
+  auto& segment = reader[0];
+  ASSERT_EQ("key", segment.sort());
+  ASSERT_LT(segment.live_docs_count(), segment.docs_count());
+  ASSERT_EQ(expected.size(), segment.live_docs_count());
+  ASSERT_EQ(expected, live_keys(reader));
+
+  // none of the documents tagged "b" is live
+  auto* tag = segment.field("tag");
+  ASSERT_NE(nullptr, tag);
+  auto terms = tag->iterator();
+  ASSERT_TRUE(terms->seek(irs::ref_cast<irs::byte_type>(irs::string_ref("b"))));
+  std::set<irs::doc_id_t> live;
+
+  for (auto docs = segment.docs_iterator(); docs->next();) {
+    live.insert(docs->value());
+  }
+
+  for (auto docs = terms->postings(irs::flags::empty_instance()); docs->next();) {
+    ASSERT_EQ(0, live.count(docs->value()));
+  }
+}
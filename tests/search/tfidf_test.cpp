@@ -24,6 +24,7 @@
 #include "tests_shared.hpp"
 #include "index/index_tests.hpp"
 #include "store/memory_directory.hpp"
+#include "search/boolean_filter.hpp"
 #include "search/phrase_filter.hpp"
 #include "search/range_filter.hpp"
 #include "search/scorers.hpp"
@@ -33,6 +34,8 @@
 #include "search/tfidf.hpp"
 #include "utils/utf8_path.hpp"
 
+#include <random>
+
 NS_BEGIN(tests)
 
 class tfidf_test: public index_test_base { 
@@ -508,6 +511,24 @@ TEST_F(tfidf_test, test_query) {
   }
 }
 
+TEST_F(tfidf_test, test_top_k_pruning) {
+  const std::vector<std::string> terms{
+    "a", "b", "c", "d", "e", "f", "g", "h", "i", "j"
+  };
+
+  {
+    std::mt19937 rng(42);
+    auto writer = open_writer();
+    insert_skewed_terms(*writer, terms, 20000, rng);
+    writer->commit();
+  }
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(1, reader.size());
+
+  assert_top_k_pruning(reader, irs::tfidf_sort::make(), terms);
+}
+
 #ifndef IRESEARCH_DLL
 
 TEST_F(tfidf_test, test_make) {
@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "index/index_tests.hpp"
+#include "store/memory_directory.hpp"
+#include "search/boolean_filter.hpp"
+#include "search/bm25.hpp"
+#include "search/score.hpp"
+#include "search/term_filter.hpp"
+#include "search/top_k.hpp"
+
+#include <random>
+
+NS_BEGIN(tests)
+
+class top_k_test: public index_test_base {
+ protected:
+  virtual irs::directory* get_directory() override {
+    return new irs::memory_directory();
+  }
+
+  virtual irs::format::ptr get_codec() override {
+    return irs::formats::get("1_0");
+  }
+
+  void populate(size_t segments, size_t docs_per_segment) {
+    std::mt19937 rng(42);
+    auto writer = open_writer();
+
+    for (size_t s = 0; s < segments; ++s) {
+      insert_skewed_terms(*writer, terms_, docs_per_segment, rng);
+      writer->commit(); // one segment per commit
+    }
+  }
+
+  void make_filter(irs::Or& filter) const {
+    for (auto& term : terms_) {
+      filter.add<irs::by_term>().field("field").term(term);
+    }
+  }
+
+  const std::vector<std::string> terms_{
+    "a", "b", "c", "d", "e", "f", "g", "h", "i", "j"
+  };
+};
+
+struct result_entry {
+  const irs::sub_reader* segment;
+  irs::doc_id_t doc;
+  irs::bstring score;
+
+  bool operator==(const result_entry& rhs) const {
+    return segment == rhs.segment && doc == rhs.doc && score == rhs.score;
+  }
+};
+
+std::vector<result_entry> results(
+    const irs::top_k_collector& collector,
+    const irs::order::prepared& order) {
+  std::vector<result_entry> entries;
+
+  collector.visit([&entries, &order](const irs::top_k_collector::entry& e) {
+    entries.push_back(result_entry{
+      e.segment, e.doc, irs::bstring(e.score, order.size())
+    });
+    return true;
+  });
+
+  return entries;
+}
+
+NS_END
+
+using namespace tests;
+
+TEST_F(top_k_test, collect_ordered) {
+  populate(3, 5000);
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(3, reader.size());
+
+  irs::Or filter;
+  make_filter(filter);
+
+  irs::order order;
+  order.add<irs::bm25_sort>(true);
+  auto prepared_order = order.prepare();
+  auto prepared_filter = filter.prepare(reader, prepared_order);
+
+  // exhaustive evaluation, equal scores are ranked in the order of insertion
+  auto comparer = [&prepared_order](const irs::bstring& lhs, const irs::bstring& rhs)->bool {
+    return prepared_order.less(lhs.c_str(), rhs.c_str());
+  };
+  std::multimap<
+    irs::bstring,
+    std::pair<const irs::sub_reader*, irs::doc_id_t>,
+    decltype(comparer)
+  > sorted(comparer);
+  size_t expected_hits = 0;
+
+  for (auto& segment : reader) {
+    auto docs = prepared_filter->execute(segment, prepared_order);
+    auto& score = docs->attributes().get<irs::score>();
+    ASSERT_TRUE(bool(score));
+
+    while (docs->next()) {
+      ++expected_hits;
+      score->evaluate();
+      sorted.emplace(score->value(), std::make_pair(&segment, docs->value()));
+    }
+  }
+
+  for (size_t k : { 1, 10, 100 }) {
+    std::vector<result_entry> expected;
+
+    for (auto& entry : sorted) {
+      if (expected.size() == k) {
+        break;
+      }
+
+      expected.push_back(result_entry{
+        entry.second.first, entry.second.second, entry.first
+      });
+    }
+
+    // sequential
+    {
+      irs::top_k_collector collector(prepared_order, k);
+      ASSERT_EQ(nullptr, collector.threshold());
+      collector.collect(reader, *prepared_filter);
+      ASSERT_TRUE(collector.full());
+      ASSERT_NE(nullptr, collector.threshold());
+      ASSERT_LT(collector.hits(), expected_hits); // pruned by the threshold
+      ASSERT_EQ(expected, results(collector, prepared_order));
+
+      // reuse after clear
+      collector.clear();
+      ASSERT_TRUE(collector.empty());
+      ASSERT_EQ(0, collector.hits());
+      collector.collect(reader, *prepared_filter);
+      ASSERT_EQ(expected, results(collector, prepared_order));
+    }
+
+    // parallel
+    {
+      irs::top_k_collector collector(prepared_order, k);
+      collector.collect(reader, *prepared_filter, 4);
+      ASSERT_TRUE(collector.full());
+      ASSERT_EQ(expected, results(collector, prepared_order));
+    }
+  }
+}
+
+TEST_F(top_k_test, collect_unordered) {
+  populate(2, 100);
+
+  auto reader = irs::directory_reader::open(dir(), codec());
+  ASSERT_EQ(2, reader.size());
+
+  irs::Or filter;
+  make_filter(filter);
+
+  auto& prepared_order = irs::order::prepared::unordered();
+  auto prepared_filter = filter.prepare(reader, prepared_order);
+
+  // the first matched documents are retained, evaluation stops once full
+  {
+    irs::top_k_collector collector(prepared_order, 5);
+    collector.collect(reader, *prepared_filter);
+    ASSERT_EQ(5, collector.size());
+    ASSERT_EQ(5, collector.hits());
+
+    auto docs = prepared_filter->execute(reader[0]);
+    std::vector<result_entry> expected;
+
+    while (expected.size() < 5 && docs->next()) {
+      expected.push_back(result_entry{ &reader[0], docs->value(), irs::bstring() });
+    }
+
+    ASSERT_EQ(expected, results(collector, prepared_order));
+  }
+
+  // nothing to collect
+  {
+    irs::top_k_collector collector(prepared_order, 0);
+    collector.collect(reader, *prepared_filter);
+    ASSERT_TRUE(collector.empty());
+    ASSERT_EQ(nullptr, collector.threshold());
+    ASSERT_TRUE(collector.visit([](const irs::top_k_collector::entry&) {
+      return false;
+    }));
+  }
+}
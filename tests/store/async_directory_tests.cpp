@@ -0,0 +1,231 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+
+#ifdef _WIN32
+  #include <boost/locale/encoding.hpp> // for boost::locale::conv::utf_to_utf()
+#endif
+
+#include "directory_test_case.hpp"
+#include "store/async_directory.hpp"
+#include "utils/locale_utils.hpp"
+
+#include <thread>
+
+class async_directory_test : public directory_test_case,
+  public test_base {
+  public:
+  explicit async_directory_test(const std::string& name = "directory") {
+    static auto utf8_locale = iresearch::locale_utils::locale("", true);
+
+    test_base::SetUp();
+    codecvt_ = &std::use_facet<boost::filesystem::path::codecvt_type>(utf8_locale);
+    path_ = test_case_dir();
+#ifdef _WIN32
+    // convert utf8->ucs2
+    auto native_name = boost::locale::conv::utf_to_utf<wchar_t>(
+      name.c_str(), name.c_str() + name.size()
+    );
+    path_.append(std::move(native_name));
+#else
+    path_.append(name);
+#endif
+  }
+
+  virtual void SetUp() override {
+    auto str = path_.string(*codecvt_);
+
+    dir_ = irs::directory::make<irs::async_directory>(str);
+    iresearch::async_directory::remove_directory(str);
+    iresearch::async_directory::create_directory(str);
+  }
+
+  virtual void TearDown() override {
+    iresearch::async_directory::remove_directory(path_.string(*codecvt_));
+  }
+
+  virtual void TestBody() override {}
+
+  std::string dir_path() const {
+    return path_.string(*codecvt_);
+  }
+
+  // writes a file of the specified size where every byte depends on its offset
+  void write_pattern(const std::string& name, size_t size) {
+    auto out = dir_->create(name);
+    ASSERT_NE(nullptr, out);
+
+    for (size_t i = 0; i < size; ++i) {
+      out->write_byte(irs::byte_type(i % 251));
+    }
+
+    out->close();
+  }
+
+  // reads 'len' bytes at 'offset' and checks them against the pattern
+  void assert_pattern(irs::index_input& in, size_t offset, size_t len) {
+    std::vector<irs::byte_type> buf(len);
+    in.seek(offset);
+    ASSERT_EQ(len, in.read_bytes(buf.data(), len));
+
+    for (size_t i = 0; i < len; ++i) {
+      ASSERT_EQ(irs::byte_type((offset + i) % 251), buf[i]) << offset + i;
+    }
+  }
+
+  private:
+  const boost::filesystem::path::codecvt_type* codecvt_;
+  boost::filesystem::path path_;
+};
+
+TEST_F(async_directory_test, read_multiple_streams) {
+  read_multiple_streams();
+}
+
+TEST_F(async_directory_test, string_read_write) {
+  string_read_write();
+}
+
+TEST_F(async_directory_test, smoke_store) {
+  smoke_store();
+}
+
+TEST_F(async_directory_test, list) {
+  list();
+}
+
+TEST_F(async_directory_test, visit) {
+  visit();
+}
+
+TEST_F(async_directory_test, index_io) {
+  smoke_index_io();
+}
+
+TEST_F(async_directory_test, lock_obtain_release) {
+  lock_obtain_release();
+}
+
+TEST_F(async_directory_test, prefetch) {
+  const size_t size = 1024 * 1024 + 17;
+  write_pattern("prefetched", size);
+
+  auto in = dir_->open("prefetched", irs::IOAdvice::RANDOM);
+  ASSERT_NE(nullptr, in);
+  ASSERT_EQ(size, in->length());
+
+  // reads of prefetched ranges, including partially prefetched and
+  // overlapping ones, as well as ranges past the end of file
+  in->prefetch(0, 4096);
+  in->prefetch(2048, 4096);
+  in->prefetch(size - 100, 1000);
+  in->prefetch(size, 42);
+  in->prefetch(300000, size); // longer than a single fetched range
+  assert_pattern(*in, 0, 8192);
+  assert_pattern(*in, size - 100, 100);
+  assert_pattern(*in, 299000, 300000);
+  ASSERT_EQ(599000, in->file_pointer());
+
+  // more requests than fetched ranges kept per file
+  for (size_t i = 0; i < 32; ++i) {
+    in->prefetch(i * 30000, 5000);
+  }
+
+  for (size_t i = 32; i; --i) {
+    assert_pattern(*in, (i - 1) * 30000 + 1000, 5000);
+  }
+
+  // copies share fetched ranges
+  auto dup = in->dup();
+  ASSERT_NE(nullptr, dup);
+  dup->prefetch(500000, 100000);
+  auto reopened = in->reopen();
+  ASSERT_NE(nullptr, reopened);
+  assert_pattern(*reopened, 500000, 100000);
+  assert_pattern(*dup, 500000, 100000);
+
+  // concurrent prefetches and reads of the same file
+  std::vector<std::thread> threads;
+  std::atomic<size_t> failed(0);
+
+  for (size_t t = 0; t < 8; ++t) {
+    threads.emplace_back([&in, &failed, size, t]() {
+      auto thread_in = in->reopen();
+
+      if (!thread_in) {
+        ++failed;
+        return;
+      }
+
+      std::vector<irs::byte_type> buf(1000);
+
+      for (size_t i = 0; i < 200; ++i) {
+        const size_t offset = ((i * 7919 + t * 104729) * 97) % (size - buf.size());
+        thread_in->prefetch(offset, buf.size());
+        thread_in->seek(offset);
+
+        if (buf.size() != thread_in->read_bytes(buf.data(), buf.size())) {
+          ++failed;
+          continue;
+        }
+
+        for (size_t j = 0; j < buf.size(); ++j) {
+          if (irs::byte_type((offset + j) % 251) != buf[j]) {
+            ++failed;
+            break;
+          }
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(0, failed);
+
+  // inputs outliving the directory are still readable
+  in->prefetch(0, 1000);
+  dir_.reset();
+  in->prefetch(1000, 1000);
+  assert_pattern(*in, 0, 2000);
+}
+
+TEST_F(async_directory_test, prefetch_without_threads) {
+  write_pattern("prefetched", 10000);
+  dir_.reset(); // close the default directory before replacing it
+
+  irs::async_directory dir(dir_path(), 0);
+  auto in = dir.open("prefetched", irs::IOAdvice::NORMAL);
+  ASSERT_NE(nullptr, in);
+
+  in->prefetch(0, 10000); // no-op
+  assert_pattern(*in, 0, 10000);
+}
+
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -28,6 +28,7 @@
 #include "store/data_input.hpp"
 #include "store/checksum_io.hpp"
 #include "utils/async_utils.hpp"
+#include "utils/crc.hpp"
 #include "utils/utf8_path.hpp"
 
 #include <boost/crc.hpp>
@@ -782,6 +783,16 @@ void directory_test_case::smoke_index_io() {
     EXPECT_EQ(27, in->read_byte());
     EXPECT_FALSE(in->eof());
 
+    // prefetch doesn't affect position
+    {
+      const auto pos = in->file_pointer();
+      in->prefetch(0, in->length());
+      in->prefetch(pos, 1);
+      in->prefetch(in->length(), 42); // out of range
+      EXPECT_EQ(pos, in->file_pointer());
+      EXPECT_FALSE(in->eof());
+    }
+
     // check short
     EXPECT_EQ(std::numeric_limits< int16_t >::min(), in->read_short());
     EXPECT_FALSE(in->eof());
@@ -880,7 +891,7 @@ void directory_test_case::smoke_store() {
   auto it = names.end();
   for (const auto& name : names) {
     --it;
-    boost::crc_32_type crc;
+    irs::crc32c crc;
 
     auto file = dir_->create(name);
     ASSERT_FALSE(!file);
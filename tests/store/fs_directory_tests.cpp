@@ -129,6 +129,27 @@ TEST_F(fs_directory_test, smoke_store) {
   smoke_store();
 }
 
+TEST_F(fs_directory_test, sync_batch) {
+  std::vector<std::string> names;
+
+  for (size_t i = 0; i < 20; ++i) {
+    names.emplace_back("file" + std::to_string(i));
+
+    auto out = dir_->create(names.back());
+    ASSERT_FALSE(!out);
+    out->write_vlong(i);
+  }
+
+  std::vector<irs::string_ref> refs(names.begin(), names.end());
+  ASSERT_TRUE(dir_->sync_batch(refs));
+  ASSERT_TRUE(dir_->sync_batch(std::vector<irs::string_ref>()));
+  ASSERT_TRUE(dir_->sync_batch(std::vector<irs::string_ref>(1, refs.front())));
+
+  // a missing file fails the whole batch
+  refs.emplace(refs.begin() + 10, "missing");
+  ASSERT_FALSE(dir_->sync_batch(refs));
+}
+
 TEST_F(fs_directory_test, list) {
   list();
 }
@@ -721,3 +721,87 @@ TEST(store_utils_tests, avg_encode_block_read_write) {
   }
 }
 
+
+template<typename T>
+void pfor_read_write_block_core(const std::vector<T>& source) {
+  const size_t BLOCK_SIZE = 128;
+  ASSERT_EQ(0, source.size() % BLOCK_SIZE);
+  T encoded[BLOCK_SIZE];
+
+  irs::bytes_output out;
+  for (auto begin = source.data(), end = begin + source.size(); begin != end; begin += BLOCK_SIZE) {
+    irs::encode::pfor::write_block(out, begin, BLOCK_SIZE, encoded);
+  }
+  out.write_vint(42); // marker
+
+  // read blocks
+  {
+    irs::bytes_ref_input in(out);
+    std::vector<T> read(source.size());
+    for (auto begin = read.data(), end = begin + read.size(); begin != end; begin += BLOCK_SIZE) {
+      irs::encode::pfor::read_block(in, BLOCK_SIZE, encoded, begin);
+    }
+    ASSERT_EQ(source, read);
+    ASSERT_EQ(42, in.read_vint());
+  }
+
+  // skip blocks
+  {
+    irs::bytes_ref_input in(out);
+    for (size_t i = 0, count = source.size() / BLOCK_SIZE; i < count; ++i) {
+      if (sizeof(T) == sizeof(uint32_t)) {
+        irs::encode::pfor::skip_block32(in, BLOCK_SIZE);
+      } else {
+        irs::encode::pfor::skip_block64(in, BLOCK_SIZE);
+      }
+    }
+    ASSERT_EQ(42, in.read_vint());
+  }
+}
+
+TEST(store_utils_tests, pfor_read_write_block) {
+  std::vector<uint32_t> values32;
+  std::vector<uint64_t> values64;
+
+  // all equal
+  values32.assign(128, 7);
+  pfor_read_write_block_core(values32);
+  values64.assign(128, 7);
+  pfor_read_write_block_core(values64);
+
+  // small values with rare outliers
+  values32.clear();
+  values64.clear();
+  for (uint32_t i = 0; i < 1024; ++i) {
+    values32.push_back(i % 61 ? i % 5 : (std::numeric_limits<uint32_t>::max)() - i);
+    values64.push_back(i % 61 ? i % 5 : (std::numeric_limits<uint64_t>::max)() - i);
+  }
+  pfor_read_write_block_core(values32);
+  pfor_read_write_block_core(values64);
+
+  // zeros with outliers
+  values32.assign(128, 0);
+  values32[0] = 1;
+  values32[127] = 1 << 20;
+  pfor_read_write_block_core(values32);
+
+  // uniformly wide values
+  values64.clear();
+  for (uint64_t i = 0; i < 256; ++i) {
+    values64.push_back((std::numeric_limits<uint64_t>::max)() - i * 1000);
+  }
+  pfor_read_write_block_core(values64);
+
+  // outliers must not inflate the whole block
+  {
+    values32.assign(128, 3);
+    values32[64] = 1 << 30;
+    uint32_t encoded[128];
+
+    irs::bytes_output bitpack_out;
+    irs::encode::bitpack::write_block(bitpack_out, values32.data(), 128, encoded);
+    irs::bytes_output pfor_out;
+    ASSERT_EQ(2, irs::encode::pfor::write_block(pfor_out, values32.data(), 128, encoded));
+    ASSERT_LT(pfor_out.size() * 4, bitpack_out.size());
+  }
+}
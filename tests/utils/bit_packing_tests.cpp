@@ -24,9 +24,11 @@
 #include "tests_shared.hpp"
 
 #include "utils/bit_packing.hpp"
+#include "utils/cpuinfo.hpp"
 
 #include <vector>
 #include <algorithm>
+#include <random>
   
 using namespace iresearch;
 
@@ -180,6 +182,45 @@ TEST(bit_packing_tests, pack_unpack_32) {
   }
 }
 
+TEST(bit_packing_tests, unpack_32_simd) {
+  typedef void(*unpack_f)(uint32_t*, uint32_t*, const uint32_t*, const uint32_t);
+
+  std::vector<std::pair<const char*, unpack_f>> impls;
+  impls.emplace_back("scalar", &packed::unpack_scalar);
+  if (cpuinfo::support_sse4_1()) {
+    impls.emplace_back("sse4_1", &packed::unpack_sse4_1);
+  }
+  if (cpuinfo::support_avx2()) {
+    impls.emplace_back("avx2", &packed::unpack_avx2);
+  }
+
+  std::mt19937 engine;
+  std::vector<uint32_t> src(4*packed::BLOCK_SIZE_32); // postings block size
+
+  for (uint32_t bits = 1; bits <= 32; ++bits) {
+    const auto max = packed::max_value<uint32_t>(bits);
+    std::uniform_int_distribution<uint32_t> dist(0, max);
+    std::generate(src.begin(), src.end(), [&dist, &engine]() { return dist(engine); });
+    src.front() = max; // ensure all bits are used
+
+    // exactly sized, the last value of a block must not be read past the end
+    std::vector<uint32_t> compressed(packed::blocks_required_32(uint32_t(src.size()), bits), 0);
+    packed::pack(src.data(), src.data() + src.size(), compressed.data(), bits);
+
+    for (auto& impl : impls) {
+      SCOPED_TRACE(impl.first);
+      std::vector<uint32_t> unpacked(src.size(), 0);
+      impl.second(unpacked.data(), unpacked.data() + unpacked.size(), compressed.data(), bits);
+      ASSERT_EQ(src, unpacked);
+    }
+
+    // dispatching implementation
+    std::vector<uint32_t> unpacked(src.size(), 0);
+    packed::unpack(unpacked.data(), unpacked.data() + unpacked.size(), compressed.data(), bits);
+    ASSERT_EQ(src, unpacked);
+  }
+}
+
 TEST(bit_packing_tests, pack_unpack_64) {
   std::vector<uint64_t> src{
     14410, 21766, 15994, 29493, 20819, 14410123456789, 21766234567890, 159943456789012, 294934567890123, 208195678901234,
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+#include "utils/crc.hpp"
+#include "utils/string.hpp"
+
+#include <random>
+
+TEST(crc_tests, crc32c_known_values) {
+  // test vectors from RFC 3720, B.4
+  irs::byte_type data[32];
+
+  std::fill(std::begin(data), std::end(data), irs::byte_type(0));
+  ASSERT_EQ(0x8A9136AA, irs::crc32c::update(0, data, sizeof data));
+
+  std::fill(std::begin(data), std::end(data), irs::byte_type(0xFF));
+  ASSERT_EQ(0x62A8AB43, irs::crc32c::update(0, data, sizeof data));
+
+  for (size_t i = 0; i < sizeof data; ++i) {
+    data[i] = irs::byte_type(i);
+  }
+  ASSERT_EQ(0x46DD794E, irs::crc32c::update(0, data, sizeof data));
+
+  for (size_t i = 0; i < sizeof data; ++i) {
+    data[i] = irs::byte_type(31 - i);
+  }
+  ASSERT_EQ(0x113FDB5C, irs::crc32c::update(0, data, sizeof data));
+
+  // check value
+  const irs::string_ref check = "123456789";
+  irs::crc32c crc;
+  ASSERT_EQ(0, crc.checksum());
+  crc.process_bytes(check.c_str(), check.size());
+  ASSERT_EQ(0xE3069283, crc.checksum());
+
+  crc.reset();
+  ASSERT_EQ(0, crc.checksum());
+}
+
+TEST(crc_tests, crc32c_incremental) {
+  std::mt19937 engine(42);
+  std::vector<irs::byte_type> data(4099);
+
+  for (auto& b: data) {
+    b = irs::byte_type(engine());
+  }
+
+  irs::crc32c expected;
+  for (auto b: data) {
+    expected.process_byte(b);
+  }
+
+  // any split of the input and any alignment gives the same checksum
+  for (size_t step: { 1, 3, 7, 8, 9, 64, 1000 }) {
+    for (size_t offset = 0; offset < 8; ++offset) {
+      irs::crc32c crc;
+      size_t i = 0;
+
+      crc.process_bytes(data.data(), offset);
+
+      for (i = offset; i + step <= data.size(); i += step) {
+        crc.process_bytes(data.data() + i, step);
+      }
+
+      crc.process_bytes(data.data() + i, data.size() - i);
+
+      ASSERT_EQ(expected.checksum(), crc.checksum());
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tests_shared.hpp"
+
+#include "utils/index_utils.hpp"
+
+#include <vector>
+
+using namespace iresearch;
+
+namespace {
+
+index_utils::segment_stat segment(uint64_t bytes, uint64_t docs, uint64_t live_docs) {
+  return index_utils::segment_stat{ bytes, docs, live_docs };
+}
+
+}
+
+TEST(index_utils_tests, tier_candidates_empty) {
+  index_utils::consolidate_tier_options options;
+  options.min_segments = 4;
+
+  ASSERT_TRUE(index_utils::tier_candidates({}, options).empty());
+
+  // not enough segments
+  {
+    std::vector<index_utils::segment_stat> segments(3, segment(1 << 20, 10, 10));
+    ASSERT_TRUE(index_utils::tier_candidates(segments, options).empty());
+  }
+
+  // number of segments is within the budget
+  {
+    std::vector<index_utils::segment_stat> segments(5, segment(1 << 20, 10, 10));
+    ASSERT_TRUE(index_utils::tier_candidates(segments, options).empty());
+  }
+}
+
+TEST(index_utils_tests, tier_candidates_similar_size) {
+  index_utils::consolidate_tier_options options;
+  options.min_segments = 4;
+  options.max_segments = 4;
+
+  // large segment isn't merged with small ones
+  std::vector<index_utils::segment_stat> segments(20, segment(1 << 20, 10, 10));
+  segments.insert(segments.begin() + 2, segment(1 << 30, 10000, 10000));
+
+  ASSERT_EQ(std::vector<size_t>({ 0, 1, 3, 4 }), index_utils::tier_candidates(segments, options));
+}
+
+TEST(index_utils_tests, tier_candidates_max_segments) {
+  index_utils::consolidate_tier_options options;
+  options.min_segments = 2;
+  options.max_segments = 10;
+
+  std::vector<index_utils::segment_stat> segments(12, segment(1 << 20, 10, 10));
+  ASSERT_EQ(10, index_utils::tier_candidates(segments, options).size());
+}
+
+TEST(index_utils_tests, tier_candidates_max_segments_bytes) {
+  index_utils::consolidate_tier_options options;
+  options.min_segments = 2;
+  options.max_segments_bytes = 100;
+  options.floor_segment_bytes = 1;
+
+  // segments which make up more than a half of the max segment are left
+  // alone, merged segment doesn't exceed max size
+  {
+    std::vector<index_utils::segment_stat> segments(30, segment(40, 10, 10));
+    segments.insert(segments.begin(), segment(60, 10, 10));
+    ASSERT_EQ(std::vector<size_t>({ 1, 2 }), index_utils::tier_candidates(segments, options));
+  }
+
+  // unless removed documents made them smaller
+  {
+    std::vector<index_utils::segment_stat> segments(30, segment(40, 10, 10));
+    segments.insert(segments.begin(), segment(60, 10, 5));
+    ASSERT_EQ(std::vector<size_t>({ 0, 1 }), index_utils::tier_candidates(segments, options));
+  }
+}
+
+TEST(index_utils_tests, tier_candidates_removed_docs) {
+  index_utils::consolidate_tier_options options;
+  options.min_segments = 4;
+  options.max_segments = 4;
+
+  // segments with removed documents are preferred
+  std::vector<index_utils::segment_stat> segments{
+    segment(10 << 20, 100, 100),
+    segment(10 << 20, 100, 100),
+    segment(10 << 20, 100, 100),
+    segment(10 << 20, 100, 100),
+    segment(20 << 20, 100, 50),
+    segment(20 << 20, 100, 50),
+    segment(20 << 20, 100, 50),
+    segment(20 << 20, 100, 50)
+  };
+  ASSERT_EQ(std::vector<size_t>({ 4, 5, 6, 7 }), index_utils::tier_candidates(segments, options));
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(_MSC_VER)
+  #pragma warning(disable: 4101)
+  #pragma warning(disable: 4267)
+#endif
+
+  #include <cmdline.h>
+
+#if defined(_MSC_VER)
+  #pragma warning(default: 4267)
+  #pragma warning(default: 4101)
+#endif
+
+#include "bit-packing.hpp"
+#include "utils/bit_packing.hpp"
+#include "utils/cpuinfo.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+NS_LOCAL
+
+const std::string HELP = "help";
+const std::string BITS = "bits";
+const std::string BLOCKS = "blocks";
+const std::string RPT = "repeat";
+
+// number of values in a postings block of 'formats_10'
+const uint32_t VALUES_PER_BLOCK = 4*irs::packed::BLOCK_SIZE_32;
+
+typedef void(*unpack_f)(uint32_t*, uint32_t*, const uint32_t*, const uint32_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @return average time spent to unpack a single value, in nanoseconds
+////////////////////////////////////////////////////////////////////////////////
+double measure(
+    unpack_f unpack,
+    const std::vector<uint32_t>& packed,
+    std::vector<uint32_t>& unpacked,
+    uint32_t bits,
+    size_t repeat) {
+  const auto packed_block_size = irs::packed::blocks_required_32(VALUES_PER_BLOCK, bits);
+  const auto blocks = unpacked.size() / VALUES_PER_BLOCK;
+  const auto start = std::chrono::high_resolution_clock::now();
+
+  for (size_t i = 0; i < repeat; ++i) {
+    const uint32_t* in = packed.data();
+    uint32_t* out = unpacked.data();
+
+    for (size_t j = 0; j < blocks; ++j, in += packed_block_size, out += VALUES_PER_BLOCK) {
+      unpack(out, out + VALUES_PER_BLOCK, in, bits);
+    }
+  }
+
+  const std::chrono::duration<double, std::nano> elapsed =
+    std::chrono::high_resolution_clock::now() - start;
+
+  return elapsed.count() / (double(repeat) * unpacked.size());
+}
+
+int bit_packing(uint32_t min_bits, uint32_t max_bits, size_t blocks, size_t repeat) {
+  std::vector<std::pair<std::string, unpack_f>> impls;
+  impls.emplace_back("scalar", &irs::packed::unpack_scalar);
+
+  if (irs::cpuinfo::support_sse4_1()) {
+    impls.emplace_back("sse4.1", &irs::packed::unpack_sse4_1);
+  }
+
+  if (irs::cpuinfo::support_avx2()) {
+    impls.emplace_back("avx2", &irs::packed::unpack_avx2);
+  }
+
+  std::cout << "Configuration: " << std::endl;
+  std::cout << BLOCKS << "=" << blocks << std::endl;
+  std::cout << RPT << "=" << repeat << std::endl;
+
+  std::cout << std::setw(4) << "bits";
+  for (auto& impl : impls) {
+    std::cout << std::setw(12) << impl.first << " ns/val";
+  }
+  std::cout << std::setw(12) << "speedup" << std::endl;
+
+  std::mt19937 engine;
+  std::vector<uint32_t> values(blocks * VALUES_PER_BLOCK);
+  std::vector<uint32_t> expected(values.size());
+  std::vector<uint32_t> unpacked(values.size());
+
+  for (auto bits = min_bits; bits <= max_bits; ++bits) {
+    std::uniform_int_distribution<uint32_t> dist(0, irs::packed::max_value<uint32_t>(bits));
+    std::generate(values.begin(), values.end(), [&dist, &engine]() { return dist(engine); });
+
+    const auto packed_block_size = irs::packed::blocks_required_32(VALUES_PER_BLOCK, bits);
+    std::vector<uint32_t> packed(blocks * packed_block_size, 0);
+
+    for (size_t i = 0; i < blocks; ++i) {
+      irs::packed::pack(
+        values.data() + i*VALUES_PER_BLOCK,
+        values.data() + (i+1)*VALUES_PER_BLOCK,
+        packed.data() + i*packed_block_size,
+        bits
+      );
+    }
+
+    std::cout << std::setw(4) << bits;
+
+    double scalar = 0, best = 0;
+    for (auto& impl : impls) {
+      const auto avg = measure(impl.second, packed, unpacked, bits, repeat);
+
+      if (values != unpacked) {
+        std::cerr << "Implementation '" << impl.first
+                  << "' produced invalid output for bits=" << bits << std::endl;
+        return 1;
+      }
+
+      scalar = scalar ? scalar : avg;
+      best = best ? (std::min)(best, avg) : avg;
+
+      std::cout << std::setw(19) << std::fixed << std::setprecision(3) << avg;
+    }
+
+    std::cout << std::setw(11) << std::setprecision(2) << scalar / best << "x" << std::endl;
+  }
+
+  return 0;
+}
+
+NS_END
+
+int bit_packing(int argc, char* argv[]) {
+  // mode bitpack
+  cmdline::parser cmdbitpack;
+  cmdbitpack.add(HELP, '?', "Produce help message");
+  cmdbitpack.add<uint32_t>(BITS, 0, "Bits per value, 0 - all of [1..32]", false, 0);
+  cmdbitpack.add<size_t>(BLOCKS, 0, "Number of postings blocks to unpack", false, size_t(1024));
+  cmdbitpack.add<size_t>(RPT, 0, "Repeat count", false, size_t(1000));
+
+  cmdbitpack.parse(argc, argv);
+
+  if (cmdbitpack.exist(HELP)) {
+    std::cout << cmdbitpack.usage() << std::endl;
+    return 0;
+  }
+
+  const auto bits = cmdbitpack.get<uint32_t>(BITS);
+
+  if (bits > 32) {
+    std::cerr << "Invalid number of bits: " << bits << std::endl;
+    return 1;
+  }
+
+  const auto blocks = (std::max)(size_t(1), cmdbitpack.get<size_t>(BLOCKS));
+  const auto repeat = (std::max)(size_t(1), cmdbitpack.get<size_t>(RPT));
+
+  return bits
+    ? bit_packing(bits, bits, blocks, repeat)
+    : bit_packing(1, 32, blocks, repeat);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
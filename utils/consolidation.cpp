@@ -0,0 +1,265 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2017 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Andrey Abramov
+/// @author Vasiliy Nabatchikov
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(_MSC_VER)
+  #pragma warning(disable: 4101)
+  #pragma warning(disable: 4267)
+#endif
+
+  #include <cmdline.h>
+
+#if defined(_MSC_VER)
+  #pragma warning(default: 4267)
+  #pragma warning(default: 4101)
+#endif
+
+#include "consolidation.hpp"
+#include "utils/index_utils.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+NS_LOCAL
+
+const std::string HELP = "help";
+const std::string TRACE = "trace";
+const std::string COMMITS = "commits";
+const std::string DOCS = "docs";
+const std::string REMOVES = "removes";
+const std::string DOC_BYTES = "doc-bytes";
+const std::string MIN_SEGMENTS = "min-segments";
+const std::string MAX_SEGMENTS = "max-segments";
+const std::string MAX_SEGMENTS_BYTES = "max-segments-bytes";
+const std::string FLOOR_SEGMENT_BYTES = "floor-segment-bytes";
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a single commit of the ingest trace
+////////////////////////////////////////////////////////////////////////////////
+struct commit_t {
+  uint64_t inserted; // number of documents inserted
+  uint64_t removed; // number of documents removed
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads an ingest trace, a commit per line: <inserted> <removed>
+////////////////////////////////////////////////////////////////////////////////
+bool read_trace(std::vector<commit_t>& trace, const std::string& path) {
+  std::ifstream in(path);
+
+  if (!in) {
+    return false;
+  }
+
+  commit_t commit;
+
+  while (in >> commit.inserted >> commit.removed) {
+    trace.push_back(commit);
+  }
+
+  return in.eof();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removes a number of live documents uniformly distributed over the
+///        segments
+////////////////////////////////////////////////////////////////////////////////
+void remove(
+    std::vector<irs::index_utils::segment_stat>& segments,
+    uint64_t removed,
+    std::mt19937_64& engine) {
+  uint64_t live_docs = 0;
+
+  for (auto& segment : segments) {
+    live_docs += segment.live_docs_count;
+  }
+
+  for (removed = std::min(removed, live_docs); removed; --removed, --live_docs) {
+    auto doc = std::uniform_int_distribution<uint64_t>(0, live_docs - 1)(engine);
+    auto it = segments.begin();
+
+    for (; doc >= it->live_docs_count; ++it) {
+      doc -= it->live_docs_count;
+    }
+
+    --it->live_docs_count;
+  }
+
+  // fully removed segments are dropped by the writer
+  segments.erase(
+    std::remove_if(
+      segments.begin(), segments.end(),
+      [](const irs::index_utils::segment_stat& segment) {
+        return !segment.live_docs_count;
+    }),
+    segments.end()
+  );
+}
+
+int consolidation(
+    const std::vector<commit_t>& trace,
+    uint64_t doc_bytes,
+    const irs::index_utils::consolidate_tier_options& options) {
+  std::cout << "Configuration: " << std::endl;
+  std::cout << COMMITS << "=" << trace.size() << std::endl;
+  std::cout << DOC_BYTES << "=" << doc_bytes << std::endl;
+  std::cout << MIN_SEGMENTS << "=" << options.min_segments << std::endl;
+  std::cout << MAX_SEGMENTS << "=" << options.max_segments << std::endl;
+  std::cout << MAX_SEGMENTS_BYTES << "=" << options.max_segments_bytes << std::endl;
+  std::cout << FLOOR_SEGMENT_BYTES << "=" << options.floor_segment_bytes << std::endl;
+
+  std::mt19937_64 engine;
+  std::vector<irs::index_utils::segment_stat> segments;
+  uint64_t flushed_bytes = 0; // bytes written by flushes
+  uint64_t merged_bytes = 0; // bytes written by merges
+  uint64_t merges = 0;
+  uint64_t segments_sum = 0;
+  size_t segments_max = 0;
+
+  for (auto& commit : trace) {
+    remove(segments, commit.removed, engine);
+
+    if (commit.inserted) {
+      segments.push_back(irs::index_utils::segment_stat{
+        commit.inserted * doc_bytes, commit.inserted, commit.inserted
+      });
+      flushed_bytes += commit.inserted * doc_bytes;
+    }
+
+    // consolidate until the policy has nothing to merge
+    for (;;) {
+      auto candidates = irs::index_utils::tier_candidates(segments, options);
+
+      if (candidates.empty()) {
+        break;
+      }
+
+      irs::index_utils::segment_stat merged{ 0, 0, 0 };
+
+      for (auto pos : candidates) {
+        auto& segment = segments[pos];
+
+        merged.bytes += segment.bytes * segment.live_docs_count / segment.docs_count;
+        merged.docs_count += segment.live_docs_count;
+      }
+
+      merged.live_docs_count = merged.docs_count;
+
+      // candidates are sorted, remove them back to front
+      for (auto it = candidates.rbegin(), end = candidates.rend(); it != end; ++it) {
+        segments.erase(segments.begin() + *it);
+      }
+
+      segments.push_back(merged);
+      merged_bytes += merged.bytes;
+      ++merges;
+    }
+
+    segments_sum += segments.size();
+    segments_max = std::max(segments_max, segments.size());
+  }
+
+  uint64_t live_docs = 0, docs = 0;
+
+  for (auto& segment : segments) {
+    live_docs += segment.live_docs_count;
+    docs += segment.docs_count;
+  }
+
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "Results: " << std::endl;
+  std::cout << "merges=" << merges << std::endl;
+  std::cout << "segments=" << segments.size() << std::endl;
+  std::cout << "segments_avg=" << (trace.empty() ? 0. : double(segments_sum) / trace.size()) << std::endl;
+  std::cout << "segments_max=" << segments_max << std::endl;
+  std::cout << "live_docs=" << live_docs << " of " << docs << std::endl;
+  std::cout << "bytes_flushed=" << flushed_bytes << std::endl;
+  std::cout << "bytes_merged=" << merged_bytes << std::endl;
+  std::cout << "write_amplification="
+            << (flushed_bytes ? double(flushed_bytes + merged_bytes) / flushed_bytes : 0.)
+            << std::endl;
+
+  return 0;
+}
+
+NS_END
+
+int consolidation(int argc, char* argv[]) {
+  const irs::index_utils::consolidate_tier_options defaults;
+
+  // mode consolidate
+  cmdline::parser cmdconsolidate;
+  cmdconsolidate.add(HELP, '?', "Produce help message");
+  cmdconsolidate.add<std::string>(TRACE, 0, "Ingest trace, a commit per line: <inserted docs> <removed docs>", false);
+  cmdconsolidate.add<size_t>(COMMITS, 0, "Number of commits of the generated trace", false, size_t(10000));
+  cmdconsolidate.add<size_t>(DOCS, 0, "Documents inserted per commit of the generated trace", false, size_t(1000));
+  cmdconsolidate.add<double>(REMOVES, 0, "Documents removed per inserted one in the generated trace", false, 0.);
+  cmdconsolidate.add<size_t>(DOC_BYTES, 0, "Average size of a document in a segment", false, size_t(1024));
+  cmdconsolidate.add<size_t>(MIN_SEGMENTS, 0, "Minimum number of segments to merge", false, defaults.min_segments);
+  cmdconsolidate.add<size_t>(MAX_SEGMENTS, 0, "Maximum number of segments to merge", false, defaults.max_segments);
+  cmdconsolidate.add<size_t>(MAX_SEGMENTS_BYTES, 0, "Maximum size of a merged segment", false, size_t(defaults.max_segments_bytes));
+  cmdconsolidate.add<size_t>(FLOOR_SEGMENT_BYTES, 0, "Segments below the size are treated as equal", false, size_t(defaults.floor_segment_bytes));
+
+  cmdconsolidate.parse(argc, argv);
+
+  if (cmdconsolidate.exist(HELP)) {
+    std::cout << cmdconsolidate.usage() << std::endl;
+    return 0;
+  }
+
+  std::vector<commit_t> trace;
+
+  if (cmdconsolidate.exist(TRACE)) {
+    const auto path = cmdconsolidate.get<std::string>(TRACE);
+
+    if (!read_trace(trace, path)) {
+      std::cerr << "Failed to read trace from: " << path << std::endl;
+      return 1;
+    }
+  } else {
+    const auto commits = cmdconsolidate.get<size_t>(COMMITS);
+    const auto docs = cmdconsolidate.get<size_t>(DOCS);
+    const auto removes = std::max(0., cmdconsolidate.get<double>(REMOVES));
+
+    for (size_t i = 0; i < commits; ++i) {
+      trace.push_back(commit_t{ docs, uint64_t(docs * removes) });
+    }
+  }
+
+  irs::index_utils::consolidate_tier_options options;
+  options.min_segments = cmdconsolidate.get<size_t>(MIN_SEGMENTS);
+  options.max_segments = cmdconsolidate.get<size_t>(MAX_SEGMENTS);
+  options.max_segments_bytes = cmdconsolidate.get<size_t>(MAX_SEGMENTS_BYTES);
+  options.floor_segment_bytes = cmdconsolidate.get<size_t>(FLOOR_SEGMENT_BYTES);
+
+  return consolidation(
+    trace, std::max(size_t(1), cmdconsolidate.get<size_t>(DOC_BYTES)), options
+  );
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
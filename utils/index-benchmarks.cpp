@@ -24,6 +24,8 @@
 
 #include "index-put.hpp"
 #include "index-search.hpp"
+#include "bit-packing.hpp"
+#include "consolidation.hpp"
 
 #include <unordered_map>
 #include <functional>
@@ -35,9 +37,13 @@ typedef std::unordered_map<
 
 const std::string MODE_PUT = "put";
 const std::string MODE_SEARCH = "search";
+const std::string MODE_BIT_PACKING = "bitpack";
+const std::string MODE_CONSOLIDATION = "consolidate";
 
 bool init_handlers(handlers_t& handlers) {
   handlers.emplace(MODE_PUT, &put);
   handlers.emplace(MODE_SEARCH, &search);
+  handlers.emplace(MODE_BIT_PACKING, &bit_packing);
+  handlers.emplace(MODE_CONSOLIDATION, &consolidation);
   return true;
 }
@@ -82,6 +82,7 @@ const std::string MAX = "max-lines";
 const std::string THR = "threads";
 const std::string CPR = "commit-period";
 const std::string DIR_TYPE = "dir-type";
+const std::string FORMAT = "format";
 
 typedef std::unique_ptr<std::string> ustringp;
 
@@ -349,6 +350,7 @@ struct WikiDoc : Doc {
 int put(
     const std::string& path,
     const std::string& dir_type,
+    const std::string& format,
     std::istream& stream,
     size_t lines_max,
     size_t indexer_threads,
@@ -363,7 +365,14 @@ int put(
     return 1;
   }
 
-  auto writer = irs::index_writer::make(*dir, irs::formats::get("1_0"), irs::OPEN_MODE::OM_CREATE);
+  auto codec = irs::formats::get(format);
+
+  if (!codec) {
+    std::cerr << "Unable to find format of type '" << format << "'" << std::endl;
+    return 1;
+  }
+
+  auto writer = irs::index_writer::make(*dir, codec, irs::OPEN_MODE::OM_CREATE);
 
   indexer_threads = (std::max)(size_t(1), (std::min)(indexer_threads, (std::numeric_limits<size_t>::max)() - 1 - 1)); // -1 for commiter thread -1 for stream reader thread
 
@@ -373,6 +382,7 @@ int put(
   std::cout << "Configuration: " << std::endl;
   std::cout << INDEX_DIR << "=" << path << std::endl;
   std::cout << DIR_TYPE << "=" << dir_type << std::endl;
+  std::cout << FORMAT << "=" << format << std::endl;
   std::cout << MAX << "=" << lines_max << std::endl;
   std::cout << THR << "=" << indexer_threads << std::endl;
   std::cout << CPR << "=" << commit_interval_ms << std::endl;
@@ -463,9 +473,10 @@ int put(
 
       while (batch_provider.swap(buf)) {
         SCOPED_TIMER(std::string("Index batch ") + std::to_string(buf.size()));
-        size_t i = 0;
-        auto inserter = [&buf, &i, &doc](const irs::index_writer::document& builder) {
-          doc.fill(&(buf[i]));
+        auto inserter = [&doc](
+            const irs::index_writer::document& builder,
+            std::string& line) {
+          doc.fill(&line);
 
           for (auto& field: doc.elements) {
             builder.insert(irs::action::index, *field);
@@ -475,10 +486,10 @@ int put(
             builder.insert(irs::action::store, *field);
           }
 
-          return ++i < buf.size();
+          return true;
         };
 
-        writer->insert(inserter);
+        writer->insert(buf.begin(), buf.end(), inserter);
         std::cout << "." << std::flush; // newline in commit thread
       }
     });
@@ -532,6 +543,7 @@ int put(const cmdline::parser& args) {
   auto indexer_threads = args.exist(THR) ? args.get<size_t>(THR) : size_t(0);
   auto lines_max = args.exist(MAX) ? args.get<size_t>(MAX) : size_t(0);
   auto dir_type = args.exist(DIR_TYPE) ? args.get<std::string>(DIR_TYPE) : std::string("fs");
+  auto format = args.exist(FORMAT) ? args.get<std::string>(FORMAT) : std::string("1_0");
 
   if (args.exist(INPUT)) {
     const auto& file = args.get<std::string>(INPUT);
@@ -541,10 +553,10 @@ int put(const cmdline::parser& args) {
       return 1;
     }
 
-    return put(path, dir_type, in, lines_max, indexer_threads, commit_interval_ms, batch_size, consolidate);
+    return put(path, dir_type, format, in, lines_max, indexer_threads, commit_interval_ms, batch_size, consolidate);
   }
 
-  return put(path, dir_type, std::cin, lines_max, indexer_threads, commit_interval_ms, batch_size, consolidate);
+  return put(path, dir_type, format, std::cin, lines_max, indexer_threads, commit_interval_ms, batch_size, consolidate);
 }
 
 int put(int argc, char* argv[]) {
@@ -553,6 +565,7 @@ int put(int argc, char* argv[]) {
   cmdput.add(HELP, '?', "Produce help message");
   cmdput.add(INDEX_DIR, 0, "Path to index directory", true, std::string());
   cmdput.add(DIR_TYPE, 0, "Directory type (fs|mmap)", false, std::string("fs"));
+  cmdput.add(FORMAT, 0, "Index format (1_0|1_0_pfor)", false, std::string("1_0"));
   cmdput.add(INPUT, 0, "Input file", true, std::string());
   cmdput.add(BATCH_SIZE, 0, "Lines per batch", false, size_t(0));
   cmdput.add(CONSOLIDATE, 0, "Consolidate segments", false, false);
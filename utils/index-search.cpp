@@ -65,8 +65,8 @@
 #include "search/phrase_filter.hpp"
 #include "search/bm25.hpp"
 #include "search/score.hpp"
+#include "search/top_k.hpp"
 #include "utils/async_utils.hpp"
-#include "utils/memory_pool.hpp"
 
 #include <boost/chrono.hpp>
 #include <random>
@@ -192,39 +192,19 @@ struct SearchTask : public Task {
     virtual int query(irs::directory_reader& reader) override {
         SCOPED_TIMER("Query execution + Result processing time");
 
-        for (auto& segment : reader) { // iterate segments
-            irs::order order;
-            order.add<irs::bm25_sort>(true, irs::string_ref::nil);
-            auto prepared_order = order.prepare();
-            auto docs = prepared->execute(segment, prepared_order); // query segment
-            const irs::score* score = docs->attributes().get<iresearch::score>().get();
-            auto comparer = [&prepared_order](const irs::bstring& lhs, const irs::bstring& rhs)->bool {
-              return prepared_order.less(lhs.c_str(), rhs.c_str());
-            };
-            std::multimap<irs::bstring, Entry, decltype(comparer)> sorted(comparer);
+        irs::order order;
+        order.add<irs::bm25_sort>(true, irs::string_ref::nil);
+        auto prepared_order = order.prepare();
+        irs::top_k_collector top_k(prepared_order, topN);
 
-            // ensure we avoid COW for pre c++11 std::basic_string
-            const irs::bytes_ref score_value = score->value();
+        top_k.collect(reader, *prepared);
+        totalHitCount += top_k.hits();
 
-            while (docs->next()) {
-              SCOPED_TIMER("Result processing time");
-              ++totalHitCount;
-              score->evaluate();
-              sorted.emplace(
-                std::piecewise_construct,
-                std::forward_as_tuple(score_value),
-                std::forward_as_tuple(docs->value(), score ? prepared_order.get<float>(score_value.c_str(), 0) : .0)
-              );
-
-              if (sorted.size() > topN) {
-                sorted.erase(--(sorted.end()));
-              }
-            }
+        top_k.visit([this, &prepared_order](const irs::top_k_collector::entry& entry)->bool {
+          top_docs.emplace_back(entry.doc, prepared_order.get<float>(entry.score, 0));
+          return true;
+        });
 
-            for (auto& entry: sorted) {
-              top_docs.emplace_back(std::move(entry.second));
-            }
-        }
         return 0;
     }
 
@@ -949,15 +929,6 @@ int search(
     task_provider = std::move(tasks);
   }
 
-  struct Entry {
-    Entry(irs::doc_id_t i, float s)
-      : id(i), score(s) {
-    }
-
-    irs::doc_id_t id;
-    float score;
-  };
-
   // indexer threads
   for (size_t i = search_threads; i; --i) {
     thread_pool.run([&task_provider, &dir, &reader, &order, limit, &out, csv, scored_terms_limit]()->void {
@@ -966,37 +937,14 @@ int search(
       auto analyzer = irs::analysis::analyzers::get(analyzer_name, analyzer_args);
       irs::filter::prepared::ptr filter;
       std::string tmpBuf;
-
-      #if defined(_MSC_VER) && defined(IRESEARCH_DEBUG)
-        typedef irs::memory::memory_multi_size_pool<irs::memory::identity_grow> pool_t;
-        typedef irs::memory::memory_pool_multi_size_allocator<Entry, pool_t> alloc_t;
-      #else
-        typedef irs::memory::memory_pool<irs::memory::identity_grow> pool_t;
-        typedef irs::memory::memory_pool_allocator<Entry, pool_t> alloc_t;
-      #endif
-
-      pool_t pool(limit + 1); // +1 for least significant overflow element
-
-#ifdef IRESEARCH_COMPLEX_SCORING
-      auto comparer = [&order](const irs::bstring& lhs, const irs::bstring& rhs)->bool {
-        return order.less(lhs.c_str(), rhs.c_str());
-      };
-      std::multimap<irs::bstring, Entry, decltype(comparer), alloc_t> sorted(
-        comparer, alloc_t{pool}
-      );
-#else
-      std::multimap<float, irs::doc_id_t, std::less<float>, alloc_t> sorted(
-        std::less<float>(), alloc_t{pool}
-      );
-#endif
+      irs::top_k_collector top_k(order, limit);
 
       // process a single task
       for (const task_t* task; (task = ++task_provider) != nullptr;) {
         SCOPED_TIMER("Full task processing time");
-        size_t doc_count = 0;
         auto start = std::chrono::system_clock::now();
 
-        sorted.clear();
+        top_k.clear();
 
         // parse task
         {
@@ -1030,40 +978,7 @@ int search(
           SCOPED_TIMER("Query execution time");
           irs::timer_utils::scoped_timer timer(*(timers.stat[size_t(task->category)]));
 
-          const float EMPTY_SCORE = 0.f;
-
-          for (auto& segment: reader) {
-            auto docs = filter->execute(segment, order); // query segment
-            const irs::score* score = docs->attributes().get<irs::score>().get();            
-
-#ifdef IRESEARCH_COMPLEX_SCORING
-            // ensure we avoid COW for pre c++11 std::basic_string
-            const irs::bytes_ref raw_score_value = score->value();                        
-#endif
-            const auto& score_value = score
-              ? order.get<float>(score->c_str(), 0)
-              : EMPTY_SCORE;
-            
-            while (docs->next()) {
-              ++doc_count;
-              assert(score); // score must exist for any ordered doc_iterator::next() == true
-              score->evaluate();
-
-#ifdef IRESEARCH_COMPLEX_SCORING
-              sorted.emplace(
-                std::piecewise_construct,
-                std::forward_as_tuple(raw_score_value),
-                std::forward_as_tuple(docs->value(), score_value)
-              );
-#else
-              sorted.emplace(score_value, docs->value());
-#endif
-
-              if (sorted.size() > limit) {
-                sorted.erase(--(sorted.end()));
-              }
-            }
-          }
+          top_k.collect(reader, *filter);
         }
 
         // output task results
@@ -1074,19 +989,16 @@ int search(
           auto tdiff = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start);
 
           if (csv) {
-            out << stringCategory(task->category) << "," << task->text << "," << doc_count << "," << tdiff.count() / 1000. << "," << tdiff.count() << std::endl;
+            out << stringCategory(task->category) << "," << task->text << "," << top_k.hits() << "," << tdiff.count() / 1000. << "," << tdiff.count() << std::endl;
           } else {
-            out << "TASK: cat=" << stringCategory(task->category) << " q='body:" << task->text << "' hits=" << doc_count << std::endl;
+            out << "TASK: cat=" << stringCategory(task->category) << " q='body:" << task->text << "' hits=" << top_k.hits() << std::endl;
             out << "  " << tdiff.count() / 1000. << " msec" << std::endl;
             out << "  thread " << std::this_thread::get_id() << std::endl;
 
-            for (auto& entry : sorted) {
-#ifdef IRESEARCH_COMPLEX_SCORING
-              out << "  doc=" << entry.second.id << " score=" << entry.second.score << std::endl;
-#else
-              out << "  doc=" << entry.second << " score=" << entry.first<< std::endl;
-#endif
-            }
+            top_k.visit([&out, &order](const irs::top_k_collector::entry& entry)->bool {
+              out << "  doc=" << entry.doc << " score=" << order.get<float>(entry.score, 0) << std::endl;
+              return true;
+            });
 
             out << std::endl;
           }